@@ -0,0 +1,571 @@
+/*************************************************************
+* File: advanceKernel.cpp
+* Author: Matthew Burr
+*
+* Description: Contains the scalar, SSE2 and AVX2 versions of
+*  the batch advance, and picks between them at run time.
+*
+*  The vector versions must match the scalar one exactly, so
+*  replays recorded on one machine play back the same on
+*  another. Positions are single float adds either way and
+*  the wrap is a select, so those match by construction.
+*  Rotation is (rotation + spin) % 360; the vector versions
+*  do that as one conditional add or subtract, which equals
+*  the remainder only while the sum is within (-720, 720).
+*  Any group that strays outside takes the remainder a lane
+*  at a time instead. That is done in place rather than by
+*  calling the scalar code, as a call in the loop would cost
+*  every group its constants, which live in registers.
+*
+*  Each kernel also returns the sum of hashMotion over the
+*  entries still alive afterwards, worked out from the values
+*  it has just stored (see stateHash.h).
+*************************************************************/
+
+#include "advanceKernel.h"
+#include "stateHash.h"
+#include "taskPool.h"
+#include <atomic>
+#include <cassert>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+   (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HAS_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// AVX2 is compiled in on x86 whatever the build flags say and only
+// used if the CPU has it
+#if defined(HAS_SSE2) && (defined(__GNUC__) || defined(_MSC_VER))
+#define HAS_AVX2 1
+#include <immintrin.h>
+#if defined(__GNUC__)
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#include <intrin.h>
+#define TARGET_AVX2
+#endif
+#endif
+
+#define MAX_DEGREES 360
+
+// Entries per chunk when the advance is split between threads; big
+// enough to be worth waking a thread for, and a whole number of AVX2
+// groups so no chunk but the last has a scalar tail
+#define ADVANCE_GRAIN 4096
+#define SSE2_LANES 4
+#define AVX2_LANES 8
+
+/**********************************************************************
+* Function: advanceScalar
+* Description: The reference version; one entry at a time, exactly
+*  as FlyingObject, Rock and Bullet do it in their advance methods
+**********************************************************************/
+static unsigned advanceScalar(const AdvanceArrays &a, int begin, int end,
+   const AdvanceBounds &b)
+{
+   unsigned hash = 0;
+   for (int i = begin; i < end; i++)
+   {
+      float x = a.x[i] + a.dx[i];
+      float y = a.y[i] + a.dy[i];
+
+      if (x < b.left)
+         x = b.right;
+      else if (x > b.right)
+         x = b.left;
+
+      if (y < b.bottom)
+         y = b.top;
+      else if (y > b.top)
+         y = b.bottom;
+
+      a.x[i] = x;
+      a.y[i] = y;
+      a.rotation[i] = (a.rotation[i] + a.spin[i]) % MAX_DEGREES;
+
+      // Entries with no life to begin with live until they are killed
+      if (a.life[i] > 0)
+         if (--a.life[i] <= 0)
+            a.alive[i] = false;
+
+      if (a.alive[i])
+         hash += hashMotion(x, y, a.rotation[i], a.life[i]);
+   }
+   return hash;
+}
+
+/**********************************************************************
+* Function: killLanes
+* Description: Clears the alive flag of each entry in a group whose
+*  bit is set in the mask
+**********************************************************************/
+static inline void killLanes(unsigned char * alive, int mask)
+{
+   for (int lane = 0; mask; lane++, mask >>= 1)
+      if (mask & 1)
+         alive[lane] = false;
+}
+
+#ifdef HAS_SSE2
+/**********************************************************************
+* Function: wrapSse2
+* Description: Wraps one coordinate of four entries: below the low
+*  edge goes to the high edge, otherwise above the high edge goes to
+*  the low edge
+**********************************************************************/
+static inline __m128 wrapSse2(__m128 value, __m128 low, __m128 high)
+{
+   __m128 below = _mm_cmplt_ps(value, low);
+   __m128 above = _mm_andnot_ps(below, _mm_cmpgt_ps(value, high));
+   value = _mm_or_ps(_mm_and_ps(below, high), _mm_andnot_ps(below, value));
+   return _mm_or_ps(_mm_and_ps(above, low), _mm_andnot_ps(above, value));
+}
+
+/**********************************************************************
+* Function: multiplySse2
+* Description: The low 32 bits of four products; SSE2 only multiplies
+*  the even lanes, so the odd ones are shifted down and done apart
+**********************************************************************/
+static inline __m128i multiplySse2(__m128i a, __m128i b)
+{
+   __m128i even = _mm_mul_epu32(a, b);
+   __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+   return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+      _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+/**********************************************************************
+* Function: hashMotionSse2
+* Description: hashMotion for four entries
+**********************************************************************/
+static inline __m128i hashMotionSse2(__m128 x, __m128 y, __m128i rotation,
+   __m128i life)
+{
+   __m128i yBits = _mm_castps_si128(y);
+   yBits = _mm_shufflehi_epi16(_mm_shufflelo_epi16(yBits,
+      _MM_SHUFFLE(2, 3, 0, 1)), _MM_SHUFFLE(2, 3, 0, 1));
+   __m128i hash = _mm_xor_si128(_mm_castps_si128(x), yBits);
+   hash = _mm_xor_si128(hash, _mm_xor_si128(rotation,
+      _mm_slli_epi32(life, 16)));
+   hash = multiplySse2(hash, _mm_set1_epi32((int)HASH_MULTIPLIER_1));
+   return _mm_xor_si128(hash, _mm_srli_epi32(hash, 16));
+}
+
+/**********************************************************************
+* Function: advanceSse2
+* Description: Four entries at a time
+**********************************************************************/
+static unsigned advanceSse2(const AdvanceArrays &a, int count,
+   const AdvanceBounds &b)
+{
+   const __m128 left = _mm_set1_ps(b.left);
+   const __m128 right = _mm_set1_ps(b.right);
+   const __m128 top = _mm_set1_ps(b.top);
+   const __m128 bottom = _mm_set1_ps(b.bottom);
+   const __m128i degrees = _mm_set1_epi32(MAX_DEGREES);
+   const __m128i upper = _mm_set1_epi32(MAX_DEGREES - 1);
+   const __m128i lower = _mm_set1_epi32(-MAX_DEGREES + 1);
+   const __m128i outerUpper = _mm_set1_epi32(2 * MAX_DEGREES - 1);
+   const __m128i outerLower = _mm_set1_epi32(-2 * MAX_DEGREES + 1);
+   const __m128i zero = _mm_setzero_si128();
+   __m128i hashes = zero;
+
+   // Copies of the array pointers, which the compiler can keep in
+   // registers; it can't be sure storing to the arrays leaves the
+   // ones in the struct alone
+   float * const xs = a.x;
+   float * const ys = a.y;
+   const float * const dxs = a.dx;
+   const float * const dys = a.dy;
+   int * const rotations = a.rotation;
+   const int * const spins = a.spin;
+   int * const lives = a.life;
+   unsigned char * const alives = a.alive;
+
+   int i = 0;
+   for (; i + SSE2_LANES <= count; i += SSE2_LANES)
+   {
+      __m128i rotation = _mm_add_epi32(
+         _mm_loadu_si128((const __m128i *)(rotations + i)),
+         _mm_loadu_si128((const __m128i *)(spins + i)));
+
+      __m128i outside = _mm_or_si128(_mm_cmpgt_epi32(rotation, outerUpper),
+         _mm_cmplt_epi32(rotation, outerLower));
+      if (_mm_movemask_epi8(outside))
+      {
+         int turns[SSE2_LANES];
+         _mm_storeu_si128((__m128i *)turns, rotation);
+         for (int lane = 0; lane < SSE2_LANES; lane++)
+            turns[lane] %= MAX_DEGREES;
+         rotation = _mm_loadu_si128((const __m128i *)turns);
+      }
+      else
+      {
+         rotation = _mm_sub_epi32(rotation,
+            _mm_and_si128(_mm_cmpgt_epi32(rotation, upper), degrees));
+         rotation = _mm_add_epi32(rotation,
+            _mm_and_si128(_mm_cmplt_epi32(rotation, lower), degrees));
+      }
+      _mm_storeu_si128((__m128i *)(rotations + i), rotation);
+
+      __m128 x = wrapSse2(_mm_add_ps(_mm_loadu_ps(xs + i),
+         _mm_loadu_ps(dxs + i)), left, right);
+      __m128 y = wrapSse2(_mm_add_ps(_mm_loadu_ps(ys + i),
+         _mm_loadu_ps(dys + i)), bottom, top);
+      _mm_storeu_ps(xs + i, x);
+      _mm_storeu_ps(ys + i, y);
+
+      // The compare mask is -1 where life is counting, so adding it
+      // counts down just those lanes
+      __m128i life = _mm_loadu_si128((const __m128i *)(lives + i));
+      __m128i counting = _mm_cmpgt_epi32(life, zero);
+      life = _mm_add_epi32(life, counting);
+      _mm_storeu_si128((__m128i *)(lives + i), life);
+
+      __m128i expired = _mm_and_si128(counting, _mm_cmpeq_epi32(life, zero));
+      int mask = _mm_movemask_ps(_mm_castsi128_ps(expired));
+      if (mask)
+         killLanes(alives + i, mask);
+
+      // Widen the four alive bytes into lane masks
+      int aliveBytes;
+      memcpy(&aliveBytes, alives + i, sizeof(aliveBytes));
+      __m128i alive = _mm_unpacklo_epi8(_mm_cvtsi32_si128(aliveBytes), zero);
+      alive = _mm_cmpgt_epi32(_mm_unpacklo_epi16(alive, zero), zero);
+      hashes = _mm_add_epi32(hashes,
+         _mm_and_si128(alive, hashMotionSse2(x, y, rotation, life)));
+   }
+
+   unsigned lanes[SSE2_LANES];
+   _mm_storeu_si128((__m128i *)lanes, hashes);
+   unsigned hash = 0;
+   for (int lane = 0; lane < SSE2_LANES; lane++)
+      hash += lanes[lane];
+
+   return hash + advanceScalar(a, i, count, b);
+}
+#endif /* HAS_SSE2 */
+
+#ifdef HAS_AVX2
+/**********************************************************************
+* Function: wrapAvx2
+* Description: Wraps one coordinate of eight entries
+**********************************************************************/
+TARGET_AVX2
+static inline __m256 wrapAvx2(__m256 value, __m256 low, __m256 high)
+{
+   __m256 below = _mm256_cmp_ps(value, low, _CMP_LT_OQ);
+   __m256 above = _mm256_cmp_ps(value, high, _CMP_GT_OQ);
+   value = _mm256_blendv_ps(value, low, above);
+   return _mm256_blendv_ps(value, high, below);
+}
+
+/**********************************************************************
+* Function: hashMotionAvx2
+* Description: hashMotion for eight entries
+**********************************************************************/
+TARGET_AVX2
+static inline __m256i hashMotionAvx2(__m256 x, __m256 y, __m256i rotation,
+   __m256i life)
+{
+   // Swaps the halves of each 32-bit lane: a rotate by 16
+   const __m256i swapHalves = _mm256_setr_epi8(2, 3, 0, 1, 6, 7, 4, 5,
+      10, 11, 8, 9, 14, 15, 12, 13, 2, 3, 0, 1, 6, 7, 4, 5,
+      10, 11, 8, 9, 14, 15, 12, 13);
+
+   __m256i hash = _mm256_xor_si256(_mm256_castps_si256(x),
+      _mm256_shuffle_epi8(_mm256_castps_si256(y), swapHalves));
+   hash = _mm256_xor_si256(hash, _mm256_xor_si256(rotation,
+      _mm256_slli_epi32(life, 16)));
+   hash = _mm256_mullo_epi32(hash, _mm256_set1_epi32((int)HASH_MULTIPLIER_1));
+   return _mm256_xor_si256(hash, _mm256_srli_epi32(hash, 16));
+}
+
+/**********************************************************************
+* Function: advanceAvx2
+* Description: Eight entries at a time
+**********************************************************************/
+TARGET_AVX2
+static unsigned advanceAvx2(const AdvanceArrays &a, int count,
+   const AdvanceBounds &b)
+{
+   const __m256 left = _mm256_set1_ps(b.left);
+   const __m256 right = _mm256_set1_ps(b.right);
+   const __m256 top = _mm256_set1_ps(b.top);
+   const __m256 bottom = _mm256_set1_ps(b.bottom);
+   const __m256i degrees = _mm256_set1_epi32(MAX_DEGREES);
+   const __m256i upper = _mm256_set1_epi32(MAX_DEGREES - 1);
+   const __m256i lower = _mm256_set1_epi32(-MAX_DEGREES + 1);
+   const __m256i outerUpper = _mm256_set1_epi32(2 * MAX_DEGREES - 1);
+   const __m256i outerLower = _mm256_set1_epi32(-2 * MAX_DEGREES + 1);
+   const __m256i zero = _mm256_setzero_si256();
+   __m256i hashes = zero;
+
+   float * const xs = a.x;
+   float * const ys = a.y;
+   const float * const dxs = a.dx;
+   const float * const dys = a.dy;
+   int * const rotations = a.rotation;
+   const int * const spins = a.spin;
+   int * const lives = a.life;
+   unsigned char * const alives = a.alive;
+
+   int i = 0;
+   for (; i + AVX2_LANES <= count; i += AVX2_LANES)
+   {
+      __m256i rotation = _mm256_add_epi32(
+         _mm256_loadu_si256((const __m256i *)(rotations + i)),
+         _mm256_loadu_si256((const __m256i *)(spins + i)));
+
+      __m256i outside = _mm256_or_si256(
+         _mm256_cmpgt_epi32(rotation, outerUpper),
+         _mm256_cmpgt_epi32(outerLower, rotation));
+      if (_mm256_movemask_epi8(outside))
+      {
+         int turns[AVX2_LANES];
+         _mm256_storeu_si256((__m256i *)turns, rotation);
+         for (int lane = 0; lane < AVX2_LANES; lane++)
+            turns[lane] %= MAX_DEGREES;
+         rotation = _mm256_loadu_si256((const __m256i *)turns);
+      }
+      else
+      {
+         rotation = _mm256_sub_epi32(rotation,
+            _mm256_and_si256(_mm256_cmpgt_epi32(rotation, upper), degrees));
+         rotation = _mm256_add_epi32(rotation,
+            _mm256_and_si256(_mm256_cmpgt_epi32(lower, rotation), degrees));
+      }
+      _mm256_storeu_si256((__m256i *)(rotations + i), rotation);
+
+      __m256 x = wrapAvx2(_mm256_add_ps(_mm256_loadu_ps(xs + i),
+         _mm256_loadu_ps(dxs + i)), left, right);
+      __m256 y = wrapAvx2(_mm256_add_ps(_mm256_loadu_ps(ys + i),
+         _mm256_loadu_ps(dys + i)), bottom, top);
+      _mm256_storeu_ps(xs + i, x);
+      _mm256_storeu_ps(ys + i, y);
+
+      __m256i life = _mm256_loadu_si256((const __m256i *)(lives + i));
+      __m256i counting = _mm256_cmpgt_epi32(life, zero);
+      life = _mm256_add_epi32(life, counting);
+      _mm256_storeu_si256((__m256i *)(lives + i), life);
+
+      __m256i expired = _mm256_and_si256(counting,
+         _mm256_cmpeq_epi32(life, zero));
+      int mask = _mm256_movemask_ps(_mm256_castsi256_ps(expired));
+      if (mask)
+         killLanes(alives + i, mask);
+
+      __m256i alive = _mm256_cmpgt_epi32(_mm256_cvtepu8_epi32(
+         _mm_loadl_epi64((const __m128i *)(alives + i))), zero);
+      hashes = _mm256_add_epi32(hashes,
+         _mm256_and_si256(alive, hashMotionAvx2(x, y, rotation, life)));
+   }
+
+   unsigned lanes[AVX2_LANES];
+   _mm256_storeu_si256((__m256i *)lanes, hashes);
+   unsigned hash = 0;
+   for (int lane = 0; lane < AVX2_LANES; lane++)
+      hash += lanes[lane];
+
+   // GCC doesn't clear the upper halves of the registers on the way out
+   // of a function only targeted at AVX2, and until they are cleared
+   // every SSE instruction the rest of the program runs pays for them
+   _mm256_zeroupper();
+
+   return hash + advanceScalar(a, i, count, b);
+}
+
+/**********************************************************************
+* Function: cpuHasAvx2
+* Description: True if both the CPU and the OS support AVX2
+**********************************************************************/
+static bool cpuHasAvx2()
+{
+#if defined(__GNUC__)
+   __builtin_cpu_init();
+   return __builtin_cpu_supports("avx2") != 0;
+#else
+   int info[4];
+   __cpuid(info, 1);
+   bool osSavesYmm = (info[2] & (1 << 27)) != 0 &&
+      (_xgetbv(0) & 6) == 6;
+   if (!osSavesYmm || !(info[2] & (1 << 28)))
+      return false;
+   __cpuidex(info, 7, 0);
+   return (info[1] & (1 << 5)) != 0;
+#endif
+}
+#endif /* HAS_AVX2 */
+
+/**********************************************************************
+* Function: getBestKernel
+* Description: The fastest kernel this machine can run
+**********************************************************************/
+static AdvanceKernel getBestKernel()
+{
+#ifdef HAS_AVX2
+   if (cpuHasAvx2())
+      return ADVANCE_AVX2;
+#endif
+#ifdef HAS_SSE2
+   return ADVANCE_SSE2;
+#else
+   return ADVANCE_SCALAR;
+#endif
+}
+
+/**********************************************************************
+* Function: selectedKernel
+* Description: The kernel in use, chosen the first time it is needed
+**********************************************************************/
+static AdvanceKernel &selectedKernel()
+{
+   static AdvanceKernel kernel = getBestKernel();
+   return kernel;
+}
+
+/**********************************************************************
+* Function: isAdvanceKernelSupported
+* Description: True if this build and this CPU can run a kernel
+**********************************************************************/
+bool isAdvanceKernelSupported(AdvanceKernel kernel)
+{
+   switch (kernel)
+   {
+      case ADVANCE_SCALAR:
+         return true;
+#ifdef HAS_SSE2
+      case ADVANCE_SSE2:
+         return true;
+#endif
+#ifdef HAS_AVX2
+      case ADVANCE_AVX2:
+         return cpuHasAvx2();
+#endif
+      default:
+         return false;
+   }
+}
+
+/**********************************************************************
+* Function: getAdvanceKernel
+* Description: The kernel advanceEntities uses
+**********************************************************************/
+AdvanceKernel getAdvanceKernel()
+{
+   return selectedKernel();
+}
+
+/**********************************************************************
+* Function: setAdvanceKernel
+* Description: Makes advanceEntities use a kernel, if the CPU
+*  supports it. Returns whether it does.
+**********************************************************************/
+bool setAdvanceKernel(AdvanceKernel kernel)
+{
+   if (!isAdvanceKernelSupported(kernel))
+      return false;
+
+   selectedKernel() = kernel;
+   return true;
+}
+
+/**********************************************************************
+* Function: getAdvanceKernelName
+* Description: A name for a kernel, for reports
+**********************************************************************/
+const char * getAdvanceKernelName(AdvanceKernel kernel)
+{
+   switch (kernel)
+   {
+      case ADVANCE_SSE2:
+         return "sse2";
+      case ADVANCE_AVX2:
+         return "avx2";
+      default:
+         return "scalar";
+   }
+}
+
+/**********************************************************************
+* Function: advanceEntitiesWith
+* Description: Runs one particular kernel over the arrays
+**********************************************************************/
+unsigned advanceEntitiesWith(AdvanceKernel kernel, const AdvanceArrays &arrays,
+   int count, const AdvanceBounds &bounds)
+{
+   assert(count >= 0);
+   assert(isAdvanceKernelSupported(kernel));
+
+   switch (kernel)
+   {
+#ifdef HAS_AVX2
+      case ADVANCE_AVX2:
+         return advanceAvx2(arrays, count, bounds);
+#endif
+#ifdef HAS_SSE2
+      case ADVANCE_SSE2:
+         return advanceSse2(arrays, count, bounds);
+#endif
+      default:
+         return advanceScalar(arrays, 0, count, bounds);
+   }
+}
+
+/**********************************************************************
+* Function: advanceEntities
+* Description: Runs the selected kernel over the arrays
+**********************************************************************/
+unsigned advanceEntities(const AdvanceArrays &arrays, int count,
+   const AdvanceBounds &bounds)
+{
+   return advanceEntitiesWith(selectedKernel(), arrays, count, bounds);
+}
+
+/*****************************************
+* ADVANCE JOB
+* What each chunk of a parallel advance
+* needs to know, and where the chunks add
+* up their hashes
+*****************************************/
+struct AdvanceJob
+{
+   const AdvanceArrays * arrays;
+   const AdvanceBounds * bounds;
+   std::atomic<unsigned> hash;
+};
+
+/**********************************************************************
+* Function: advanceRange
+* Description: Advances one chunk of a parallel advance
+**********************************************************************/
+static void advanceRange(void * context, int thread, int begin, int end)
+{
+   AdvanceJob &job = *(AdvanceJob *)context;
+   const AdvanceArrays &a = *job.arrays;
+
+   AdvanceArrays chunk = { a.x + begin, a.y + begin, a.dx + begin,
+      a.dy + begin, a.rotation + begin, a.spin + begin, a.life + begin,
+      a.alive + begin };
+   job.hash += advanceEntities(chunk, end - begin, *job.bounds);
+}
+
+/**********************************************************************
+* Function: advanceEntities
+* Description: Runs the selected kernel over the arrays, split into
+*  chunks between the pool's threads. Every entry is independent and
+*  the kernels all agree, so the result is the same however it is
+*  split; the hash is a sum, so it is too.
+**********************************************************************/
+unsigned advanceEntities(const AdvanceArrays &arrays, int count,
+   const AdvanceBounds &bounds, TaskPool &pool)
+{
+   AdvanceJob job;
+   job.arrays = &arrays;
+   job.bounds = &bounds;
+   job.hash = 0;
+   pool.parallelFor(count, ADVANCE_GRAIN, advanceRange, &job);
+   return job.hash;
+}
@@ -0,0 +1,93 @@
+/*************************************************************
+* File: advanceKernel.h
+* Author: Matthew Burr
+*
+* Description: Contains the batch kernels that move, wrap,
+*  spin and age whole arrays of flying objects at once.
+*************************************************************/
+
+#ifndef advanceKernel_h
+#define advanceKernel_h
+
+class TaskPool;
+
+/*****************************************
+* ADVANCE ARRAYS
+* Where the kernels find the state they
+* update; one entry per object
+*****************************************/
+struct AdvanceArrays
+{
+   float * x;
+   float * y;
+   const float * dx;
+   const float * dy;
+   int * rotation;
+   const int * spin;
+   int * life;
+   unsigned char * alive;
+};
+
+/*****************************************
+* ADVANCE BOUNDS
+* The edges objects wrap around
+*****************************************/
+struct AdvanceBounds
+{
+   float left;
+   float right;
+   float top;
+   float bottom;
+};
+
+/*****************************************
+* ADVANCE KERNEL
+* The implementations to choose from. The
+* vector ones give bit-for-bit the same
+* results as the scalar one.
+*****************************************/
+enum AdvanceKernel
+{
+   ADVANCE_SCALAR,
+   ADVANCE_SSE2,
+   ADVANCE_AVX2
+};
+
+/**********************************************************
+ * ADVANCE ENTITIES
+ * Moves entries [0, count) by their velocity, wraps them
+ * around the bounds, spins them and counts down their life,
+ * using the kernel that is currently selected. Returns the
+ * sum of hashMotion over the entries left alive.
+ **********************************************************/
+unsigned advanceEntities(const AdvanceArrays &arrays, int count,
+                         const AdvanceBounds &bounds);
+
+/**********************************************************
+ * ADVANCE ENTITIES IN PARALLEL
+ * The same, split between the threads of a pool
+ **********************************************************/
+unsigned advanceEntities(const AdvanceArrays &arrays, int count,
+                         const AdvanceBounds &bounds, TaskPool &pool);
+
+/**********************************************************
+ * ADVANCE ENTITIES WITH
+ * The same, using a particular kernel. The kernel must be
+ * supported by this machine.
+ **********************************************************/
+unsigned advanceEntitiesWith(AdvanceKernel kernel,
+                             const AdvanceArrays &arrays, int count,
+                             const AdvanceBounds &bounds);
+
+/**********************************************************
+ * KERNEL SELECTION
+ * By default the best kernel the CPU supports is used;
+ * setAdvanceKernel overrides that (and refuses kernels the
+ * CPU cannot run)
+ **********************************************************/
+bool isAdvanceKernelSupported(AdvanceKernel kernel);
+AdvanceKernel getAdvanceKernel();
+bool setAdvanceKernel(AdvanceKernel kernel);
+const char * getAdvanceKernelName(AdvanceKernel kernel);
+
+#endif /* advanceKernel_h */
@@ -0,0 +1,208 @@
+/*****************************************************
+ * File: benchAdvance.cpp
+ * Author: Matthew Burr
+ *
+ * Description: Checks that every advance kernel this
+ *  machine supports gives bit-for-bit the same state
+ *  and state hash as the scalar one, then measures
+ *  what each costs per entry.
+ ******************************************************/
+#include "advanceKernel.h"
+#include "stateHash.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#define CHECK_ENTRIES 10007   // not a multiple of any vector width
+#define CHECK_FRAMES 200
+#define BENCH_ENTRIES 100000
+#define BENCH_FRAMES 200
+#define BENCH_SEED 1
+#define FIELD_SIZE 200.0f
+#define MAX_SPEED 12.0f
+using namespace std;
+
+/*****************************************
+* ENTITIES
+* Owns one set of arrays for the kernels
+* to work on
+*****************************************/
+struct Entities
+{
+   vector<float> x;
+   vector<float> y;
+   vector<float> dx;
+   vector<float> dy;
+   vector<int> rotation;
+   vector<int> spin;
+   vector<int> life;
+   vector<unsigned char> alive;
+
+   AdvanceArrays getArrays()
+   {
+      AdvanceArrays arrays = { &x[0], &y[0], &dx[0], &dy[0],
+         &rotation[0], &spin[0], &life[0], &alive[0] };
+      return arrays;
+   }
+
+   bool operator==(const Entities &rhs) const
+   {
+      size_t count = x.size();
+      return memcmp(&x[0], &rhs.x[0], count * sizeof(float)) == 0 &&
+         memcmp(&y[0], &rhs.y[0], count * sizeof(float)) == 0 &&
+         rotation == rhs.rotation && life == rhs.life && alive == rhs.alive;
+   }
+
+   // The motion hash, added up entry by entry
+   unsigned getHash() const
+   {
+      unsigned hash = 0;
+      for (size_t i = 0; i < x.size(); i++)
+         if (alive[i])
+            hash += hashMotion(x[i], y[i], rotation[i], life[i]);
+      return hash;
+   }
+};
+
+/*************************************
+ * RANDOM FLOAT
+ * A random float between min and max
+ **************************************/
+float randomFloat(float min, float max)
+{
+   return min + (float)rand() / (float)RAND_MAX * (max - min);
+}
+
+/*************************************
+ * MAKE ENTITIES
+ * A mix of rocks and bullets, some
+ * right on an edge. With wild set, a
+ * few also get spins big enough to
+ * push the vector kernels onto their
+ * scalar fallback; the game never
+ * makes those, so they are left out
+ * of the timings.
+ **************************************/
+Entities makeEntities(int count, bool wild)
+{
+   Entities entities;
+
+   for (int i = 0; i < count; i++)
+   {
+      float x = randomFloat(-FIELD_SIZE, FIELD_SIZE);
+      float y = randomFloat(-FIELD_SIZE, FIELD_SIZE);
+      if (i % 13 == 0)
+         x = (i % 2) ? FIELD_SIZE : -FIELD_SIZE;
+
+      int spin = rand() % 21 - 10;
+      if (wild && i % 101 == 0)
+         spin = rand() % 4000 - 2000;
+
+      entities.x.push_back(x);
+      entities.y.push_back(y);
+      entities.dx.push_back(randomFloat(-MAX_SPEED, MAX_SPEED));
+      entities.dy.push_back(randomFloat(-MAX_SPEED, MAX_SPEED));
+      entities.rotation.push_back(rand() % 720 - 360);
+      entities.spin.push_back(spin);
+      entities.life.push_back((i % 3) ? 0 : rand() % 60);
+      entities.alive.push_back(true);
+   }
+
+   return entities;
+}
+
+/*************************************
+ * CHECK KERNELS
+ * Runs every supported kernel on the
+ * same entities and compares the state
+ * after each frame to the scalar one.
+ * Returns the number of kernels that
+ * disagree.
+ **************************************/
+int checkKernels(const AdvanceBounds &bounds)
+{
+   srand(BENCH_SEED);
+   const Entities start = makeEntities(CHECK_ENTRIES, true);
+   int failures = 0;
+
+   for (int kernel = ADVANCE_SSE2; kernel <= ADVANCE_AVX2; kernel++)
+   {
+      if (!isAdvanceKernelSupported((AdvanceKernel)kernel))
+      {
+         printf("%7s: not supported here\n",
+            getAdvanceKernelName((AdvanceKernel)kernel));
+         continue;
+      }
+
+      Entities expected = start;
+      Entities actual = start;
+      AdvanceArrays expectedArrays = expected.getArrays();
+      AdvanceArrays actualArrays = actual.getArrays();
+      int badFrame = -1;
+
+      for (int frame = 0; frame < CHECK_FRAMES && badFrame < 0; frame++)
+      {
+         unsigned expectedHash = advanceEntitiesWith(ADVANCE_SCALAR,
+            expectedArrays, CHECK_ENTRIES, bounds);
+         unsigned actualHash = advanceEntitiesWith((AdvanceKernel)kernel,
+            actualArrays, CHECK_ENTRIES, bounds);
+         if (!(expected == actual) || actualHash != expectedHash ||
+             expectedHash != expected.getHash())
+            badFrame = frame;
+      }
+
+      if (badFrame >= 0)
+      {
+         printf("%7s: differs from scalar at frame %d\n",
+            getAdvanceKernelName((AdvanceKernel)kernel), badFrame);
+         failures++;
+      }
+      else
+         printf("%7s: identical to scalar over %d frames\n",
+            getAdvanceKernelName((AdvanceKernel)kernel), CHECK_FRAMES);
+   }
+
+   return failures;
+}
+
+/*************************************
+ * TIME KERNEL
+ * Nanoseconds per entry per frame
+ **************************************/
+double timeKernel(AdvanceKernel kernel, const AdvanceBounds &bounds)
+{
+   srand(BENCH_SEED);
+   Entities entities = makeEntities(BENCH_ENTRIES, false);
+   AdvanceArrays arrays = entities.getArrays();
+
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   for (int frame = 0; frame < BENCH_FRAMES; frame++)
+      advanceEntitiesWith(kernel, arrays, BENCH_ENTRIES, bounds);
+   chrono::duration<double, nano> elapsed =
+      chrono::steady_clock::now() - start;
+
+   return elapsed.count() / BENCH_FRAMES / BENCH_ENTRIES;
+}
+
+/*********************************
+ * Main checks the kernels agree
+ * and then times each of them
+ *********************************/
+int main(int argc, char ** argv)
+{
+   AdvanceBounds bounds = { -FIELD_SIZE, FIELD_SIZE, FIELD_SIZE, -FIELD_SIZE };
+
+   int failures = checkKernels(bounds);
+
+   printf("\nselected kernel: %s\n",
+      getAdvanceKernelName(getAdvanceKernel()));
+   printf("%7s %10s\n", "kernel", "ns/entry");
+   for (int kernel = ADVANCE_SCALAR; kernel <= ADVANCE_AVX2; kernel++)
+      if (isAdvanceKernelSupported((AdvanceKernel)kernel))
+         printf("%7s %10.3f\n", getAdvanceKernelName((AdvanceKernel)kernel),
+            timeKernel((AdvanceKernel)kernel, bounds));
+
+   return failures ? 1 : 0;
+}
@@ -0,0 +1,203 @@
+/*****************************************************
+ * File: benchBatch.cpp
+ * Author: Matthew Burr
+ *
+ * Description: Steps a batch of games with random
+ *  input, checks that a game in a batch plays out
+ *  exactly as it does on its own and that the batch
+ *  plays the same games on any number of threads,
+ *  then measures how many game steps a second it
+ *  manages as the thread count grows.
+ *
+ *  Usage: benchBatch [games] [steps] [rocks] [maxThreads]
+ *
+ *  Thread counts double from 1 up to maxThreads,
+ *  which defaults to the number of cores.
+ ******************************************************/
+#include "gameBatch.h"
+#include "game.h"
+#include "gameInput.h"
+#include "taskPool.h"
+#include "random.h"
+#include "point.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#define DEFAULT_GAMES 64
+#define DEFAULT_STEPS 2000
+#define CHECK_STEPS 3000
+#define SEED 1
+
+// How often the input presses each key, out of 100
+#define TURN_CHANCE 20
+#define THRUST_CHANCE 10
+#define FIRE_CHANCE 30
+using namespace std;
+
+/*****************************************
+* OUTCOME
+* What a batch did over a run
+*****************************************/
+struct Outcome
+{
+   long long episodes;
+   long long reward;
+   unsigned long long checksum;   // of every game's state, step by step
+   double seconds;
+};
+
+/*************************************
+ * RANDOM INPUT
+ * A random set of keys
+ **************************************/
+GameInput randomInput(Random &bot)
+{
+   GameInput input;
+   input.left = bot.getInt(0, 100) < TURN_CHANCE;
+   input.right = !input.left && bot.getInt(0, 100) < TURN_CHANCE;
+   input.up = bot.getInt(0, 100) < THRUST_CHANCE;
+   input.fire = bot.getInt(0, 100) < FIRE_CHANCE;
+   return input;
+}
+
+/*************************************
+ * MIX
+ * Folds a number into a checksum
+ **************************************/
+inline unsigned long long mix(unsigned long long checksum, long long value)
+{
+   return (checksum ^ (unsigned long long)value) * 0x100000001b3ULL;
+}
+
+/*************************************
+ * RUN
+ * Steps a batch with the same input
+ * every time
+ **************************************/
+Outcome run(int games, int steps, int rocks, int threads)
+{
+   Point topLeft(-200, 200);
+   Point bottomRight(200, -200);
+   GameBatch batch(games, topLeft, bottomRight, rocks, SEED);
+   batch.setThreadCount(threads);
+
+   Random bot(SEED);
+   vector<GameInput> inputs(games);
+   Outcome outcome = { 0, 0, 0, 0 };
+
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   for (int step = 0; step < steps; step++)
+   {
+      for (int i = 0; i < games; i++)
+         inputs[i] = randomInput(bot);
+
+      batch.step(&inputs[0]);
+
+      for (int i = 0; i < games; i++)
+      {
+         outcome.reward += batch.getReward(i);
+         outcome.checksum = mix(outcome.checksum,
+            batch.getGame(i).getRockCount() * 4 + batch.isDone(i));
+      }
+   }
+   outcome.seconds = chrono::duration<double>(chrono::steady_clock::now() -
+      start).count();
+   outcome.episodes = batch.getEpisodeCount();
+
+   return outcome;
+}
+
+/*************************************
+ * CHECK ALONE
+ * Plays the first game of a batch
+ * alongside the same game on its own.
+ * Returns false if they ever differ.
+ **************************************/
+bool checkAlone(int games, int rocks, int threads)
+{
+   Point topLeft(-200, 200);
+   Point bottomRight(200, -200);
+   GameBatch batch(games, topLeft, bottomRight, rocks, SEED);
+   batch.setThreadCount(threads);
+
+   // the same seed the batch gives its first game
+   Random seeds(SEED);
+   Random firstSeeds = seeds.split();
+   Game alone(topLeft, bottomRight, rocks, MAX_BULLETS, firstSeeds.next());
+
+   Random bot(SEED);
+   vector<GameInput> inputs(games);
+   for (int step = 0; step < CHECK_STEPS; step++)
+   {
+      for (int i = 0; i < games; i++)
+         inputs[i] = randomInput(bot);
+
+      batch.step(&inputs[0]);
+      alone.advance();
+      alone.handleInput(inputs[0]);
+
+      // the batch starts a finished game over, so compare up to there
+      if (batch.isDone(0))
+         return alone.isOver();
+
+      const Game &game = batch.getGame(0);
+      if (game.getScore() != alone.getScore() ||
+          game.getLives() != alone.getLives() ||
+          game.getRockCount() != alone.getRockCount() ||
+          game.getBulletCount() != alone.getBulletCount())
+      {
+         printf("game 0 went its own way on step %d\n", step);
+         return false;
+      }
+   }
+
+   return true;
+}
+
+/*********************************
+ * Main checks, then times each
+ * thread count
+ *********************************/
+int main(int argc, char ** argv)
+{
+   int games = (argc > 1) ? atoi(argv[1]) : DEFAULT_GAMES;
+   int steps = (argc > 2) ? atoi(argv[2]) : DEFAULT_STEPS;
+   int rocks = (argc > 3) ? atoi(argv[3]) : START_ROCK_COUNT;
+   int maxThreads = (argc > 4) ? atoi(argv[4]) : TaskPool::getCoreCount();
+   if (games < 1 || steps < 1 || rocks < 0 || maxThreads < 1)
+   {
+      fprintf(stderr, "benchBatch: games, steps and threads must be "
+         "positive\n");
+      return 1;
+   }
+
+   if (!checkAlone(games, rocks, maxThreads))
+      return 1;
+
+   printf("%7s %6s %6s %9s %9s %12s %8s\n", "threads", "games", "steps",
+      "episodes", "reward", "steps/sec", "speedup");
+
+   Outcome first = { 0, 0, 0, 0 };
+   for (int threads = 1; threads <= maxThreads; threads *= 2)
+   {
+      Outcome outcome = run(games, steps, rocks, threads);
+      if (threads == 1)
+         first = outcome;
+      else if (outcome.checksum != first.checksum ||
+               outcome.reward != first.reward ||
+               outcome.episodes != first.episodes)
+      {
+         printf("%d threads played different games than 1\n", threads);
+         return 1;
+      }
+
+      printf("%7d %6d %6d %9lld %9lld %12.0f %7.2fx\n", threads, games,
+         steps, outcome.episodes, outcome.reward,
+         (double)games * steps / outcome.seconds,
+         first.seconds / outcome.seconds);
+   }
+
+   return 0;
+}
@@ -0,0 +1,208 @@
+/*****************************************************
+ * File: benchBroadPhase.cpp
+ * Author: Matthew Burr
+ *
+ * Description: Checks that every broad phase finds
+ *  the same collisions and times how long each takes
+ *  to handle a frame's collisions, on rocks spread
+ *  evenly over the field and on rocks bunched into
+ *  drifting clusters.
+ *
+ *  Usage: benchBroadPhase [frames] [seed]
+ *
+ *  Every phase plays the same scene from the same
+ *  seed; if the score or the rock count ever differs
+ *  from one to another it says so and fails.
+ ******************************************************/
+#include "game.h"
+#include "bullet.h"
+#include "rocks.h"
+#include "random.h"
+#include "point.h"
+#include "velocity.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#define DEFAULT_FRAMES 100
+#define DEFAULT_SEED 1
+#define BULLETS_FIRED 20      // per frame
+#define BRUTE_FORCE_LIMIT 10000   // more rocks than this take too long
+#define CLUSTER_SIZE 500      // rocks per cluster
+#define ROCKS_PER_SCREEN 100
+#define SCREEN_HALF_SIZE 200.0f
+using namespace std;
+
+/*****************************************
+* LAYOUT
+* How the starting rocks are placed
+*****************************************/
+enum Layout
+{
+   LAYOUT_UNIFORM,
+   LAYOUT_CLUSTERED
+};
+
+/*****************************************
+* RESULT
+* What one broad phase made of a scene
+*****************************************/
+struct Result
+{
+   double seconds;
+   vector<int> scores;
+   vector<int> rockCounts;
+};
+
+/*************************************
+ * RANDOM POINT
+ * Somewhere on the field
+ **************************************/
+Point randomPoint(float halfSize)
+{
+   return Point((float)random(-halfSize, halfSize),
+                (float)random(-halfSize, halfSize));
+}
+
+/*************************************
+ * ADD ROCKS
+ * Fills the field. Clustered rocks
+ * start near their cluster's center and
+ * head roughly the same way, so the
+ * clusters hold together as they drift
+ * and wrap.
+ **************************************/
+void addRocks(Game &game, Layout layout, int count, float halfSize)
+{
+   Point center;
+   float heading = 0;
+   float spread = halfSize / 20;
+
+   for (int i = 0; i < count; i++)
+   {
+      if (layout == LAYOUT_UNIFORM)
+      {
+         BigRock rock(randomPoint(halfSize), (float)random(0.0, 360.0));
+         game.addRock(rock.getType(), rock.getPoint(), rock.getVelocity());
+         continue;
+      }
+
+      if (i % CLUSTER_SIZE == 0)
+      {
+         center = randomPoint(halfSize - spread);
+         heading = (float)random(0.0, 360.0);
+      }
+
+      Point point(center.getX() + (float)random(-spread, spread),
+                  center.getY() + (float)random(-spread, spread));
+      BigRock rock(point, heading + (float)random(-10.0, 10.0));
+      game.addRock(rock.getType(), rock.getPoint(), rock.getVelocity());
+   }
+}
+
+/*************************************
+ * RUN
+ * Plays a scene with one broad phase
+ **************************************/
+Result run(BroadPhase broadPhase, Layout layout, int rocks, int frames,
+   int seed)
+{
+   float halfSize = SCREEN_HALF_SIZE *
+      (float)sqrt(max(1.0, (double)rocks / ROCKS_PER_SCREEN));
+
+   seedRandom(seed);
+   Game game(Point(-halfSize, halfSize), Point(halfSize, -halfSize),
+      0 /*rocks*/, BULLETS_FIRED * BULLET_LIFE);
+   game.setBroadPhase(broadPhase);
+   addRocks(game, layout, rocks, halfSize);
+
+   FrameProfile profile;
+   game.setProfile(&profile);
+
+   Result result;
+   result.seconds = 0;
+   for (int frame = 0; frame < frames; frame++)
+   {
+      for (int i = 0; i < BULLETS_FIRED; i++)
+      {
+         Bullet bullet;
+         bullet.fire(randomPoint(halfSize), (float)random(0.0, 360.0));
+         game.addBullet(bullet);
+      }
+
+      game.advance();
+      result.seconds += profile.handleCollisions;
+      result.scores.push_back(game.getScore());
+      result.rockCounts.push_back(game.getRockCount());
+   }
+
+   return result;
+}
+
+/*********************************
+ * Main plays each scene with each
+ * broad phase, checks they agree
+ * and prints the time per frame
+ *********************************/
+int main(int argc, char ** argv)
+{
+   int frames = (argc > 1) ? atoi(argv[1]) : DEFAULT_FRAMES;
+   int seed = (argc > 2) ? atoi(argv[2]) : DEFAULT_SEED;
+   if (frames < 1)
+   {
+      fprintf(stderr, "benchBroadPhase: frames must be at least 1\n");
+      return 1;
+   }
+
+   const int rockCounts[] = { 1000, 10000, 100000 };
+   const Layout layouts[] = { LAYOUT_UNIFORM, LAYOUT_CLUSTERED };
+   const char * layoutNames[] = { "uniform", "clustered" };
+   const BroadPhase phases[] = {
+      BROAD_PHASE_BRUTE_FORCE, BROAD_PHASE_GRID, BROAD_PHASE_SWEEP_AND_PRUNE
+   };
+   const char * phaseNames[] = { "brute force", "grid", "sweep and prune" };
+   const int phaseCount = sizeof(phases) / sizeof(phases[0]);
+
+   bool isSame = true;
+   printf("%-10s %7s %16s %10s %6s %6s\n", "layout", "rocks", "broad phase",
+      "us/frame", "score", "rocks");
+
+   for (size_t l = 0; l < sizeof(layouts) / sizeof(layouts[0]); l++)
+   {
+      for (size_t r = 0; r < sizeof(rockCounts) / sizeof(rockCounts[0]); r++)
+      {
+         Result expected;
+         const char * expectedName = NULL;
+
+         for (int p = 0; p < phaseCount; p++)
+         {
+            if (phases[p] == BROAD_PHASE_BRUTE_FORCE &&
+                rockCounts[r] > BRUTE_FORCE_LIMIT)
+               continue;
+
+            Result result = run(phases[p], layouts[l], rockCounts[r],
+               frames, seed);
+            printf("%-10s %7d %16s %10.1f %6d %6d\n", layoutNames[l],
+               rockCounts[r], phaseNames[p], result.seconds / frames * 1e6,
+               result.scores.back(), result.rockCounts.back());
+
+            if (!expectedName)
+            {
+               expected = result;
+               expectedName = phaseNames[p];
+            }
+            else if (result.scores != expected.scores ||
+                     result.rockCounts != expected.rockCounts)
+            {
+               printf("  MISMATCH: %s doesn't agree with %s\n",
+                  phaseNames[p], expectedName);
+               isSame = false;
+            }
+         }
+      }
+   }
+
+   return isSame ? 0 : 1;
+}
@@ -0,0 +1,169 @@
+/*****************************************************
+ * File: benchBullets.cpp
+ * Author: Matthew Burr
+ *
+ * Description: Runs an auto-firing ship's bullets
+ *  through the list they used to live in, the entity
+ *  store, and the bullet ring, and reports the time
+ *  and heap allocations per frame for each.
+ ******************************************************/
+#include "bulletRing.h"
+#include "entityStore.h"
+#include "bullet.h"
+#include "flyingObject.h"
+#include "point.h"
+#include "velocity.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <new>
+
+#define BENCH_FRAMES 1000000
+#define HIT_EVERY 3     // frames between bullets hitting something
+#define TURN_RATE 7     // degrees the ship turns between shots
+using namespace std;
+
+static long s_allocations = 0;
+
+/*************************************
+ * OPERATOR NEW / DELETE
+ * Count every trip to the heap
+ **************************************/
+void * operator new(size_t size)
+{
+   s_allocations++;
+   void * block = malloc(size ? size : 1);
+   if (!block)
+      throw bad_alloc();
+   return block;
+}
+
+void operator delete(void * block) noexcept
+{
+   free(block);
+}
+
+void operator delete(void * block, size_t) noexcept
+{
+   free(block);
+}
+
+/*************************************
+ * FIRE
+ * The bullet an auto-firing ship at
+ * the middle of the screen fires on a
+ * frame
+ **************************************/
+Bullet fire(int frame, const Point &topLeft, const Point &bottomRight)
+{
+   Bullet bullet;
+   bullet.setBoundaries(topLeft, bottomRight);
+   bullet.fire(Point(0, 0), (float)(frame * TURN_RATE % 360));
+   return bullet;
+}
+
+/*************************************
+ * REPORT
+ * One line of the results table
+ **************************************/
+void report(const char * name, chrono::steady_clock::time_point start,
+   long allocations, int live)
+{
+   chrono::duration<double, nano> elapsed = chrono::steady_clock::now() - start;
+   printf("%8s %10.1f %12.3f %6d\n", name, elapsed.count() / BENCH_FRAMES,
+      (double)(s_allocations - allocations) / BENCH_FRAMES, live);
+}
+
+/*********************************
+ * Main runs the same firing and
+ * hit pattern through each
+ * container
+ *********************************/
+int main(int argc, char ** argv)
+{
+   Point topLeft(-200, 200);
+   Point bottomRight(200, -200);
+
+   printf("%8s %10s %12s %6s\n", "store", "ns/frame", "allocs/frame", "live");
+
+   // The list of Bullets Game used originally
+   {
+      list<Bullet> bullets;
+      long allocations = s_allocations;
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      for (int frame = 0; frame < BENCH_FRAMES; frame++)
+      {
+         for (list<Bullet>::iterator it = bullets.begin();
+            it != bullets.end(); ++it)
+            it->advance();
+
+         if (frame % HIT_EVERY == 0 && !bullets.empty())
+         {
+            list<Bullet>::iterator it = bullets.begin();
+            for (int i = frame % bullets.size(); i > 0; i--)
+               ++it;
+            it->kill();
+         }
+
+         for (list<Bullet>::iterator it = bullets.begin();
+            it != bullets.end();)
+         {
+            if (!it->isAlive())
+               it = bullets.erase(it);
+            else
+               ++it;
+         }
+
+         bullets.push_back(fire(frame, topLeft, bottomRight));
+      }
+      report("list", start, allocations, (int)bullets.size());
+   }
+
+   // The entity store
+   {
+      EntityStore bullets;
+      long allocations = s_allocations;
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      for (int frame = 0; frame < BENCH_FRAMES; frame++)
+      {
+         bullets.advance(topLeft, bottomRight);
+
+         if (frame % HIT_EVERY == 0 && bullets.size() > 0)
+            bullets.kill(frame % bullets.size());
+
+         bullets.removeDead();
+
+         Bullet bullet = fire(frame, topLeft, bottomRight);
+         bullets.add(ENTITY_BULLET, bullet.getPoint(), bullet.getVelocity(),
+            bullet.getRadius(), 0 /*spin*/, bullet.getLife());
+      }
+      report("store", start, allocations, bullets.size());
+   }
+
+   // The bullet ring
+   {
+      BulletRing bullets;
+      long allocations = s_allocations;
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      for (int frame = 0; frame < BENCH_FRAMES; frame++)
+      {
+         bullets.advance(topLeft, bottomRight);
+
+         if (frame % HIT_EVERY == 0 && bullets.size() > 0)
+         {
+            int index = frame % bullets.size();
+            if (bullets.isFlying(index))
+               bullets.kill(index);
+         }
+
+         bullets.removeDead();
+         bullets.add(fire(frame, topLeft, bottomRight));
+      }
+      report("ring", start, allocations, bullets.getLiveCount());
+      printf("\nthe ring held at most %d of its %d bullets\n",
+         bullets.getHighWater(), bullets.getCapacity());
+   }
+
+   return 0;
+}
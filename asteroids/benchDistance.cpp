@@ -0,0 +1,178 @@
+/*****************************************************
+ * File: benchDistance.cpp
+ * Author: Matthew Burr
+ *
+ * Description: Checks the analytic closest distance
+ *  against the sampled one on random pairs of moving
+ *  objects, then measures what each costs per pair.
+ ******************************************************/
+#include "collision.h"
+#include "point.h"
+#include "velocity.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#define CHECK_PAIRS 1000000
+#define BENCH_PAIRS 1000000
+#define BENCH_SEED 1
+#define FIELD_SIZE 200.0f
+#define MAX_SPEED 12.0f
+#define HIT_DISTANCE 21.0f   // a bullet against a big rock
+#define TOLERANCE 0.001f
+using namespace std;
+
+/*****************************************
+* PAIR
+* Two moving objects to test against each
+* other
+*****************************************/
+struct Pair
+{
+   Point point1;
+   Velocity velocity1;
+   Point point2;
+   Velocity velocity2;
+};
+
+/*************************************
+ * RANDOM FLOAT
+ * A random float between min and max
+ **************************************/
+float randomFloat(float min, float max)
+{
+   return min + (float)rand() / (float)RAND_MAX * (max - min);
+}
+
+/*************************************
+ * RANDOM PAIR
+ * Two objects close enough together
+ * that they are worth testing
+ **************************************/
+Pair randomPair()
+{
+   Pair pair;
+   pair.point1 = Point(randomFloat(-FIELD_SIZE, FIELD_SIZE),
+                       randomFloat(-FIELD_SIZE, FIELD_SIZE));
+   pair.point2 = Point(pair.point1.getX() + randomFloat(-40, 40),
+                       pair.point1.getY() + randomFloat(-40, 40));
+   pair.velocity1 = Velocity(randomFloat(-MAX_SPEED, MAX_SPEED),
+                             randomFloat(-MAX_SPEED, MAX_SPEED));
+   pair.velocity2 = Velocity(randomFloat(-MAX_SPEED, MAX_SPEED),
+                             randomFloat(-MAX_SPEED, MAX_SPEED));
+   return pair;
+}
+
+/*************************************
+ * CHECK EQUIVALENCE
+ * The analytic distance is the true
+ * minimum, so it can never be more than
+ * the sampled one, and can only be less
+ * by as much as the relative motion
+ * between two samples. Returns the
+ * number of pairs that break that rule.
+ **************************************/
+int checkEquivalence()
+{
+   int failures = 0;
+   int caught = 0;
+
+   for (int i = 0; i < CHECK_PAIRS; i++)
+   {
+      Pair pair = randomPair();
+
+      float sampled = getClosestDistance(pair.point1, pair.velocity1,
+                                         pair.point2, pair.velocity2);
+      float analytic = sqrt(getClosestDistanceSquared(
+         pair.point1, pair.velocity1, pair.point2, pair.velocity2));
+
+      float wx = pair.velocity1.getDx() - pair.velocity2.getDx();
+      float wy = pair.velocity1.getDy() - pair.velocity2.getDy();
+      float dMax = fabs(pair.velocity1.getDx());
+      dMax = fmax(dMax, fabs(pair.velocity1.getDy()));
+      dMax = fmax(dMax, fabs(pair.velocity2.getDx()));
+      dMax = fmax(dMax, fabs(pair.velocity2.getDy()));
+      dMax = fmax(dMax, 0.1f);
+      float gap = sqrt(wx * wx + wy * wy) / dMax;
+
+      if (analytic > sampled + TOLERANCE ||
+          sampled - analytic > gap + TOLERANCE)
+      {
+         if (failures < 10)
+            printf("mismatch: sampled %f analytic %f\n", sampled, analytic);
+         failures++;
+      }
+
+      // The sampled version can step right past a hit
+      if (sampled > HIT_DISTANCE && analytic <= HIT_DISTANCE)
+         caught++;
+   }
+
+   printf("checked %d pairs: %d mismatches, %d tunnelling hits caught\n",
+      CHECK_PAIRS, failures, caught);
+   return failures;
+}
+
+/*************************************
+ * TIME PAIRS
+ * Runs a distance test over every pair
+ * and returns the nanoseconds per pair
+ **************************************/
+template <class Test>
+double timePairs(const vector<Pair> &pairs, Test test, int &hits)
+{
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+   hits = 0;
+   for (size_t i = 0; i < pairs.size(); i++)
+      if (test(pairs[i]))
+         hits++;
+
+   chrono::duration<double, nano> elapsed =
+      chrono::steady_clock::now() - start;
+   return elapsed.count() / pairs.size();
+}
+
+/*************************************
+ * SAMPLED HIT / ANALYTIC HIT
+ * The two ways of deciding a hit
+ **************************************/
+bool sampledHit(const Pair &pair)
+{
+   return getClosestDistance(pair.point1, pair.velocity1,
+      pair.point2, pair.velocity2) <= HIT_DISTANCE;
+}
+
+bool analyticHit(const Pair &pair)
+{
+   return isSweptCollision(pair.point1, pair.velocity1,
+      pair.point2, pair.velocity2, HIT_DISTANCE);
+}
+
+/*********************************
+ * Main checks, then benchmarks
+ *********************************/
+int main(int argc, char ** argv)
+{
+   srand(BENCH_SEED);
+
+   if (checkEquivalence() != 0)
+      return 1;
+
+   vector<Pair> pairs(BENCH_PAIRS);
+   for (int i = 0; i < BENCH_PAIRS; i++)
+      pairs[i] = randomPair();
+
+   int sampledHits;
+   int analyticHits;
+   double sampledTime = timePairs(pairs, sampledHit, sampledHits);
+   double analyticTime = timePairs(pairs, analyticHit, analyticHits);
+
+   printf("%10s %10s %8s\n", "method", "ns/pair", "hits");
+   printf("%10s %10.2f %8d\n", "sampled", sampledTime, sampledHits);
+   printf("%10s %10.2f %8d\n", "analytic", analyticTime, analyticHits);
+
+   return 0;
+}
@@ -0,0 +1,345 @@
+/*****************************************************
+ * File: benchFrame.cpp
+ * Author: Matthew Burr
+ *
+ * Description: Times each phase of Game::advance, and
+ *  the draw path, across scenes of different sizes and
+ *  reports the results as CSV, one row per scene and
+ *  phase, so runs from different releases can be
+ *  compared by a script.
+ *
+ *  Usage: benchFrame [frames] [seed]
+ *
+ *  Columns:
+ *    scene             name of the scene
+ *    rocks, bullets    what the scene starts with
+ *    mix               sizes of the starting rocks
+ *    phase             advanceRocks, advanceBullets,
+ *                      advanceShip, handleCollisions,
+ *                      cleanupZombies, frame (all of
+ *                      advance) or draw
+ *    frames            frames measured
+ *    median_us, p99_us time per frame
+ *    entities_per_sec  objects put through the phase
+ *                      per second, at the median time:
+ *                      the rocks for advanceRocks, the
+ *                      bullets for advanceBullets, the
+ *                      ship for advanceShip, and every
+ *                      one the phase walks for the rest
+ *    allocs_per_frame  heap allocations per frame
+ *    avg_rocks, avg_bullets
+ *                      how many there were on average;
+ *                      scenes change as rocks are shot
+ *
+ *  Bigger scenes are played on a bigger field, so the
+ *  rocks are equally crowded in all of them.
+ ******************************************************/
+#include "game.h"
+#include "bullet.h"
+#include "rocks.h"
+#include "random.h"
+#include "point.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#define DEFAULT_FRAMES 100
+#define DEFAULT_SEED 1
+#define WARMUP_FRAMES BULLET_LIFE   // long enough for bullets to reach
+                                    // their steady state
+#define PERCENT 100
+
+// The field grows with the rock count so every scene is as crowded
+// as this many rocks on the game's 400 x 400 screen
+#define SCREEN_HALF_SIZE 200.0f
+#define ROCKS_PER_SCREEN 100
+using namespace std;
+
+static long s_allocations = 0;
+
+/*************************************
+ * OPERATOR NEW / DELETE
+ * Count every trip to the heap
+ **************************************/
+void * operator new(size_t size)
+{
+   s_allocations++;
+   void * block = malloc(size ? size : 1);
+   if (!block)
+      throw bad_alloc();
+   return block;
+}
+
+void operator delete(void * block) noexcept
+{
+   free(block);
+}
+
+void operator delete(void * block, size_t) noexcept
+{
+   free(block);
+}
+
+/*****************************************
+* MIX
+* What share of the starting rocks are of
+* each size, in percent
+*****************************************/
+struct Mix
+{
+   const char * name;
+   int big;
+   int medium;
+};
+
+const Mix BIG_MIX = { "big", 100, 0 };
+const Mix EVEN_MIX = { "even", 34, 33 };
+const Mix SMALL_MIX = { "small", 0, 0 };
+
+/*****************************************
+* SCENE
+* One set of starting conditions
+*****************************************/
+struct Scene
+{
+   const char * name;
+   int rocks;
+   int bullets;
+   Mix mix;
+};
+
+/*****************************************
+* SAMPLES
+* Every frame's time for one phase
+*****************************************/
+struct Samples
+{
+   const char * phase;
+   vector<double> seconds;
+   double entities;        // summed over the frames, as is
+   long allocations;       // this
+};
+
+/*************************************
+ * RANDOM ROCK TYPE
+ * A rock size drawn from a mix
+ **************************************/
+EntityType randomRockType(const Mix &mix)
+{
+   int roll = random(0, PERCENT);
+   if (roll < mix.big)
+      return ENTITY_BIG_ROCK;
+   if (roll < mix.big + mix.medium)
+      return ENTITY_MEDIUM_ROCK;
+   return ENTITY_SMALL_ROCK;
+}
+
+/*************************************
+ * RANDOM POINT
+ * Somewhere on the screen
+ **************************************/
+Point randomPoint(const Point &topLeft, const Point &bottomRight)
+{
+   return Point((float)random(topLeft.getX(), bottomRight.getX()),
+                (float)random(bottomRight.getY(), topLeft.getY()));
+}
+
+/*************************************
+ * FIRE BULLETS
+ * Bullets from random places in random
+ * directions, as a crowd of auto-firing
+ * ships would put out in one frame
+ **************************************/
+void fireBullets(Game &game, int count, const Point &topLeft,
+   const Point &bottomRight)
+{
+   for (int i = 0; i < count; i++)
+   {
+      Bullet bullet;
+      bullet.fire(randomPoint(topLeft, bottomRight),
+         (float)random(0.0, 360.0));
+      game.addBullet(bullet);
+   }
+}
+
+/*************************************
+ * PERCENTILE
+ * The value below which a share of the
+ * samples fall
+ **************************************/
+double percentile(vector<double> samples, double share)
+{
+   size_t rank = (size_t)(share * (samples.size() - 1) + 0.5);
+   nth_element(samples.begin(), samples.begin() + rank, samples.end());
+   return samples[rank];
+}
+
+/*************************************
+ * REPORT
+ * One CSV row
+ **************************************/
+void report(const Scene &scene, const Samples &samples, double rocks,
+   double bullets)
+{
+   int frames = (int)samples.seconds.size();
+   double median = percentile(samples.seconds, 0.5);
+   double p99 = percentile(samples.seconds, 0.99);
+   double entities = samples.entities / frames;
+
+   printf("%s,%d,%d,%s,%s,%d,%.3f,%.3f,%.0f,%.3f,%.1f,%.1f\n", scene.name,
+      scene.rocks, scene.bullets, scene.mix.name, samples.phase, frames,
+      median * 1e6, p99 * 1e6, median > 0 ? entities / median : 0.0,
+      (double)samples.allocations / frames, rocks, bullets);
+}
+
+/*************************************
+ * GET HALF SIZE
+ * Half the width of the field a scene
+ * is played on
+ **************************************/
+float getHalfSize(const Scene &scene)
+{
+   if (scene.rocks <= ROCKS_PER_SCREEN)
+      return SCREEN_HALF_SIZE;
+
+   return SCREEN_HALF_SIZE *
+      (float)sqrt((double)scene.rocks / ROCKS_PER_SCREEN);
+}
+
+/*************************************
+ * RUN SCENE
+ * Builds a scene, lets it settle and
+ * measures it
+ **************************************/
+void runScene(const Scene &scene, int frames, int seed)
+{
+   float halfSize = getHalfSize(scene);
+   Point topLeft(-halfSize, halfSize);
+   Point bottomRight(halfSize, -halfSize);
+
+   // Bullets are kept at the scene's count by firing the share of it
+   // that runs out each frame
+   int firedPerFrame = (scene.bullets + BULLET_LIFE - 1) / BULLET_LIFE;
+
+   seedRandom(seed);
+   Game game(topLeft, bottomRight, 0 /*rocks*/,
+      max(firedPerFrame * BULLET_LIFE, (int)MAX_BULLETS));
+
+   for (int i = 0; i < scene.rocks; i++)
+   {
+      Rock rock(randomRockType(scene.mix), randomPoint(topLeft, bottomRight),
+         (float)random(0.0, 360.0));
+      game.addRock(rock.getType(), rock.getPoint(), rock.getVelocity());
+   }
+
+   for (int frame = 0; frame < WARMUP_FRAMES; frame++)
+   {
+      fireBullets(game, firedPerFrame, topLeft, bottomRight);
+      game.advance();
+   }
+
+   Samples phases[] = {
+      { "advanceRocks" }, { "advanceBullets" }, { "advanceShip" },
+      { "handleCollisions" }, { "cleanupZombies" }, { "frame" }, { "draw" }
+   };
+   const int phaseCount = sizeof(phases) / sizeof(phases[0]);
+
+   FrameProfile profile;
+   profile.allocationCount = &s_allocations;
+   game.setProfile(&profile);
+
+   double rocks = 0;
+   double bullets = 0;
+
+   for (int frame = 0; frame < frames; frame++)
+   {
+      fireBullets(game, firedPerFrame, topLeft, bottomRight);
+      double frameRocks = game.getRockCount();
+      double frameBullets = game.getBulletCount();
+      rocks += frameRocks;
+      bullets += frameBullets;
+
+      game.advance();
+
+      long allocations = s_allocations;
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      game.draw();
+      chrono::duration<double> drawTime = chrono::steady_clock::now() - start;
+      long drawAllocations = s_allocations - allocations;
+
+      // What each phase walks: handleCollisions sorts every rock into
+      // the broad phase and tests the ship and every bullet against them
+      double seconds[] = { profile.advanceRocks, profile.advanceBullets,
+         profile.advanceShip, profile.handleCollisions,
+         profile.cleanupZombies, 0, drawTime.count() };
+      long allocationCounts[] = { profile.advanceRocksAllocations,
+         profile.advanceBulletsAllocations, profile.advanceShipAllocations,
+         profile.handleCollisionsAllocations,
+         profile.cleanupZombiesAllocations, 0, drawAllocations };
+      double entities[] = { frameRocks, frameBullets, 1,
+         frameRocks + frameBullets + 1, frameRocks + frameBullets,
+         frameRocks + frameBullets + 1,
+         game.getRockCount() + game.getBulletCount() + 1.0 };
+
+      // The frame is every phase of advance put together
+      for (int i = 0; i < phaseCount - 2; i++)
+      {
+         seconds[phaseCount - 2] += seconds[i];
+         allocationCounts[phaseCount - 2] += allocationCounts[i];
+      }
+
+      for (int i = 0; i < phaseCount; i++)
+      {
+         phases[i].seconds.push_back(seconds[i]);
+         phases[i].allocations += allocationCounts[i];
+         phases[i].entities += entities[i];
+      }
+   }
+
+   rocks /= frames;
+   bullets /= frames;
+   for (int i = 0; i < phaseCount; i++)
+      report(scene, phases[i], rocks, bullets);
+}
+
+/*********************************
+ * Main runs every scene: rock
+ * counts from 10 to 100k, bullet
+ * counts from 0 to 10k, and each
+ * mix of rock sizes
+ *********************************/
+int main(int argc, char ** argv)
+{
+   int frames = (argc > 1) ? atoi(argv[1]) : DEFAULT_FRAMES;
+   int seed = (argc > 2) ? atoi(argv[2]) : DEFAULT_SEED;
+   if (frames < 1)
+   {
+      fprintf(stderr, "benchFrame: frames must be at least 1\n");
+      return 1;
+   }
+
+   const Scene scenes[] = {
+      { "rocks-10",      10,     0, EVEN_MIX },
+      { "rocks-100",     100,    0, EVEN_MIX },
+      { "rocks-1k",      1000,   0, EVEN_MIX },
+      { "rocks-10k",     10000,  0, EVEN_MIX },
+      { "rocks-100k",    100000, 0, EVEN_MIX },
+      { "bullets-100",   10000,  100, EVEN_MIX },
+      { "bullets-1k",    10000,  1000, EVEN_MIX },
+      { "bullets-10k",   10000,  10000, EVEN_MIX },
+      { "mix-big",       10000,  0, BIG_MIX },
+      { "mix-small",     10000,  0, SMALL_MIX },
+   };
+
+   printf("scene,rocks,bullets,mix,phase,frames,median_us,p99_us,"
+      "entities_per_sec,allocs_per_frame,avg_rocks,avg_bullets\n");
+
+   for (size_t i = 0; i < sizeof(scenes) / sizeof(scenes[0]); i++)
+      runScene(scenes[i], frames, seed);
+
+   return 0;
+}
@@ -0,0 +1,226 @@
+/*****************************************************
+ * File: benchHash.cpp
+ * Author: Matthew Burr
+ *
+ * Description: Checks that the state hash the rocks
+ *  and bullets keep up as they change always equals
+ *  the one worked out from scratch, that it follows
+ *  a game through a snapshot and that it tells games
+ *  apart, then times taking it every frame against
+ *  the frame itself.
+ *
+ *  Usage: benchHash [rocks] [frames]
+ ******************************************************/
+#include "game.h"
+#include "gameInput.h"
+#include "random.h"
+#include "point.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#define DEFAULT_ROCKS 10000
+#define DEFAULT_FRAMES 200
+#define CHECK_FRAMES 2000
+#define SEED 1
+#define PERCENT 100
+
+// Bigger scenes are played on a bigger field, as in benchFrame
+#define SCREEN_HALF_SIZE 200.0f
+#define ROCKS_PER_SCREEN 100
+
+// How often the input presses each key, out of 100
+#define TURN_CHANCE 20
+#define THRUST_CHANCE 10
+#define FIRE_CHANCE 90
+using namespace std;
+
+/*************************************
+ * RANDOM INPUT
+ * A random set of keys, firing most
+ * frames
+ **************************************/
+GameInput randomInput(Random &bot)
+{
+   GameInput input;
+   input.left = bot.getInt(0, 100) < TURN_CHANCE;
+   input.right = !input.left && bot.getInt(0, 100) < TURN_CHANCE;
+   input.up = bot.getInt(0, 100) < THRUST_CHANCE;
+   input.fire = bot.getInt(0, 100) < FIRE_CHANCE;
+   return input;
+}
+
+/*************************************
+ * IS HASH CURRENT
+ * True if what the rocks and bullets
+ * kept matches a count from scratch
+ **************************************/
+bool isHashCurrent(const Game &game)
+{
+   return game.getRocks().getHash() == game.getRocks().computeHash() &&
+      game.getBullets().getHash() == game.getBullets().computeHash();
+}
+
+/*************************************
+ * CHECK
+ * Plays a game the way the player
+ * does, with rocks breaking up and
+ * bullets running out and hitting,
+ * checking the hash every frame.
+ * Returns false on any mismatch.
+ **************************************/
+bool check()
+{
+   Point topLeft(-200, 200);
+   Point bottomRight(200, -200);
+   Random bot(SEED);
+   Game game(topLeft, bottomRight, START_ROCK_COUNT, MAX_BULLETS, SEED);
+   Game twin(topLeft, bottomRight, START_ROCK_COUNT, MAX_BULLETS, SEED);
+   Game other(topLeft, bottomRight, START_ROCK_COUNT, MAX_BULLETS, SEED + 1);
+
+   for (int frame = 0; frame < CHECK_FRAMES; frame++)
+   {
+      GameInput input = randomInput(bot);
+      game.advance();
+      game.handleInput(input);
+      twin.advance();
+      twin.handleInput(input);
+      other.advance();
+      other.handleInput(input);
+
+      if (!isHashCurrent(game))
+      {
+         printf("the kept hash went wrong on frame %d\n", frame);
+         return false;
+      }
+      if (game.getStateHash() != twin.getStateHash())
+      {
+         printf("the same game hashed differently on frame %d\n", frame);
+         return false;
+      }
+      if (game.getStateHash() == other.getStateHash())
+      {
+         printf("different games hashed the same on frame %d\n", frame);
+         return false;
+      }
+   }
+
+   vector<unsigned char> snapshot;
+   game.saveSnapshot(snapshot);
+   Game restored(topLeft, bottomRight, START_ROCK_COUNT, MAX_BULLETS,
+      SEED + 2);
+   if (!restored.restoreSnapshot(&snapshot[0], snapshot.size()) ||
+       restored.getStateHash() != game.getStateHash() ||
+       !isHashCurrent(restored))
+   {
+      printf("a restored game hashed differently\n");
+      return false;
+   }
+
+   printf("the kept hash matched over %d frames, score %d\n",
+      CHECK_FRAMES, game.getScore());
+   return true;
+}
+
+/*************************************
+ * MEDIAN
+ **************************************/
+double median(vector<double> samples)
+{
+   nth_element(samples.begin(), samples.begin() + samples.size() / 2,
+      samples.end());
+   return samples[samples.size() / 2];
+}
+
+/*************************************
+ * SECONDS SINCE
+ **************************************/
+double secondsSince(chrono::steady_clock::time_point start)
+{
+   return chrono::duration<double>(chrono::steady_clock::now() -
+      start).count();
+}
+
+/*************************************
+ * TIME HASH
+ * Plays a field of rocks and times, per
+ * frame, the frame, taking the kept
+ * hash and adding it up from scratch
+ **************************************/
+void timeHash(int rockCount, int frames)
+{
+   float halfSize = SCREEN_HALF_SIZE;
+   if (rockCount > ROCKS_PER_SCREEN)
+      halfSize *= (float)sqrt((double)rockCount / ROCKS_PER_SCREEN);
+   Point topLeft(-halfSize, halfSize);
+   Point bottomRight(halfSize, -halfSize);
+
+   Random random(SEED);
+   Game game(topLeft, bottomRight, 0, MAX_BULLETS, SEED);
+   for (int i = 0; i < rockCount; i++)
+   {
+      int roll = random.getInt(0, PERCENT);
+      EntityType type = roll < 34 ? ENTITY_BIG_ROCK :
+         roll < 67 ? ENTITY_MEDIUM_ROCK : ENTITY_SMALL_ROCK;
+      Point point(random.getFloat(-halfSize, halfSize),
+         random.getFloat(-halfSize, halfSize));
+      Velocity velocity(random.getFloat(-1, 1), random.getFloat(-1, 1));
+      game.addRock(type, point, velocity);
+   }
+
+   vector<double> frameTimes;
+   vector<double> hashTimes;
+   vector<double> scratchTimes;
+   unsigned long long total = 0;
+   for (int frame = 0; frame < frames; frame++)
+   {
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      game.advance();
+      frameTimes.push_back(secondsSince(start));
+
+      start = chrono::steady_clock::now();
+      total += game.getStateHash();
+      hashTimes.push_back(secondsSince(start));
+
+      start = chrono::steady_clock::now();
+      total += game.getRocks().computeHash();
+      scratchTimes.push_back(secondsSince(start));
+   }
+
+   double frameTime = median(frameTimes);
+   double hashTime = median(hashTimes);
+   double scratchTime = median(scratchTimes);
+   printf("\n%7s %10s %10s %10s %12s\n", "rocks", "frame us", "hash us",
+      "% frame", "scratch us");
+   printf("%7d %10.2f %10.3f %10.3f %12.2f\n", game.getRockCount(),
+      frameTime * 1e6, hashTime * 1e6, PERCENT * hashTime / frameTime,
+      scratchTime * 1e6);
+
+   // Keeps the hashes from being optimized away
+   if (total == 0)
+      printf("\n");
+}
+
+/*********************************
+ * Main checks the hash and then
+ * times it
+ *********************************/
+int main(int argc, char ** argv)
+{
+   int rocks = (argc > 1) ? atoi(argv[1]) : DEFAULT_ROCKS;
+   int frames = (argc > 2) ? atoi(argv[2]) : DEFAULT_FRAMES;
+   if (rocks < 1 || frames < 1)
+   {
+      fprintf(stderr, "benchHash: rocks and frames must be at least 1\n");
+      return 1;
+   }
+
+   if (!check())
+      return 1;
+
+   timeHash(rocks, frames);
+   return 0;
+}
@@ -0,0 +1,174 @@
+/*****************************************************
+ * File: benchPacer.cpp
+ * Author: Matthew Burr
+ *
+ * Description: Runs a loop of fake frames paced two
+ *  ways, the old clock() way and with the FramePacer,
+ *  and reports how steady the frames were and how
+ *  much CPU the loop used.
+ *
+ *  Usage: benchPacer [seconds] [workMs]
+ *
+ *  Each frame busies the CPU for workMs milliseconds,
+ *  as advancing and drawing the game would. The old
+ *  way measured time with clock(), which is CPU time,
+ *  so the time it spent asleep didn't count toward
+ *  the frame.
+ ******************************************************/
+#include "framePacer.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <time.h>
+#include <vector>
+
+#define DEFAULT_SECONDS 2.0
+#define DEFAULT_WORK_MS 5.0
+using namespace std;
+
+/*************************************
+ * WORK
+ * Keeps the CPU busy for a while
+ **************************************/
+void work(double seconds)
+{
+   long long until = FramePacer::getNow() + (long long)(seconds * 1e9);
+   while (FramePacer::getNow() < until)
+      ;
+}
+
+/*************************************
+ * SLEEP MS
+ * Sleeps for some milliseconds, the
+ * way the old interface did
+ **************************************/
+void sleepMs(unsigned long msSleep)
+{
+   timespec req = {};
+   req.tv_sec = (time_t)(msSleep / 1000);
+   req.tv_nsec = (long)(msSleep % 1000) * 1000000L;
+
+   while (nanosleep(&req, &req) == -1)
+      ;
+}
+
+/*************************************
+ * REPORT
+ * How steady a run's frames were
+ **************************************/
+void report(const char * mode, double framesPerSecond,
+   const vector<long long> &starts, double cpuSeconds)
+{
+   int intervals = (int)starts.size() - 1;
+   double sum = 0;
+   double minimum = 1e30;
+   double maximum = 0;
+   for (int i = 0; i < intervals; i++)
+   {
+      double interval = (starts[i + 1] - starts[i]) / 1e9;
+      sum += interval;
+      if (interval < minimum)
+         minimum = interval;
+      if (interval > maximum)
+         maximum = interval;
+   }
+
+   double mean = sum / intervals;
+   double squares = 0;
+   for (int i = 0; i < intervals; i++)
+   {
+      double difference = (starts[i + 1] - starts[i]) / 1e9 - mean;
+      squares += difference * difference;
+   }
+
+   double wallSeconds = (starts.back() - starts.front()) / 1e9;
+   printf("%-8s %5.0f %7d %9.3f %9.3f %9.3f %9.3f %9.1f %6.0f%%\n", mode,
+      framesPerSecond, intervals, mean * 1e3,
+      sqrt(squares / (intervals - 1)) * 1e3, minimum * 1e3, maximum * 1e3,
+      1.0 / mean, wallSeconds > 0 ? cpuSeconds / wallSeconds * 100 : 0.0);
+}
+
+/*************************************
+ * RUN CLOCK
+ * Paces frames the way the interface
+ * used to: sleep until clock() reaches
+ * the next tick
+ **************************************/
+void runClock(double framesPerSecond, double seconds, double workSeconds)
+{
+   double period = 1.0 / framesPerSecond;
+   unsigned int nextTick = 0;
+   vector<long long> starts;
+
+   clock_t cpuStart = clock();
+   long long end = FramePacer::getNow() + (long long)(seconds * 1e9);
+   while (FramePacer::getNow() < end)
+   {
+      starts.push_back(FramePacer::getNow());
+      work(workSeconds);
+
+      if ((unsigned int)clock() < nextTick)
+         sleepMs((unsigned long)((nextTick - clock()) / 1000));
+      nextTick = clock() + static_cast<int> (period * CLOCKS_PER_SEC);
+   }
+   starts.push_back(FramePacer::getNow());
+
+   report("clock", framesPerSecond, starts,
+      (double)(clock() - cpuStart) / CLOCKS_PER_SEC);
+}
+
+/*************************************
+ * RUN PACER
+ * Paces frames with the FramePacer
+ **************************************/
+void runPacer(double framesPerSecond, double seconds, double workSeconds)
+{
+   FramePacer pacer(framesPerSecond);
+   vector<long long> starts;
+
+   clock_t cpuStart = clock();
+   long long end = FramePacer::getNow() + (long long)(seconds * 1e9);
+   while (FramePacer::getNow() < end)
+   {
+      pacer.waitForNextFrame();
+      starts.push_back(FramePacer::getNow());
+      work(workSeconds);
+   }
+
+   report("pacer", framesPerSecond, starts,
+      (double)(clock() - cpuStart) / CLOCKS_PER_SEC);
+
+   FrameStats stats = pacer.getStats();
+   printf("         pacer's own stats: jitter %.3f ms, latest %.3f ms, "
+      "missed %d\n", stats.jitter * 1e3, stats.maxLateness * 1e3,
+      stats.missed);
+}
+
+/*********************************
+ * Main runs each way at a few
+ * frame rates
+ *********************************/
+int main(int argc, char ** argv)
+{
+   double seconds = (argc > 1) ? atof(argv[1]) : DEFAULT_SECONDS;
+   double workMs = (argc > 2) ? atof(argv[2]) : DEFAULT_WORK_MS;
+   if (seconds <= 0 || workMs < 0)
+   {
+      fprintf(stderr, "benchPacer: seconds must be positive\n");
+      return 1;
+   }
+
+   const double rates[] = { 30, 60, 120 };
+
+   printf("%-8s %5s %7s %9s %9s %9s %9s %9s %7s\n", "mode", "fps",
+      "frames", "mean ms", "jitter ms", "min ms", "max ms", "real fps",
+      "cpu");
+   for (size_t i = 0; i < sizeof(rates) / sizeof(rates[0]); i++)
+   {
+      runClock(rates[i], seconds, workMs / 1000);
+      runPacer(rates[i], seconds, workMs / 1000);
+   }
+
+   return 0;
+}
@@ -0,0 +1,257 @@
+/*****************************************************
+ * File: benchParallel.cpp
+ * Author: Matthew Burr
+ *
+ * Description: Checks that splitting the rock and
+ *  bullet advance between threads gives exactly the
+ *  same state as doing it on one, then measures how
+ *  the advance and collision phases scale with the
+ *  thread count. Every scene must end with the same
+ *  score and rocks on any number of threads.
+ *
+ *  Usage: benchParallel [frames] [maxThreads]
+ *
+ *  Thread counts double from 1 up to maxThreads,
+ *  which defaults to the number of cores (at least 4,
+ *  so the check always has threads to race).
+ ******************************************************/
+#include "game.h"
+#include "entityStore.h"
+#include "taskPool.h"
+#include "bullet.h"
+#include "rocks.h"
+#include "random.h"
+#include "point.h"
+#include "velocity.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#define DEFAULT_FRAMES 100
+#define MIN_CHECK_THREADS 4
+#define CHECK_ENTRIES 100003   // not a multiple of the chunk size
+#define CHECK_FRAMES 50
+#define SEED 1
+#define ROCKS_PER_SCREEN 100
+#define SCREEN_HALF_SIZE 200.0f
+using namespace std;
+
+/*****************************************
+* SCENE
+* Rocks to start with and bullets fired
+* each frame
+*****************************************/
+struct Scene
+{
+   int rocks;
+   int bulletsPerFrame;
+};
+
+/*****************************************
+* OUTCOME
+* How a scene ended
+*****************************************/
+struct Outcome
+{
+   int score;
+   int rocks;
+};
+
+/*************************************
+ * RANDOM POINT
+ * Somewhere on the field
+ **************************************/
+Point randomPoint(float halfSize)
+{
+   return Point((float)random(-halfSize, halfSize),
+                (float)random(-halfSize, halfSize));
+}
+
+/*************************************
+ * MAKE STORE
+ * A store full of rocks of every size
+ **************************************/
+void makeStore(EntityStore &store, int count, float halfSize)
+{
+   const EntityType types[] = {
+      ENTITY_BIG_ROCK, ENTITY_MEDIUM_ROCK, ENTITY_SMALL_ROCK
+   };
+
+   seedRandom(SEED);
+   for (int i = 0; i < count; i++)
+   {
+      EntityType type = types[i % 3];
+      Velocity velocity;
+      velocity.setDx((float)random(-5.0, 5.0));
+      velocity.setDy((float)random(-5.0, 5.0));
+      store.add(type, randomPoint(halfSize), velocity, getRockRadius(type),
+         getRockSpin(type), 0 /*life*/);
+   }
+}
+
+/*************************************
+ * IS SAME
+ * True if two stores hold exactly the
+ * same state
+ **************************************/
+bool isSame(const EntityStore &lhs, const EntityStore &rhs)
+{
+   if (lhs.size() != rhs.size())
+      return false;
+
+   for (int i = 0; i < lhs.size(); i++)
+   {
+      if (lhs.getX(i) != rhs.getX(i) || lhs.getY(i) != rhs.getY(i) ||
+          lhs.getRotation(i) != rhs.getRotation(i) ||
+          lhs.getLife(i) != rhs.getLife(i) ||
+          lhs.isAlive(i) != rhs.isAlive(i))
+         return false;
+   }
+
+   return true;
+}
+
+/*************************************
+ * CHECK
+ * Advances the same store on one
+ * thread and on each thread count and
+ * compares them
+ **************************************/
+bool check(int maxThreads)
+{
+   Point topLeft(-SCREEN_HALF_SIZE, SCREEN_HALF_SIZE);
+   Point bottomRight(SCREEN_HALF_SIZE, -SCREEN_HALF_SIZE);
+
+   EntityStore expected;
+   makeStore(expected, CHECK_ENTRIES, SCREEN_HALF_SIZE);
+   for (int frame = 0; frame < CHECK_FRAMES; frame++)
+      expected.advance(topLeft, bottomRight);
+
+   bool isOk = true;
+   for (int threads = 1; threads <= maxThreads; threads *= 2)
+   {
+      TaskPool pool(threads);
+      EntityStore store;
+      makeStore(store, CHECK_ENTRIES, SCREEN_HALF_SIZE);
+      for (int frame = 0; frame < CHECK_FRAMES; frame++)
+         store.advance(topLeft, bottomRight, &pool);
+
+      bool isMatch = isSame(store, expected);
+      printf("check %2d threads: %s\n", threads, isMatch ? "ok" : "MISMATCH");
+      isOk = isOk && isMatch;
+   }
+
+   return isOk;
+}
+
+/*************************************
+ * MEDIAN
+ * The middle of a set of samples
+ **************************************/
+double median(vector<double> samples)
+{
+   size_t middle = samples.size() / 2;
+   nth_element(samples.begin(), samples.begin() + middle, samples.end());
+   return samples[middle];
+}
+
+/*************************************
+ * RUN
+ * Plays a scene on some number of
+ * threads and reports the time spent
+ * advancing rocks and bullets and
+ * handling collisions
+ **************************************/
+Outcome run(const Scene &scene, int threads, int frames)
+{
+   int rocks = scene.rocks;
+   int bulletsPerFrame = scene.bulletsPerFrame;
+   float halfSize = SCREEN_HALF_SIZE *
+      (float)sqrt(max(1.0, (double)rocks / ROCKS_PER_SCREEN));
+
+   seedRandom(SEED);
+   Game game(Point(-halfSize, halfSize), Point(halfSize, -halfSize),
+      0 /*rocks*/, max(bulletsPerFrame * BULLET_LIFE, (int)MAX_BULLETS));
+   game.setThreadCount(threads);
+
+   for (int i = 0; i < rocks; i++)
+   {
+      BigRock rock(randomPoint(halfSize), (float)random(0.0, 360.0));
+      game.addRock(rock.getType(), rock.getPoint(), rock.getVelocity());
+   }
+
+   FrameProfile profile;
+   game.setProfile(&profile);
+
+   vector<double> advanceSeconds;
+   vector<double> collideSeconds;
+   for (int frame = 0; frame < frames; frame++)
+   {
+      for (int i = 0; i < bulletsPerFrame; i++)
+      {
+         Bullet bullet;
+         bullet.fire(randomPoint(halfSize), (float)random(0.0, 360.0));
+         game.addBullet(bullet);
+      }
+
+      game.advance();
+      advanceSeconds.push_back(profile.advanceRocks + profile.advanceBullets);
+      collideSeconds.push_back(profile.handleCollisions);
+   }
+
+   printf("%8d %8d %8d %12.1f %12.1f %8d %8d\n", rocks,
+      bulletsPerFrame * BULLET_LIFE, threads, median(advanceSeconds) * 1e6,
+      median(collideSeconds) * 1e6, game.getScore(), game.getRockCount());
+
+   Outcome outcome = { game.getScore(), game.getRockCount() };
+   return outcome;
+}
+
+/*********************************
+ * Main checks the parallel advance
+ * and then times it and collisions
+ * on a range of scene sizes and
+ * thread counts
+ *********************************/
+int main(int argc, char ** argv)
+{
+   int frames = (argc > 1) ? atoi(argv[1]) : DEFAULT_FRAMES;
+   int maxThreads = (argc > 2) ? atoi(argv[2]) :
+      max(TaskPool::getCoreCount(), MIN_CHECK_THREADS);
+   if (frames < 1 || maxThreads < 1)
+   {
+      fprintf(stderr, "benchParallel: frames and threads must be at least 1\n");
+      return 1;
+   }
+
+   printf("cores: %d\n", TaskPool::getCoreCount());
+   bool isOk = check(maxThreads);
+
+   const Scene scenes[] = {
+      { 10000, 100 }, { 100000, 100 }, { 1000000, 100 },
+      { 10000, 250 }, { 100000, 500 }
+   };
+
+   printf("%8s %8s %8s %12s %12s %8s %8s\n", "rocks", "bullets", "threads",
+      "advance us", "collide us", "score", "rocks");
+   for (size_t s = 0; s < sizeof(scenes) / sizeof(scenes[0]); s++)
+   {
+      Outcome expected = { 0, 0 };
+      for (int threads = 1; threads <= maxThreads; threads *= 2)
+      {
+         Outcome outcome = run(scenes[s], threads, frames);
+         if (threads == 1)
+            expected = outcome;
+         else if (outcome.score != expected.score ||
+                  outcome.rocks != expected.rocks)
+         {
+            printf("  MISMATCH: differs from one thread\n");
+            isOk = false;
+         }
+      }
+   }
+
+   return isOk ? 0 : 1;
+}
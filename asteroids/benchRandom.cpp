@@ -0,0 +1,171 @@
+/*****************************************************
+ * File: benchRandom.cpp
+ * Author: Matthew Burr
+ *
+ * Description: Checks the Random generator gives the
+ *  same numbers for the same seed, different ones for
+ *  a different seed or a split stream, and stays in
+ *  range; then times it against rand(), on one thread
+ *  and on several at once.
+ *
+ *  Usage: benchRandom [numbers] [threads]
+ ******************************************************/
+#include "random.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#define DEFAULT_NUMBERS 10000000
+#define DEFAULT_THREADS 4
+#define CHECK_NUMBERS 100000
+using namespace std;
+
+/*************************************
+ * CHECK
+ * Returns false, and says why, if the
+ * generator misbehaves
+ **************************************/
+bool check()
+{
+   Random first(42);
+   Random again(42);
+   Random other(43);
+   Random split(42);
+   Random stream = split.split();
+
+   int matchesOther = 0;
+   int matchesStream = 0;
+   for (int i = 0; i < CHECK_NUMBERS; i++)
+   {
+      unsigned long long number = first.next();
+      if (number != again.next())
+      {
+         printf("the same seed gave different numbers\n");
+         return false;
+      }
+      matchesOther += (number == other.next());
+      matchesStream += (stream.next() == split.next());
+   }
+   if (matchesOther > 0 || matchesStream > 0)
+   {
+      printf("streams that should differ matched %d and %d times\n",
+         matchesOther, matchesStream);
+      return false;
+   }
+
+   // every value in a small range turns up, and nothing outside it
+   int counts[7] = { 0 };
+   for (int i = 0; i < CHECK_NUMBERS; i++)
+   {
+      int number = first.getInt(-3, 4);
+      float real = first.getFloat(-1.0f, 1.0f);
+      if (number < -3 || number >= 4 || real < -1.0f || real >= 1.0f)
+      {
+         printf("a number was out of range\n");
+         return false;
+      }
+      counts[number + 3]++;
+   }
+   for (int i = 0; i < 7; i++)
+      if (counts[i] < CHECK_NUMBERS / 7 * 9 / 10)
+      {
+         printf("%d came up only %d times\n", i - 3, counts[i]);
+         return false;
+      }
+
+   // a fill gives what one at a time would
+   vector<float> filled(1000);
+   Random filler(7);
+   Random single(7);
+   filler.fill(&filled[0], (int)filled.size(), 0.0f, 400.0f);
+   for (size_t i = 0; i < filled.size(); i++)
+      if (filled[i] != single.getFloat(0.0f, 400.0f))
+      {
+         printf("fill differed from getFloat at %d\n", (int)i);
+         return false;
+      }
+
+   return true;
+}
+
+/*************************************
+ * DRAW RAND
+ * Draws numbers with rand()
+ **************************************/
+void drawRand(int numbers, long long *sum)
+{
+   long long total = 0;
+   for (int i = 0; i < numbers; i++)
+      total += rand() % 360;
+   *sum = total;
+}
+
+/*************************************
+ * DRAW RANDOM
+ * Draws numbers from a generator of
+ * the thread's own
+ **************************************/
+void drawRandom(int numbers, unsigned long long seed, long long *sum)
+{
+   Random random(seed);
+   long long total = 0;
+   for (int i = 0; i < numbers; i++)
+      total += random.getInt(0, 360);
+   *sum = total;
+}
+
+/*************************************
+ * TIME SOURCE
+ * Nanoseconds a number, drawing them
+ * on a number of threads at once
+ **************************************/
+double timeSource(bool isRand, int numbers, int threads)
+{
+   vector<long long> sums(threads);
+   vector<thread> workers;
+
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   for (int t = 0; t < threads; t++)
+   {
+      if (isRand)
+         workers.push_back(thread(drawRand, numbers, &sums[t]));
+      else
+         workers.push_back(thread(drawRandom, numbers, t + 1, &sums[t]));
+   }
+   for (int t = 0; t < threads; t++)
+      workers[t].join();
+   double seconds = chrono::duration<double>(chrono::steady_clock::now() -
+      start).count();
+
+   return seconds * 1e9 / ((double)numbers * threads);
+}
+
+/*********************************
+ * Main checks, then times
+ *********************************/
+int main(int argc, char ** argv)
+{
+   int numbers = (argc > 1) ? atoi(argv[1]) : DEFAULT_NUMBERS;
+   int threads = (argc > 2) ? atoi(argv[2]) : DEFAULT_THREADS;
+   if (numbers < 1 || threads < 1)
+   {
+      fprintf(stderr, "benchRandom: numbers and threads must be positive\n");
+      return 1;
+   }
+
+   if (!check())
+      return 1;
+   printf("checks passed\n");
+
+   printf("%-8s %8s %12s\n", "source", "threads", "ns/number");
+   printf("%-8s %8d %12.2f\n", "rand", 1, timeSource(true, numbers, 1));
+   printf("%-8s %8d %12.2f\n", "Random", 1, timeSource(false, numbers, 1));
+   printf("%-8s %8d %12.2f\n", "rand", threads,
+      timeSource(true, numbers, threads));
+   printf("%-8s %8d %12.2f\n", "Random", threads,
+      timeSource(false, numbers, threads));
+
+   return 0;
+}
@@ -0,0 +1,138 @@
+/*****************************************************
+ * File: benchRaster.cpp
+ * Author: Matthew Burr
+ *
+ * Description: Plays the game with random input and
+ *  draws every frame into memory with the software
+ *  back end, in color and in gray, and reports how
+ *  many frames a second it can draw.
+ *
+ *  Usage: benchRaster [frames] [rocks] [image.ppm]
+ *
+ *  Given a file name, the last color frame is saved
+ *  to it as a PPM image to look at.
+ ******************************************************/
+#include "game.h"
+#include "gameInput.h"
+#include "point.h"
+#include "random.h"
+#include "uiDrawRaster.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#define DEFAULT_FRAMES 2000
+#define WIDTH 400
+#define HEIGHT 400
+#define SEED 1
+
+// How often the input presses each key, out of 100
+#define TURN_CHANCE 20
+#define THRUST_CHANCE 10
+#define FIRE_CHANCE 30
+using namespace std;
+
+/*************************************
+ * RANDOM INPUT
+ * A random set of keys
+ **************************************/
+GameInput randomInput(Random &bot)
+{
+   GameInput input;
+   input.left = bot.getInt(0, 100) < TURN_CHANCE;
+   input.right = !input.left && bot.getInt(0, 100) < TURN_CHANCE;
+   input.up = bot.getInt(0, 100) < THRUST_CHANCE;
+   input.fire = bot.getInt(0, 100) < FIRE_CHANCE;
+   return input;
+}
+
+/*************************************
+ * RUN
+ * Plays frames of the game, drawing
+ * each into a framebuffer. Returns
+ * the seconds spent drawing.
+ **************************************/
+double run(PixelFormat format, int frames, int rocks,
+   vector<unsigned char> &pixels)
+{
+   Point topLeft(-200, 200);
+   Point bottomRight(200, -200);
+
+   int bytes = (format == PIXEL_RGBA) ? 4 : 1;
+   pixels.assign(WIDTH * HEIGHT * bytes, 0);
+   Framebuffer framebuffer = { &pixels[0], WIDTH, HEIGHT, WIDTH * bytes,
+      format };
+   setFramebuffer(framebuffer, topLeft, bottomRight);
+
+   Random bot(SEED);
+   Game game(topLeft, bottomRight, rocks, MAX_BULLETS, bot.next());
+
+   double seconds = 0;
+   for (int frame = 0; frame < frames; frame++)
+   {
+      game.advance();
+      game.handleInput(randomInput(bot));
+
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      clearFramebuffer();
+      game.draw();
+      seconds += chrono::duration<double>(chrono::steady_clock::now() -
+         start).count();
+   }
+
+   return seconds;
+}
+
+/*************************************
+ * SAVE PPM
+ * Writes a color framebuffer out as a
+ * binary PPM. Returns false if it
+ * can't.
+ **************************************/
+bool savePpm(const char * fileName, const vector<unsigned char> &pixels)
+{
+   FILE *file = fopen(fileName, "wb");
+   if (file == NULL)
+      return false;
+
+   fprintf(file, "P6\n%d %d\n255\n", WIDTH, HEIGHT);
+   for (int i = 0; i < WIDTH * HEIGHT; i++)
+      fwrite(&pixels[i * 4], 1, 3, file);
+
+   return fclose(file) == 0;
+}
+
+/*********************************
+ * Main times each pixel format
+ *********************************/
+int main(int argc, char ** argv)
+{
+   int frames = (argc > 1) ? atoi(argv[1]) : DEFAULT_FRAMES;
+   int rocks = (argc > 2) ? atoi(argv[2]) : START_ROCK_COUNT;
+   if (frames < 1 || rocks < 0)
+   {
+      fprintf(stderr, "benchRaster: frames must be at least 1\n");
+      return 1;
+   }
+
+   vector<unsigned char> pixels;
+   printf("%-6s %7s %6s %10s %10s\n", "format", "frames", "rocks",
+      "us/frame", "fps");
+
+   double seconds = run(PIXEL_GRAY, frames, rocks, pixels);
+   printf("%-6s %7d %6d %10.1f %10.0f\n", "gray", frames, rocks,
+      seconds / frames * 1e6, frames / seconds);
+
+   seconds = run(PIXEL_RGBA, frames, rocks, pixels);
+   printf("%-6s %7d %6d %10.1f %10.0f\n", "rgba", frames, rocks,
+      seconds / frames * 1e6, frames / seconds);
+
+   if (argc > 3 && !savePpm(argv[3], pixels))
+   {
+      fprintf(stderr, "benchRaster: can't write %s\n", argv[3]);
+      return 1;
+   }
+
+   return 0;
+}
@@ -0,0 +1,143 @@
+/*****************************************************
+ * File: benchReplay.cpp
+ * Author: Matthew Burr
+ *
+ * Description: Plays a long session with keys held
+ *  the way a player holds them, recording it, then
+ *  checks that replaying the recording ends in
+ *  exactly the same game and times the replay.
+ *
+ *  Usage: benchReplay [minutes] [record.log]
+ *
+ *  Given a file name, the recording is also saved to
+ *  it, for the replay program.
+ ******************************************************/
+#include "game.h"
+#include "gameInput.h"
+#include "inputLog.h"
+#include "random.h"
+#include "point.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#define DEFAULT_MINUTES 30
+#define TICKS_PER_MINUTE (30 * 60)   // as the game plays
+#define SEED 1
+
+// How often, out of 1000 a tick, the player lets go of or presses
+// each key
+#define TURN_CHANGE 40
+#define THRUST_CHANGE 20
+#define FIRE_CHANGE 150
+using namespace std;
+
+/*************************************
+ * PLAYER INPUT
+ * The keys held now, most often the
+ * same as a tick ago
+ **************************************/
+GameInput playerInput(Random &player, const GameInput &last)
+{
+   GameInput input = last;
+   if (player.getInt(0, 1000) < TURN_CHANGE)
+   {
+      int turn = player.getInt(0, 3);
+      input.left = (turn == 1);
+      input.right = (turn == 2);
+   }
+   if (player.getInt(0, 1000) < THRUST_CHANGE)
+      input.up = !input.up;
+   if (player.getInt(0, 1000) < FIRE_CHANGE)
+      input.fire = !input.fire;
+   return input;
+}
+
+/*************************************
+ * REPLAY
+ * Plays a recording into a new game
+ **************************************/
+void replay(const InputLog &log, Game &game)
+{
+   for (int run = 0; run < log.getRunCount(); run++)
+   {
+      GameInput input = unpackInput(log.getRun(run).keys);
+      for (int tick = 0; tick < log.getRun(run).length; tick++)
+      {
+         game.advance();
+         game.handleInput(input);
+      }
+   }
+}
+
+/*********************************
+ * Main records, replays and
+ * compares
+ *********************************/
+int main(int argc, char ** argv)
+{
+   int minutes = (argc > 1) ? atoi(argv[1]) : DEFAULT_MINUTES;
+   if (minutes < 1)
+   {
+      fprintf(stderr, "benchReplay: minutes must be at least 1\n");
+      return 1;
+   }
+
+   Point topLeft(-200, 200);
+   Point bottomRight(200, -200);
+   Random player(SEED);
+   unsigned long long seed = player.next();
+
+   // Play and record, the way the driver does
+   Game live(topLeft, bottomRight, START_ROCK_COUNT, MAX_BULLETS, seed);
+   InputLog log(seed, START_ROCK_COUNT);
+   GameInput input = { false, false, false, false };
+   int ticks = minutes * TICKS_PER_MINUTE;
+   for (int tick = 0; tick < ticks; tick++)
+   {
+      live.advance();
+      input = playerInput(player, input);
+      live.handleInput(input);
+      log.add(input);
+   }
+
+   vector<unsigned char> bytes;
+   log.write(bytes);
+   InputLog loaded;
+   if (!loaded.read(&bytes[0], bytes.size()))
+   {
+      printf("the recording didn't read back\n");
+      return 1;
+   }
+   if (argc > 2 && !log.save(argv[2]))
+   {
+      fprintf(stderr, "benchReplay: can't write %s\n", argv[2]);
+      return 1;
+   }
+
+   Game replayed(topLeft, bottomRight, loaded.getRockCount(), MAX_BULLETS,
+      loaded.getSeed());
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   replay(loaded, replayed);
+   double seconds = chrono::duration<double>(chrono::steady_clock::now() -
+      start).count();
+
+   vector<unsigned char> liveSnapshot;
+   vector<unsigned char> replayedSnapshot;
+   live.saveSnapshot(liveSnapshot);
+   replayed.saveSnapshot(replayedSnapshot);
+   if (liveSnapshot != replayedSnapshot)
+   {
+      printf("the replay ended in a different game\n");
+      return 1;
+   }
+
+   printf("%7s %7s %6s %6s %8s %8s %10s\n", "minutes", "ticks", "runs",
+      "bytes", "bytes/s", "score", "replay s");
+   printf("%7d %7d %6d %6d %8.1f %8d %10.3f\n", minutes, ticks,
+      loaded.getRunCount(), (int)bytes.size(),
+      bytes.size() / (minutes * 60.0), replayed.getScore(), seconds);
+
+   return 0;
+}
@@ -0,0 +1,264 @@
+/*****************************************************
+ * File: benchRewind.cpp
+ * Author: Matthew Burr
+ *
+ * Description: Plays a game forwards and backwards
+ *  in random stretches, checking that every step
+ *  back lands on exactly the game that was there,
+ *  then times recording a minute of a big field of
+ *  rocks against the frames themselves, measures the
+ *  memory it takes and times rewinding it.
+ *
+ *  Usage: benchRewind [rocks]
+ ******************************************************/
+#include "game.h"
+#include "gameInput.h"
+#include "rewindBuffer.h"
+#include "random.h"
+#include "point.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#define DEFAULT_ROCKS 2000
+#define TICKS_PER_SECOND 30   // as the game plays
+#define REWIND_SECONDS 60
+#define REWIND_TICKS (REWIND_SECONDS * TICKS_PER_SECOND)
+#define CHECK_STRETCHES 400
+#define MAX_STRETCH 400
+#define SEED 1
+#define PERCENT 100
+
+// Bigger scenes are played on a bigger field, as in benchFrame
+#define SCREEN_HALF_SIZE 200.0f
+#define ROCKS_PER_SCREEN 100
+
+// How often the input presses each key, out of 100
+#define TURN_CHANCE 20
+#define THRUST_CHANCE 10
+#define FIRE_CHANCE 30
+using namespace std;
+
+/*************************************
+ * RANDOM INPUT
+ **************************************/
+GameInput randomInput(Random &bot)
+{
+   GameInput input;
+   input.left = bot.getInt(0, 100) < TURN_CHANCE;
+   input.right = !input.left && bot.getInt(0, 100) < TURN_CHANCE;
+   input.up = bot.getInt(0, 100) < THRUST_CHANCE;
+   input.fire = bot.getInt(0, 100) < FIRE_CHANCE;
+   return input;
+}
+
+/*************************************
+ * CHECK
+ * Plays and rewinds in stretches of
+ * random length, keeping the hash of
+ * every tick played and not rewound.
+ * Every step back must land on the
+ * hash before, and the buffer must
+ * hold as many ticks as a ring of
+ * exactly a minute would. Returns
+ * false if not.
+ **************************************/
+bool check()
+{
+   Point topLeft(-200, 200);
+   Point bottomRight(200, -200);
+   Random bot(SEED);
+   Game game(topLeft, bottomRight, START_ROCK_COUNT, MAX_BULLETS, SEED);
+   RewindBuffer rewind(REWIND_TICKS);
+   vector<unsigned long long> history(1, game.getStateHash());
+   long long played = 0;
+   long long rewound = 0;
+   long long reachable = 0;
+
+   for (int stretch = 0; stretch < CHECK_STRETCHES; stretch++)
+   {
+      int ticks = bot.getInt(1, MAX_STRETCH + 1);
+      if (bot.getInt(0, 3) > 0)
+      {
+         for (int tick = 0; tick < ticks; tick++, played++)
+         {
+            GameInput input = randomInput(bot);
+            rewind.record(game, input);
+            game.advance();
+            game.handleInput(input);
+            history.push_back(game.getStateHash());
+            reachable = min(reachable + 1, (long long)REWIND_TICKS);
+         }
+
+         long long most = REWIND_TICKS + 2 * REWIND_KEYFRAME_INTERVAL;
+         if (rewind.getTickCount() < reachable ||
+             rewind.getTickCount() > most)
+         {
+            printf("the buffer held %lld ticks, not a minute\n",
+               rewind.getTickCount());
+            return false;
+         }
+         continue;
+      }
+
+      for (int tick = 0; tick < ticks; tick++)
+      {
+         if (!rewind.stepBack(game))
+         {
+            if (rewind.getTickCount() != 0)
+            {
+               printf("stepping back failed with ticks left\n");
+               return false;
+            }
+
+            // What was dropped off the back can't be rewound
+            history.assign(1, game.getStateHash());
+            break;
+         }
+
+         history.pop_back();
+         rewound++;
+         reachable = max(reachable - 1, 0LL);
+         if (game.getStateHash() != history.back())
+         {
+            printf("stepping back gave a different game on stretch %d\n",
+               stretch);
+            return false;
+         }
+      }
+   }
+
+   printf("played %lld ticks and rewound %lld, every step back matched\n",
+      played, rewound);
+   return true;
+}
+
+/*************************************
+ * MEDIAN
+ **************************************/
+double median(vector<double> samples)
+{
+   nth_element(samples.begin(), samples.begin() + samples.size() / 2,
+      samples.end());
+   return samples[samples.size() / 2];
+}
+
+/*************************************
+ * MEAN
+ **************************************/
+double mean(const vector<double> &samples)
+{
+   double total = 0;
+   for (size_t i = 0; i < samples.size(); i++)
+      total += samples[i];
+   return total / samples.size();
+}
+
+/*************************************
+ * SECONDS SINCE
+ **************************************/
+double secondsSince(chrono::steady_clock::time_point start)
+{
+   return chrono::duration<double>(chrono::steady_clock::now() -
+      start).count();
+}
+
+/*************************************
+ * TIME REWIND
+ * Plays two minutes of a field of
+ * rocks, recording them, and times the
+ * frames and the recording over the
+ * second, once the buffer is full and
+ * has all the memory it needs. Then
+ * rewinds as far as it will go.
+ **************************************/
+void timeRewind(int rockCount)
+{
+   float halfSize = SCREEN_HALF_SIZE;
+   if (rockCount > ROCKS_PER_SCREEN)
+      halfSize *= (float)sqrt((double)rockCount / ROCKS_PER_SCREEN);
+   Point topLeft(-halfSize, halfSize);
+   Point bottomRight(halfSize, -halfSize);
+
+   Random random(SEED);
+   Game game(topLeft, bottomRight, 0, MAX_BULLETS, SEED);
+   for (int i = 0; i < rockCount; i++)
+   {
+      int roll = random.getInt(0, PERCENT);
+      EntityType type = roll < 34 ? ENTITY_BIG_ROCK :
+         roll < 67 ? ENTITY_MEDIUM_ROCK : ENTITY_SMALL_ROCK;
+      Point point(random.getFloat(-halfSize, halfSize),
+         random.getFloat(-halfSize, halfSize));
+      Velocity velocity(random.getFloat(-1, 1), random.getFloat(-1, 1));
+      game.addRock(type, point, velocity);
+   }
+
+   RewindBuffer rewind(REWIND_TICKS);
+   vector<double> frameTimes;
+   vector<double> recordTimes;
+   for (int tick = 0; tick < 2 * REWIND_TICKS; tick++)
+   {
+      GameInput input = randomInput(random);
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      rewind.record(game, input);
+      double recordTime = secondsSince(start);
+
+      start = chrono::steady_clock::now();
+      game.advance();
+      game.handleInput(input);
+      double frameTime = secondsSince(start);
+
+      if (tick >= REWIND_TICKS)
+      {
+         recordTimes.push_back(recordTime);
+         frameTimes.push_back(frameTime);
+      }
+   }
+   vector<unsigned char> snapshot;
+   game.saveSnapshot(snapshot);
+   size_t memory = rewind.getMemoryUsed();
+
+   vector<double> stepTimes;
+   for (;;)
+   {
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      if (!rewind.stepBack(game))
+         break;
+      stepTimes.push_back(secondsSince(start));
+   }
+
+   printf("\n%6s %9s %10s %10s %8s %9s %10s %9s %9s\n", "rocks",
+      "frame us", "record us", "% frame", "max us", "snap KB", "memory MB",
+      "back us", "max us");
+   printf("%6d %9.2f %10.3f %10.2f %8.1f %9.1f %10.2f %9.2f %9.1f\n",
+      rockCount, median(frameTimes) * 1e6, mean(recordTimes) * 1e6,
+      PERCENT * mean(recordTimes) / mean(frameTimes),
+      *max_element(recordTimes.begin(), recordTimes.end()) * 1e6,
+      snapshot.size() / 1024.0, memory / (1024.0 * 1024.0),
+      mean(stepTimes) * 1e6,
+      *max_element(stepTimes.begin(), stepTimes.end()) * 1e6);
+}
+
+/*********************************
+ * Main checks rewinding and then
+ * times it
+ *********************************/
+int main(int argc, char ** argv)
+{
+   int rocks = (argc > 1) ? atoi(argv[1]) : DEFAULT_ROCKS;
+   if (rocks < 1)
+   {
+      fprintf(stderr, "benchRewind: rocks must be at least 1\n");
+      return 1;
+   }
+
+   if (!check())
+      return 1;
+
+   timeRewind(START_ROCK_COUNT);
+   timeRewind(rocks);
+   return 0;
+}
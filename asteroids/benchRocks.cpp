@@ -0,0 +1,225 @@
+/*****************************************************
+ * File: benchRocks.cpp
+ * Author: Matthew Burr
+ *
+ * Description: Measures advance, collision and
+ *  fragment throughput of table-driven rocks against
+ *  the virtual-function rock classes they replaced.
+ *  The virtual classes are kept here, frozen, as the
+ *  baseline.
+ ******************************************************/
+#include "rocks.h"
+#include "collision.h"
+#include "point.h"
+#include "velocity.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#define BENCH_ROCKS 100000
+#define BENCH_FRAMES 50
+#define BENCH_SEED 1
+#define BULLET_RADIUS 5
+#define MAX_DEGREES 360
+using namespace std;
+
+/*****************************************
+* VIRTUAL ROCK
+* The Rock classes as they were, with each
+* kind's constants behind virtual functions
+*****************************************/
+class VirtualRock : public FlyingObject
+{
+public:
+   VirtualRock(const Point &in_point, float dx, float dy) : m_rotation(0)
+   {
+      setPoint(in_point);
+      setVelocity(Velocity(dx, dy));
+   }
+   virtual void advance()
+   {
+      FlyingObject::advance();
+      m_rotation = (m_rotation + getSpin()) % MAX_DEGREES;
+   }
+   virtual void draw() const {}
+   virtual int getSpin() const = 0;
+   virtual int getFragments(RockFragment * fragments) const = 0;
+
+protected:
+   void makeFragment(RockFragment &fragment, EntityType type,
+      float dx, float dy) const
+   {
+      fragment.type = type;
+      fragment.point = getPoint();
+      fragment.velocity = Velocity(getVelocity().getDx() + dx,
+         getVelocity().getDy() + dy);
+   }
+
+private:
+   int m_rotation;
+};
+
+class VirtualBigRock : public VirtualRock
+{
+public:
+   VirtualBigRock(const Point &in_point, float dx, float dy)
+      : VirtualRock(in_point, dx, dy) {}
+   virtual float getRadius() const { return BIG_ROCK_SIZE; }
+   virtual int getSpin() const { return BIG_ROCK_SPIN; }
+   virtual int getFragments(RockFragment * fragments) const
+   {
+      makeFragment(fragments[0], ENTITY_MEDIUM_ROCK, 0, 1);
+      makeFragment(fragments[1], ENTITY_MEDIUM_ROCK, 0, -1);
+      makeFragment(fragments[2], ENTITY_SMALL_ROCK, 2, 0);
+      return 3;
+   }
+};
+
+class VirtualMediumRock : public VirtualRock
+{
+public:
+   VirtualMediumRock(const Point &in_point, float dx, float dy)
+      : VirtualRock(in_point, dx, dy) {}
+   virtual float getRadius() const { return MEDIUM_ROCK_SIZE; }
+   virtual int getSpin() const { return MEDIUM_ROCK_SPIN; }
+   virtual int getFragments(RockFragment * fragments) const
+   {
+      makeFragment(fragments[0], ENTITY_SMALL_ROCK, 3, 0);
+      makeFragment(fragments[1], ENTITY_SMALL_ROCK, -3, 0);
+      return 2;
+   }
+};
+
+class VirtualSmallRock : public VirtualRock
+{
+public:
+   VirtualSmallRock(const Point &in_point, float dx, float dy)
+      : VirtualRock(in_point, dx, dy) {}
+   virtual float getRadius() const { return SMALL_ROCK_SIZE; }
+   virtual int getSpin() const { return SMALL_ROCK_SPIN; }
+   virtual int getFragments(RockFragment * fragments) const { return 0; }
+};
+
+/*************************************
+ * RANDOM FLOAT
+ * A random float between min and max
+ **************************************/
+float randomFloat(float min, float max)
+{
+   return min + (float)rand() / (float)RAND_MAX * (max - min);
+}
+
+/*************************************
+ * ELAPSED NS
+ * Nanoseconds since a start time
+ **************************************/
+double elapsedNs(chrono::steady_clock::time_point start)
+{
+   chrono::duration<double, nano> elapsed = chrono::steady_clock::now() - start;
+   return elapsed.count();
+}
+
+/*************************************
+ * PRINT ROW
+ * One line of the results table
+ **************************************/
+void printRow(const char * phase, double before, double after)
+{
+   printf("%10s %12.2f %12.2f %7.2fx\n", phase, before, after, before / after);
+}
+
+/*********************************
+ * Main builds the same mixed rock
+ * field both ways and runs each
+ * phase over it
+ *********************************/
+int main(int argc, char ** argv)
+{
+   Point topLeft(-200, 200);
+   Point bottomRight(200, -200);
+   srand(BENCH_SEED);
+
+   vector<VirtualRock *> virtualRocks;
+   vector<Rock> tableRocks;
+   tableRocks.reserve(BENCH_ROCKS);
+
+   for (int i = 0; i < BENCH_ROCKS; i++)
+   {
+      Point point(randomFloat(-200, 200), randomFloat(-200, 200));
+      float dx = randomFloat(-3, 3);
+      float dy = randomFloat(-3, 3);
+      EntityType type = (EntityType)(rand() % ROCK_KINDS);
+
+      if (type == ENTITY_BIG_ROCK)
+         virtualRocks.push_back(new VirtualBigRock(point, dx, dy));
+      else if (type == ENTITY_MEDIUM_ROCK)
+         virtualRocks.push_back(new VirtualMediumRock(point, dx, dy));
+      else
+         virtualRocks.push_back(new VirtualSmallRock(point, dx, dy));
+      virtualRocks.back()->setBoundaries(topLeft, bottomRight);
+
+      tableRocks.push_back(Rock(type, point, dx, dy));
+      tableRocks.back().setBoundaries(topLeft, bottomRight);
+   }
+
+   Point bullet(0, 0);
+   Velocity bulletVelocity(5, 0);
+   RockFragment fragments[MAX_ROCK_FRAGMENTS];
+   int sink = 0;
+
+   printf("%10s %12s %12s %8s\n", "ns/rock", "virtual", "table", "speedup");
+
+   // Advance
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   for (int frame = 0; frame < BENCH_FRAMES; frame++)
+      for (int i = 0; i < BENCH_ROCKS; i++)
+         virtualRocks[i]->advance();
+   double before = elapsedNs(start) / BENCH_FRAMES / BENCH_ROCKS;
+
+   start = chrono::steady_clock::now();
+   for (int frame = 0; frame < BENCH_FRAMES; frame++)
+      for (int i = 0; i < BENCH_ROCKS; i++)
+         tableRocks[i].Rock::advance();
+   double after = elapsedNs(start) / BENCH_FRAMES / BENCH_ROCKS;
+   printRow("advance", before, after);
+
+   // Collision against a bullet
+   start = chrono::steady_clock::now();
+   for (int frame = 0; frame < BENCH_FRAMES; frame++)
+      for (int i = 0; i < BENCH_ROCKS; i++)
+         sink += isSweptCollision(bullet, bulletVelocity,
+            virtualRocks[i]->getPoint(), virtualRocks[i]->getVelocity(),
+            BULLET_RADIUS + virtualRocks[i]->getRadius());
+   before = elapsedNs(start) / BENCH_FRAMES / BENCH_ROCKS;
+
+   start = chrono::steady_clock::now();
+   for (int frame = 0; frame < BENCH_FRAMES; frame++)
+      for (int i = 0; i < BENCH_ROCKS; i++)
+         sink += isSweptCollision(bullet, bulletVelocity,
+            tableRocks[i].getPoint(), tableRocks[i].getVelocity(),
+            BULLET_RADIUS + getRockRadius(tableRocks[i].getType()));
+   after = elapsedNs(start) / BENCH_FRAMES / BENCH_ROCKS;
+   printRow("collision", before, after);
+
+   // Fragments
+   start = chrono::steady_clock::now();
+   for (int frame = 0; frame < BENCH_FRAMES; frame++)
+      for (int i = 0; i < BENCH_ROCKS; i++)
+         sink += virtualRocks[i]->getFragments(fragments);
+   before = elapsedNs(start) / BENCH_FRAMES / BENCH_ROCKS;
+
+   start = chrono::steady_clock::now();
+   for (int frame = 0; frame < BENCH_FRAMES; frame++)
+      for (int i = 0; i < BENCH_ROCKS; i++)
+         sink += getRockFragments(tableRocks[i].getType(),
+            tableRocks[i].getPoint(), tableRocks[i].getVelocity(), fragments);
+   after = elapsedNs(start) / BENCH_FRAMES / BENCH_ROCKS;
+   printRow("fragments", before, after);
+
+   for (int i = 0; i < BENCH_ROCKS; i++)
+      delete virtualRocks[i];
+
+   // Keep the optimizer from throwing the work away
+   return sink == -1;
+}
@@ -0,0 +1,258 @@
+/*****************************************************
+ * File: benchSeek.cpp
+ * Author: Matthew Burr
+ *
+ * Description: Plays an hour-long session into a
+ *  replay file with keyframes, checks that seeking
+ *  to a tick gives exactly the game playing to it
+ *  gave, then times opening the file and seeking
+ *  near its end against playing from the start.
+ *
+ *  Usage: benchSeek [minutes] [session.replay]
+ *
+ *  The file is written to the working directory
+ *  unless named, and removed afterwards.
+ ******************************************************/
+#include "game.h"
+#include "gameInput.h"
+#include "replayFile.h"
+#include "random.h"
+#include "point.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#define DEFAULT_MINUTES 60
+#define DEFAULT_FILE_NAME "benchSeek.replay"
+#define TICKS_PER_MINUTE (30 * 60)   // as the game plays
+#define SEEK_MINUTE 55
+#define CHECK_SEEKS 50
+#define TIMING_RUNS 5
+#define SEED 1
+
+// How often, out of 1000 a tick, the player lets go of or presses
+// each key, as in benchReplay
+#define TURN_CHANGE 40
+#define THRUST_CHANGE 20
+#define FIRE_CHANGE 150
+using namespace std;
+
+/*************************************
+ * PLAYER INPUT
+ * The keys held now, most often the
+ * same as a tick ago
+ **************************************/
+GameInput playerInput(Random &player, const GameInput &last)
+{
+   GameInput input = last;
+   if (player.getInt(0, 1000) < TURN_CHANGE)
+   {
+      int turn = player.getInt(0, 3);
+      input.left = (turn == 1);
+      input.right = (turn == 2);
+   }
+   if (player.getInt(0, 1000) < THRUST_CHANGE)
+      input.up = !input.up;
+   if (player.getInt(0, 1000) < FIRE_CHANGE)
+      input.fire = !input.fire;
+   return input;
+}
+
+/*************************************
+ * SECONDS SINCE
+ **************************************/
+double secondsSince(chrono::steady_clock::time_point start)
+{
+   return chrono::duration<double>(chrono::steady_clock::now() -
+      start).count();
+}
+
+/*************************************
+ * CHECK
+ * Seeks to the edges of the segments
+ * and to ticks at random, and checks
+ * each against the hash the game had
+ * there, then reads back every tick's
+ * keys. Returns false on any mismatch.
+ **************************************/
+bool check(const ReplayReader &reader,
+   const vector<unsigned long long> &hashes,
+   const vector<unsigned char> &keys, const vector<unsigned char> &last)
+{
+   long long ticks = reader.getTickCount();
+   int interval = reader.getInterval();
+   vector<long long> seeks;
+   seeks.push_back(0);
+   seeks.push_back(1);
+   seeks.push_back(interval - 1);
+   seeks.push_back(interval);
+   seeks.push_back(interval + 1);
+   seeks.push_back(ticks - 1);
+   seeks.push_back(ticks);
+   Random random(SEED);
+   for (int i = 0; i < CHECK_SEEKS; i++)
+      seeks.push_back(random.getInt(0, (int)ticks + 1));
+
+   Point topLeft(-200, 200);
+   Point bottomRight(200, -200);
+   Game game(topLeft, bottomRight, 0);
+   for (size_t i = 0; i < seeks.size(); i++)
+   {
+      long long tick = min(max(seeks[i], 0LL), ticks);
+      if (!reader.seek(game, tick) || game.getStateHash() != hashes[tick])
+      {
+         printf("seeking to tick %lld gave a different game\n", tick);
+         return false;
+      }
+   }
+
+   vector<unsigned char> snapshot;
+   reader.seek(game, ticks);
+   game.saveSnapshot(snapshot);
+   if (snapshot != last)
+   {
+      printf("seeking to the end gave a different game\n");
+      return false;
+   }
+
+   for (long long tick = 0; tick < ticks; tick++)
+   {
+      GameInput input;
+      if (!reader.getInput(tick, input) || packInput(input) != keys[tick])
+      {
+         printf("tick %lld read back different keys\n", tick);
+         return false;
+      }
+   }
+
+   if (reader.seek(game, ticks + 1) || reader.seek(game, -1))
+   {
+      printf("seeking outside the replay didn't fail\n");
+      return false;
+   }
+
+   printf("%d seeks matched the game played through, and all %lld "
+      "ticks' keys\n", (int)seeks.size(), ticks);
+   return true;
+}
+
+/*********************************
+ * Main records, checks and times
+ *********************************/
+int main(int argc, char ** argv)
+{
+   int minutes = (argc > 1) ? atoi(argv[1]) : DEFAULT_MINUTES;
+   const char * fileName = (argc > 2) ? argv[2] : DEFAULT_FILE_NAME;
+   if (minutes < 1)
+   {
+      fprintf(stderr, "benchSeek: minutes must be at least 1\n");
+      return 1;
+   }
+
+   Point topLeft(-200, 200);
+   Point bottomRight(200, -200);
+   Random player(SEED);
+   unsigned long long seed = player.next();
+
+   // Play and write the replay, keeping the hash after every tick
+   Game live(topLeft, bottomRight, START_ROCK_COUNT, MAX_BULLETS, seed);
+   ReplayWriter writer;
+   if (!writer.open(fileName, seed, START_ROCK_COUNT))
+   {
+      fprintf(stderr, "benchSeek: can't write %s\n", fileName);
+      return 1;
+   }
+   int ticks = minutes * TICKS_PER_MINUTE;
+   vector<unsigned long long> hashes(1, live.getStateHash());
+   vector<unsigned char> keys;
+   GameInput input = { false, false, false, false };
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   for (int tick = 0; tick < ticks; tick++)
+   {
+      input = playerInput(player, input);
+      writer.addTick(live, input);
+      live.advance();
+      live.handleInput(input);
+      hashes.push_back(live.getStateHash());
+      keys.push_back(packInput(input));
+   }
+   double writeSeconds = secondsSince(start);
+   if (!writer.close())
+   {
+      fprintf(stderr, "benchSeek: can't write %s\n", fileName);
+      remove(fileName);
+      return 1;
+   }
+   vector<unsigned char> last;
+   live.saveSnapshot(last);
+
+   ReplayReader reader;
+   start = chrono::steady_clock::now();
+   bool isOpen = reader.open(fileName);
+   double openSeconds = secondsSince(start);
+   if (!isOpen || reader.getTickCount() != ticks)
+   {
+      printf("the replay didn't read back\n");
+      remove(fileName);
+      return 1;
+   }
+   FILE *file = fopen(fileName, "rb");
+   fseek(file, 0, SEEK_END);
+   long bytes = ftell(file);
+   fclose(file);
+
+   if (!check(reader, hashes, keys, last))
+   {
+      reader.close();
+      remove(fileName);
+      return 1;
+   }
+
+   // The target is as far past a keyframe as a seek can land
+   long long target = min((long long)SEEK_MINUTE * TICKS_PER_MINUTE,
+      (long long)ticks);
+   target = min(target / reader.getInterval() * reader.getInterval() +
+      reader.getInterval() - 1, (long long)ticks);
+
+   double seekSeconds = 0;
+   double playSeconds = 0;
+   Game game(topLeft, bottomRight, 0);
+   for (int run = 0; run < TIMING_RUNS; run++)
+   {
+      start = chrono::steady_clock::now();
+      reader.seek(game, target);
+      double seconds = secondsSince(start);
+      seekSeconds = (run == 0) ? seconds : min(seekSeconds, seconds);
+
+      start = chrono::steady_clock::now();
+      Game played(topLeft, bottomRight, START_ROCK_COUNT, MAX_BULLETS, seed);
+      for (long long tick = 0; tick < target; tick++)
+      {
+         played.advance();
+         played.handleInput(unpackInput(keys[tick]));
+      }
+      seconds = secondsSince(start);
+      playSeconds = (run == 0) ? seconds : min(playSeconds, seconds);
+
+      if (played.getStateHash() != game.getStateHash())
+      {
+         printf("seeking and playing to tick %lld disagree\n", target);
+         reader.close();
+         remove(fileName);
+         return 1;
+      }
+   }
+   int keyframes = reader.getKeyframeCount();
+   reader.close();
+   remove(fileName);
+
+   printf("\n%7s %7s %9s %9s %8s %8s %9s %9s %8s\n", "minutes", "ticks",
+      "keyframes", "bytes", "write s", "open ms", "to tick", "seek ms",
+      "play ms");
+   printf("%7d %7d %9d %9ld %8.3f %8.3f %9lld %9.3f %8.1f\n", minutes, ticks,
+      keyframes, bytes, writeSeconds, openSeconds * 1e3,
+      target, seekSeconds * 1e3, playSeconds * 1e3);
+   return 0;
+}
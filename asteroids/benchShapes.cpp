@@ -0,0 +1,176 @@
+/*****************************************************
+ * File: benchShapes.cpp
+ * Author: Matthew Burr
+ *
+ * Description: Works out the vertices of the large
+ *  rock and ship outlines two ways, with rotate() as
+ *  uiDraw.cpp used to and from the rotated shape
+ *  cache, checks they land on the same pixels and
+ *  times each.
+ *
+ *  Usage: benchShapes [draws]
+ ******************************************************/
+#include "rotatedShape.h"
+#include "shapeOutlines.h"
+#include "uiDraw.h"
+#include "point.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#define DEFAULT_DRAWS 1000000
+#define CENTERS 64
+
+// the ship is drawn at its rotation less 90, so it can be off the
+// ends of 0..359 either way
+#define LOWEST_ROTATION -450
+#define HIGHEST_ROTATION 450
+using namespace std;
+
+/*****************************************
+* SHAPE
+* An outline to try
+*****************************************/
+struct Shape
+{
+   const char * name;
+   const ShapePoint * points;
+   int count;
+};
+
+/*************************************
+ * ROTATE VERTEX
+ * Where a vertex used to be drawn
+ **************************************/
+inline Point rotateVertex(const Point &center, const ShapePoint &point,
+   int rotation)
+{
+   Point pt(center.getX() + point.x, center.getY() + point.y);
+   rotate(pt, center, rotation);
+   return pt;
+}
+
+/*************************************
+ * CHECK
+ * Counts the vertices the cache puts
+ * somewhere rotate() doesn't
+ **************************************/
+long long check(const Shape &shape, const RotatedShape &cache,
+   const vector<Point> &centers, long long &vertices)
+{
+   long long different = 0;
+   for (size_t c = 0; c < centers.size(); c++)
+      for (int rotation = LOWEST_ROTATION; rotation < HIGHEST_ROTATION;
+           rotation++)
+      {
+         const ShapePoint *outline = cache.getOutline(rotation);
+         for (int i = 0; i < shape.count; i++)
+         {
+            Point expected = rotateVertex(centers[c], shape.points[i],
+               rotation);
+            if (centers[c].getX() + outline[i].x != expected.getX() ||
+                centers[c].getY() + outline[i].y != expected.getY())
+               different++;
+            vertices++;
+         }
+      }
+
+   return different;
+}
+
+/*************************************
+ * TIME ROTATE
+ * Seconds to work out a shape's
+ * vertices draws times with rotate()
+ **************************************/
+double timeRotate(const Shape &shape, const vector<Point> &centers,
+   int draws, float &sink)
+{
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   for (int d = 0; d < draws; d++)
+   {
+      const Point &center = centers[d % centers.size()];
+      for (int i = 0; i < shape.count; i++)
+      {
+         Point pt = rotateVertex(center, shape.points[i], d % 360);
+         sink += pt.getX() + pt.getY();
+      }
+   }
+   return chrono::duration<double>(chrono::steady_clock::now() - start)
+      .count();
+}
+
+/*************************************
+ * TIME CACHE
+ * Seconds to do the same from the
+ * cache
+ **************************************/
+double timeCache(const RotatedShape &cache, const vector<Point> &centers,
+   int draws, float &sink)
+{
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   for (int d = 0; d < draws; d++)
+   {
+      const Point &center = centers[d % centers.size()];
+      const ShapePoint *outline = cache.getOutline(d % 360);
+      for (int i = 0; i < cache.getCount(); i++)
+         sink += (center.getX() + outline[i].x) +
+                 (center.getY() + outline[i].y);
+   }
+   return chrono::duration<double>(chrono::steady_clock::now() - start)
+      .count();
+}
+
+/*********************************
+ * Main checks and times each shape
+ *********************************/
+int main(int argc, char ** argv)
+{
+   int draws = (argc > 1) ? atoi(argv[1]) : DEFAULT_DRAWS;
+   if (draws < 1)
+   {
+      fprintf(stderr, "benchShapes: draws must be at least 1\n");
+      return 1;
+   }
+
+   // rocks and the ship sit at all sorts of fractional positions
+   vector<Point> centers;
+   srand(1);
+   for (int c = 0; c < CENTERS; c++)
+      centers.push_back(Point(rand() % 400 - 200 + rand() / (float)RAND_MAX,
+                              rand() % 400 - 200 + rand() / (float)RAND_MAX));
+
+   const Shape shapes[] = {
+      { "large rock", LARGE_ROCK_OUTLINE, SHAPE_COUNT(LARGE_ROCK_OUTLINE) },
+      { "ship",       SHIP_OUTLINE,       SHAPE_COUNT(SHIP_OUTLINE) },
+   };
+
+   printf("%-12s %9s %9s %12s %12s %8s\n", "shape", "vertices", "moved",
+      "rotate ns", "cache ns", "speedup");
+
+   float sink = 0;
+   for (size_t s = 0; s < sizeof(shapes) / sizeof(shapes[0]); s++)
+   {
+      const Shape &shape = shapes[s];
+      RotatedShape cache(shape.points, shape.count);
+
+      long long vertices = 0;
+      long long different = check(shape, cache, centers, vertices);
+
+      double rotateSeconds = timeRotate(shape, centers, draws, sink);
+      double cacheSeconds = timeCache(cache, centers, draws, sink);
+      double perVertex = 1e9 / ((double)draws * shape.count);
+
+      printf("%-12s %9lld %9lld %12.2f %12.2f %7.1fx\n", shape.name,
+         vertices, different, rotateSeconds * perVertex,
+         cacheSeconds * perVertex, rotateSeconds / cacheSeconds);
+   }
+
+   // keeps the timed loops from being optimized away
+   if (sink == 0.12345f)
+      printf("\n");
+
+   return 0;
+}
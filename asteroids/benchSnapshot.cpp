@@ -0,0 +1,178 @@
+/*****************************************************
+ * File: benchSnapshot.cpp
+ * Author: Matthew Burr
+ *
+ * Description: Times saving and restoring a busy
+ *  game, then checks that a game restored from a
+ *  snapshot plays on exactly as the one it was taken
+ *  of and that damaged snapshots are turned away.
+ *
+ *  Usage: benchSnapshot [rocks] [repeats]
+ ******************************************************/
+#include "game.h"
+#include "gameInput.h"
+#include "snapshot.h"
+#include "rocks.h"
+#include "random.h"
+#include "point.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#define DEFAULT_ROCKS 400
+#define DEFAULT_REPEATS 10000
+#define WARM_UP_FRAMES 60     // to break rocks up and fill the sky
+#define CHECK_FRAMES 500
+#define SEED 1
+
+// As the bullet ring saves each bullet, to find the rocks' end
+#define SNAPSHOT_BULLET_SIZE (5 * sizeof(float) + sizeof(int) + 1)
+
+// How often the input presses each key, out of 100
+#define TURN_CHANCE 20
+#define THRUST_CHANCE 10
+#define FIRE_CHANCE 90
+using namespace std;
+
+/*************************************
+ * RANDOM INPUT
+ * A random set of keys, firing most
+ * frames
+ **************************************/
+GameInput randomInput(Random &bot)
+{
+   GameInput input;
+   input.left = bot.getInt(0, 100) < TURN_CHANCE;
+   input.right = !input.left && bot.getInt(0, 100) < TURN_CHANCE;
+   input.up = bot.getInt(0, 100) < THRUST_CHANCE;
+   input.fire = bot.getInt(0, 100) < FIRE_CHANCE;
+   return input;
+}
+
+/*************************************
+ * CHECK
+ * Forks a game and plays both on with
+ * the same keys. Returns false if they
+ * ever differ or a bad snapshot is
+ * taken.
+ **************************************/
+bool check(Game &game, Random &bot)
+{
+   Point topLeft(-200, 200);
+   Point bottomRight(200, -200);
+   vector<unsigned char> snapshot;
+   vector<unsigned char> forkSnapshot;
+
+   game.saveSnapshot(snapshot);
+   Game fork(topLeft, bottomRight, START_ROCK_COUNT, MAX_BULLETS, SEED + 1);
+   if (!fork.restoreSnapshot(&snapshot[0], snapshot.size()))
+   {
+      printf("a good snapshot was turned away\n");
+      return false;
+   }
+
+   for (int frame = 0; frame < CHECK_FRAMES; frame++)
+   {
+      GameInput input = randomInput(bot);
+      game.handleInput(input);
+      game.advance();
+      fork.handleInput(input);
+      fork.advance();
+
+      game.saveSnapshot(snapshot);
+      fork.saveSnapshot(forkSnapshot);
+      if (snapshot != forkSnapshot)
+      {
+         printf("the fork went its own way on frame %d\n", frame);
+         return false;
+      }
+   }
+
+   // Cut short, a different version, or one byte too many
+   vector<unsigned char> bad(snapshot.begin(), snapshot.end() - 1);
+   bool isTurnedAway = !fork.restoreSnapshot(&bad[0], bad.size());
+   bad = snapshot;
+   bad[4]++;
+   isTurnedAway = isTurnedAway && !fork.restoreSnapshot(&bad[0], bad.size());
+   bad = snapshot;
+   bad.push_back(0);
+   isTurnedAway = isTurnedAway && !fork.restoreSnapshot(&bad[0], bad.size());
+
+   // Damaged inside, after the rocks have read: more bullets than the
+   // ring holds, or a last rock of no kind there is
+   size_t bullets = sizeof(int) +
+      game.getBullets().size() * SNAPSHOT_BULLET_SIZE;
+   bad = snapshot;
+   int tooMany = game.getBullets().getCapacity() + 1;
+   memcpy(&bad[bad.size() - bullets], &tooMany, sizeof(tooMany));
+   isTurnedAway = isTurnedAway && !fork.restoreSnapshot(&bad[0], bad.size());
+   if (game.getRocks().size() > 0)
+   {
+      bad = snapshot;
+      bad[bad.size() - bullets - 1] = ROCK_KINDS;
+      isTurnedAway = isTurnedAway &&
+         !fork.restoreSnapshot(&bad[0], bad.size());
+   }
+
+   fork.saveSnapshot(forkSnapshot);
+   if (!isTurnedAway || snapshot != forkSnapshot)
+   {
+      printf("a bad snapshot was let in\n");
+      return false;
+   }
+
+   return true;
+}
+
+/*********************************
+ * Main times saving and restoring,
+ * then checks
+ *********************************/
+int main(int argc, char ** argv)
+{
+   int rocks = (argc > 1) ? atoi(argv[1]) : DEFAULT_ROCKS;
+   int repeats = (argc > 2) ? atoi(argv[2]) : DEFAULT_REPEATS;
+   if (rocks < 0 || repeats < 1)
+   {
+      fprintf(stderr, "benchSnapshot: repeats must be at least 1\n");
+      return 1;
+   }
+
+   Point topLeft(-200, 200);
+   Point bottomRight(200, -200);
+   Random bot(SEED);
+   Game game(topLeft, bottomRight, rocks, MAX_BULLETS, bot.next());
+   for (int frame = 0; frame < WARM_UP_FRAMES; frame++)
+   {
+      game.handleInput(randomInput(bot));
+      game.advance();
+   }
+
+   vector<unsigned char> snapshot;
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   for (int i = 0; i < repeats; i++)
+      game.saveSnapshot(snapshot);
+   double saveSeconds = chrono::duration<double>(
+      chrono::steady_clock::now() - start).count();
+
+   Game copy(topLeft, bottomRight, rocks, MAX_BULLETS, SEED);
+   start = chrono::steady_clock::now();
+   for (int i = 0; i < repeats; i++)
+      copy.restoreSnapshot(&snapshot[0], snapshot.size());
+   double restoreSeconds = chrono::duration<double>(
+      chrono::steady_clock::now() - start).count();
+
+   printf("%6s %8s %8s %10s %10s\n", "rocks", "bullets", "bytes",
+      "save us", "restore us");
+   printf("%6d %8d %8d %10.2f %10.2f\n", game.getRockCount(),
+      game.getBulletCount(), (int)snapshot.size(),
+      saveSeconds / repeats * 1e6, restoreSeconds / repeats * 1e6);
+
+   if (!check(game, bot))
+      return 1;
+   printf("checks passed\n");
+
+   return 0;
+}
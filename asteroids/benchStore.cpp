@@ -0,0 +1,218 @@
+/*****************************************************
+ * File: benchStore.cpp
+ * Author: Matthew Burr
+ *
+ * Description: Compares the frame time of the Game,
+ *  which keeps its rocks in an EntityStore, against
+ *  the std::list<Rock*> layout it used to have. The
+ *  list layout is kept here as the baseline, and is
+ *  kept using the same rocks and the same collision
+ *  test as the Game, so only the layout differs.
+ ******************************************************/
+#include "game.h"
+#include "rocks.h"
+#include "ship.h"
+#include "random.h"
+#include "collision.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+
+#define BENCH_FRAMES 100
+#define BENCH_SEED 1
+#define INVULNERABILITY_TIME 100
+using namespace std;
+
+const int ROCK_COUNTS[] = { 1000, 10000, 100000 };
+
+/*****************************************
+* LIST GAME
+* The rock, ship and collision handling of
+* Game as it was with a list of heap rocks
+*****************************************/
+class ListGame
+{
+public:
+   ListGame(const Point &tl, const Point &br, int rockCount)
+      : m_topLeft(tl), m_bottomRight(br)
+   {
+      for (int i = 0; i < rockCount; i++)
+      {
+         float x = random(tl.getX(), br.getX());
+         float y = random(br.getY(), tl.getY());
+         float angle = random(0, 360);
+         m_rocks.push_back(new BigRock(Point(x, y), angle));
+         m_rocks.back()->setBoundaries(tl, br);
+      }
+      m_ship.setBoundaries(tl, br);
+      m_ship.setInvulnerable(INVULNERABILITY_TIME);
+   }
+
+   ~ListGame()
+   {
+      for (list<Rock*>::iterator it = m_rocks.begin();
+         it != m_rocks.end(); ++it)
+         delete *it;
+   }
+
+   void advance()
+   {
+      for (list<Rock*>::iterator it = m_rocks.begin();
+         it != m_rocks.end(); ++it)
+         (*it)->advance();
+
+      if (m_ship.isAlive())
+         m_ship.advance();
+      else
+      {
+         m_ship = Ship();
+         m_ship.setBoundaries(m_topLeft, m_bottomRight);
+         m_ship.setInvulnerable(INVULNERABILITY_TIME);
+      }
+
+      handleCollisions(m_ship);
+
+      list<Rock*>::iterator it = m_rocks.begin();
+      while (it != m_rocks.end())
+      {
+         if ((*it)->isAlive())
+            ++it;
+         else
+         {
+            delete *it;
+            it = m_rocks.erase(it);
+         }
+      }
+   }
+
+   int getRockCount() const { return (int)m_rocks.size(); }
+
+private:
+   Point m_topLeft;
+   Point m_bottomRight;
+   list<Rock*> m_rocks;
+   Ship m_ship;
+
+   void handleCollisions(FlyingObject &obj)
+   {
+      for (list<Rock*>::iterator it = m_rocks.begin();
+         it != m_rocks.end(); ++it)
+      {
+         if (isSweptCollision(obj.getPoint(), obj.getVelocity(),
+            (*it)->getPoint(), (*it)->getVelocity(),
+            obj.getRadius() + (*it)->getRadius()))
+         {
+            obj.kill();
+            RockFragment frags[MAX_ROCK_FRAGMENTS];
+            int fragCount = (*it)->hit(frags);
+            for (int i = 0; i < fragCount; i++)
+            {
+               Rock * fragment = createRock(frags[i]);
+               fragment->setBoundaries(m_topLeft, m_bottomRight);
+               m_rocks.insert(it, fragment);
+            }
+            return;
+         }
+      }
+   }
+
+   static Rock * createRock(const RockFragment &frag)
+   {
+      float dx = frag.velocity.getDx();
+      float dy = frag.velocity.getDy();
+      if (frag.type == ENTITY_MEDIUM_ROCK)
+         return new MediumRock(frag.point, dx, dy);
+      if (frag.type == ENTITY_SMALL_ROCK)
+         return new SmallRock(frag.point, dx, dy);
+      return new BigRock(frag.point, dx, dy);
+   }
+};
+
+/*************************************
+ * TIME FRAMES
+ * Runs a number of frames of a game and
+ * returns the mean time per frame in
+ * microseconds
+ **************************************/
+template <class T>
+double timeFrames(T &game)
+{
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+   for (int frame = 0; frame < BENCH_FRAMES; frame++)
+      game.advance();
+
+   chrono::duration<double, micro> elapsed =
+      chrono::steady_clock::now() - start;
+   return elapsed.count() / BENCH_FRAMES;
+}
+
+/*************************************
+ * REPORT STORE
+ * How full a store or ring is, has
+ * been, and can be, and whether it had
+ * to grow again after the timed frames
+ **************************************/
+template <class Store>
+void reportStore(int rockCount, const char * name, const Store &store,
+   int settledCapacity)
+{
+   printf("%8d %8s %8d %10d %8d %8s\n", rockCount, name,
+      store.getLiveCount(), store.getHighWater(), store.getCapacity(),
+      store.getCapacity() == settledCapacity ? "no" : "yes");
+}
+
+/*********************************
+ * Main runs each rock count against
+ * both layouts and prints a table
+ *********************************/
+int main(int argc, char ** argv)
+{
+   Point topLeft(-200, 200);
+   Point bottomRight(200, -200);
+
+   printf("%8s %14s %14s %8s\n", "rocks", "list us/frame", "store us/frame",
+      "speedup");
+
+   const int sceneCount = sizeof(ROCK_COUNTS) / sizeof(ROCK_COUNTS[0]);
+   Game * storeGames[sceneCount];
+   for (int i = 0; i < sceneCount; i++)
+   {
+      int rockCount = ROCK_COUNTS[i];
+
+      seedRandom(BENCH_SEED);
+      ListGame listGame(topLeft, bottomRight, rockCount);
+      double listTime = timeFrames(listGame);
+
+      // Both layouts test the ship against every rock with the same
+      // swept test, so only the layout differs
+      seedRandom(BENCH_SEED);
+      storeGames[i] = new Game(topLeft, bottomRight, rockCount);
+      Game &storeGame = *storeGames[i];
+      storeGame.setBroadPhase(BROAD_PHASE_BRUTE_FORCE);
+      double storeTime = timeFrames(storeGame);
+
+      printf("%8d %14.1f %14.1f %7.2fx\n", rockCount, listTime, storeTime,
+         listTime / storeTime);
+   }
+
+   // The store's arrays are its pool: once a scene has settled, playing
+   // on must not make them grow
+   printf("\n%8s %8s %8s %10s %8s %8s\n", "rocks", "store", "live",
+      "high water", "capacity", "regrew");
+   for (int i = 0; i < sceneCount; i++)
+   {
+      Game &storeGame = *storeGames[i];
+      int rockCapacity = storeGame.getRocks().getCapacity();
+      int bulletCapacity = storeGame.getBullets().getCapacity();
+      timeFrames(storeGame);
+      reportStore(ROCK_COUNTS[i], "rocks", storeGame.getRocks(),
+         rockCapacity);
+      reportStore(ROCK_COUNTS[i], "bullets", storeGame.getBullets(),
+         bulletCapacity);
+      delete storeGames[i];
+   }
+
+   return 0;
+}
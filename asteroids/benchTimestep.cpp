@@ -0,0 +1,129 @@
+/*****************************************************
+ * File: benchTimestep.cpp
+ * Author: Matthew Burr
+ *
+ * Description: Feeds the fixed timestep the frame
+ *  times of a few display rates, smooth and with
+ *  hitches, and checks the game still gets the same
+ *  number of ticks a second. No real time passes;
+ *  the frame times are made up, so the results are
+ *  the same on every run.
+ *
+ *  Usage: benchTimestep [seconds]
+ ******************************************************/
+#include "fixedTimestep.h"
+#include <cstdio>
+#include <cstdlib>
+
+#define DEFAULT_SECONDS 10
+#define TICKS_PER_SECOND 30
+#define MAX_TICKS_PER_FRAME 5
+#define NANOSECONDS_PER_SECOND 1000000000LL
+
+// A hitch is one frame this many times as long as usual, every
+// HITCH_EVERY frames
+#define HITCH_LENGTH 4
+#define HITCH_EVERY 50
+#define STALL_SECONDS 2
+using namespace std;
+
+/*****************************************
+* DISPLAY
+* How frames arrive
+*****************************************/
+struct Display
+{
+   const char * name;
+   double framesPerSecond;
+   bool hasHitches;
+   bool hasStall;     // one long stall halfway through
+};
+
+/*************************************
+ * RUN
+ * Plays a display's frame times into
+ * a timestep and reports what it does.
+ * Returns false if the game runs at the
+ * wrong speed.
+ **************************************/
+bool run(const Display &display, int seconds)
+{
+   FixedTimestep timestep(TICKS_PER_SECOND, MAX_TICKS_PER_FRAME);
+   long long frameTime =
+      (long long)(NANOSECONDS_PER_SECOND / display.framesPerSecond);
+   long long end = seconds * NANOSECONDS_PER_SECOND;
+
+   long long now = 0;
+   long long ticks = 0;
+   int frames = 0;
+   int idleFrames = 0;
+   int mostTicks = 0;
+   bool hasStalled = false;
+
+   while (now < end)
+   {
+      long long elapsed = frameTime;
+      if (display.hasHitches && frames % HITCH_EVERY == HITCH_EVERY - 1)
+         elapsed *= HITCH_LENGTH;
+      if (display.hasStall && !hasStalled && now >= end / 2)
+      {
+         elapsed = STALL_SECONDS * NANOSECONDS_PER_SECOND;
+         hasStalled = true;
+      }
+
+      now += elapsed;
+      int frameTicks = timestep.addTime(elapsed);
+      ticks += frameTicks;
+      frames++;
+
+      if (frameTicks == 0)
+         idleFrames++;
+      if (frameTicks > mostTicks)
+         mostTicks = frameTicks;
+   }
+
+   // Everything the display saw but the game dropped or hasn't yet
+   // run should add up to the time that passed
+   long long expected = now / timestep.getTick();
+   long long accounted = ticks + timestep.getDroppedTicks();
+   bool isOk = accounted == expected || accounted == expected - 1;
+
+   printf("%-16s %7.1f %7d %7lld %7.2f %7d %7d %7lld  %s\n", display.name,
+      display.framesPerSecond, frames, ticks,
+      (double)ticks * NANOSECONDS_PER_SECOND / now, idleFrames, mostTicks,
+      timestep.getDroppedTicks(), isOk ? "ok" : "WRONG SPEED");
+
+   return isOk;
+}
+
+/*********************************
+ * Main tries every display
+ *********************************/
+int main(int argc, char ** argv)
+{
+   int seconds = (argc > 1) ? atoi(argv[1]) : DEFAULT_SECONDS;
+   if (seconds < 1)
+   {
+      fprintf(stderr, "benchTimestep: seconds must be at least 1\n");
+      return 1;
+   }
+
+   const Display displays[] = {
+      { "30 Hz",           30,  false, false },
+      { "60 Hz",           60,  false, false },
+      { "144 Hz",          144, false, false },
+      { "24 Hz",           24,  false, false },
+      { "60 Hz hitches",   60,  true,  false },
+      { "144 Hz hitches",  144, true,  false },
+      { "60 Hz stall",     60,  false, true },
+   };
+
+   printf("%-16s %7s %7s %7s %7s %7s %7s %7s\n", "display", "fps", "frames",
+      "ticks", "ticks/s", "idle", "most", "dropped");
+
+   bool isOk = true;
+   for (size_t i = 0; i < sizeof(displays) / sizeof(displays[0]); i++)
+      isOk = run(displays[i], seconds) && isOk;
+
+   return isOk ? 0 : 1;
+}
@@ -31,6 +31,7 @@ private:
 public:
    Bullet();
    virtual float getRadius() const { return 5; }
+   int getLife() const { return m_life; }
    void fire(const Point &in_point, float in_angle);
    virtual void advance();
    void draw() const;
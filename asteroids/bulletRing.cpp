@@ -0,0 +1,344 @@
+/*************************************************************
+* File: bulletRing.cpp
+* Author: Matthew Burr
+*
+* Description: Contains the implementations of the
+*  method bodies for the BulletRing class.
+*************************************************************/
+
+#include "bulletRing.h"
+#include "advanceKernel.h"
+#include "bullet.h"
+#include "point.h"
+#include "velocity.h"
+#include "snapshot.h"
+#include "stateHash.h"
+#include <algorithm>
+#include <cassert>
+
+// What a hit bullet's life is set to, so it is neither alive nor
+// still finishing its last frame
+#define TOMBSTONE_LIFE -1
+
+// Runs of slots are advanced in multiples of the widest kernel's lanes
+#define RUN_ALIGNMENT 8
+
+// What a bullet takes up in a snapshot
+#define SNAPSHOT_BULLET_SIZE (5 * sizeof(float) + sizeof(int) + 1)
+
+/**********************************************************************
+* Function: getPadded
+* Description: Rounds a run length up to a multiple of RUN_ALIGNMENT
+**********************************************************************/
+static inline int getPadded(int length)
+{
+   return (length + RUN_ALIGNMENT - 1) & ~(RUN_ALIGNMENT - 1);
+}
+
+/**********************************************************************
+* Method: BulletRing
+* Description: Creates a new, empty BulletRing with room for at least
+*  the given number of bullets
+**********************************************************************/
+BulletRing::BulletRing(int in_capacity)
+   : m_head(0), m_count(0), m_highWater(0), m_bodyHash(0), m_motionHash(0)
+{
+   assert(in_capacity > 0);
+
+   int capacity = 1;
+   while (capacity < in_capacity)
+      capacity *= 2;
+   m_mask = capacity - 1;
+
+   m_x.assign(capacity, 0);
+   m_y.assign(capacity, 0);
+   m_dx.assign(capacity, 0);
+   m_dy.assign(capacity, 0);
+   m_radius.assign(capacity, 0);
+   m_rotation.assign(capacity, 0);
+   m_spin.assign(capacity, 0);
+   m_life.assign(capacity, 0);
+   m_alive.assign(capacity, false);
+}
+
+/**********************************************************************
+* Method: add
+* Description: Puts a newly fired bullet on the tail of the ring. The
+*  ring must be sized so it never fills with bullets still flying; a
+*  tombstone at the head of a full ring makes way.
+**********************************************************************/
+void BulletRing::add(const Bullet &bullet)
+{
+   assert(m_count < getCapacity() || !m_alive[m_head]);
+   if (m_count == getCapacity())
+   {
+      m_bodyHash -= getBodyHash(m_head);
+      if (m_alive[m_head])
+         m_motionHash -= getMotionHash(m_head);
+      m_head = (m_head + 1) & m_mask;
+      m_count--;
+   }
+
+   int slot = getSlot(m_count);
+   m_x[slot] = bullet.getPoint().getX();
+   m_y[slot] = bullet.getPoint().getY();
+   m_dx[slot] = bullet.getVelocity().getDx();
+   m_dy[slot] = bullet.getVelocity().getDy();
+   m_radius[slot] = bullet.getRadius();
+   m_life[slot] = bullet.getLife();
+   m_alive[slot] = true;
+   m_count++;
+   if (m_count > m_highWater)
+      m_highWater = m_count;
+
+   m_bodyHash += getBodyHash(slot);
+   m_motionHash += getMotionHash(slot);
+}
+
+/**********************************************************************
+* Method: advance
+* Description: Moves, wraps and ages every bullet. The bullets occupy
+*  at most two runs of slots: from the head toward the end of the
+*  arrays, and, once they wrap, from the start of the arrays on. Each
+*  run is stretched over the unused slots after it to a whole number
+*  of vector widths, so the kernel rarely has to finish a slot at a
+*  time. Unused slots are never alive and never spin, so advancing
+*  them only moves them about.
+**********************************************************************/
+void BulletRing::advance(const Point &in_topLeft, const Point &in_bottomRight,
+   TaskPool * pool)
+{
+   const int capacity = getCapacity();
+
+   int firstEnd = m_head + m_count;
+   if (firstEnd > capacity)
+   {
+      // Wrapped: the first run fills the arrays to the end and the
+      // second may only stretch as far as the head
+      m_motionHash = advanceSlots(m_head, capacity, in_topLeft,
+         in_bottomRight, pool);
+      m_motionHash += advanceSlots(0,
+         std::min(getPadded(firstEnd - capacity), m_head),
+         in_topLeft, in_bottomRight, pool);
+   }
+   else
+      m_motionHash = advanceSlots(m_head,
+         std::min(m_head + getPadded(m_count), capacity),
+         in_topLeft, in_bottomRight, pool);
+}
+
+/**********************************************************************
+* Method: advanceSlots
+* Description: Runs the batch advance over slots [first, end), split
+*  between the pool's threads if there is one, and returns the motion
+*  hash of the bullets there
+**********************************************************************/
+unsigned BulletRing::advanceSlots(int first, int end,
+   const Point &in_topLeft, const Point &in_bottomRight, TaskPool * pool)
+{
+   if (end <= first)
+      return 0;
+
+   AdvanceArrays arrays = { &m_x[first], &m_y[first], &m_dx[first],
+      &m_dy[first], &m_rotation[first], &m_spin[first], &m_life[first],
+      &m_alive[first] };
+   AdvanceBounds bounds = { in_topLeft.getX(), in_bottomRight.getX(),
+      in_topLeft.getY(), in_bottomRight.getY() };
+
+   if (pool)
+      return advanceEntities(arrays, end - first, bounds, *pool);
+   else
+      return advanceEntities(arrays, end - first, bounds);
+}
+
+/**********************************************************************
+* Method: kill
+* Description: Leaves a tombstone where a bullet hit something
+**********************************************************************/
+void BulletRing::kill(int index)
+{
+   assert(index >= 0 && index < m_count);
+
+   int slot = getSlot(index);
+   if (m_alive[slot])
+      m_motionHash -= getMotionHash(slot);
+   m_alive[slot] = false;
+   m_life[slot] = TOMBSTONE_LIFE;
+}
+
+/**********************************************************************
+* Method: removeDead
+* Description: Drops spent bullets and tombstones off the head of the
+*  ring. Tombstones further in wait their turn.
+**********************************************************************/
+void BulletRing::removeDead()
+{
+   while (m_count > 0 && !m_alive[m_head])
+   {
+      m_bodyHash -= getBodyHash(m_head);
+      m_head = (m_head + 1) & m_mask;
+      m_count--;
+   }
+}
+
+/**********************************************************************
+* Method: clear
+* Description: Removes every bullet
+**********************************************************************/
+void BulletRing::clear()
+{
+   // Unused slots still get advanced, so none may be left alive
+   m_alive.assign(m_alive.size(), false);
+
+   m_head = 0;
+   m_count = 0;
+   m_bodyHash = 0;
+   m_motionHash = 0;
+}
+
+/**********************************************************************
+* Function: writeRing
+* Description: Writes the used part of one array, oldest first: from
+*  the head to the end of the array, then from the start if it wraps
+**********************************************************************/
+template <class T>
+static void writeRing(SnapshotWriter &out, const std::vector<T> &values,
+   int head, int count)
+{
+   int firstCount = std::min(count, (int)values.size() - head);
+   out.write(&values[head], firstCount * sizeof(T));
+   out.write(values, count - firstCount);
+}
+
+/**********************************************************************
+* Method: save
+* Description: Writes the bullets to a snapshot. Bullets never spin, so
+*  their rotation isn't kept.
+**********************************************************************/
+void BulletRing::save(SnapshotWriter &out) const
+{
+   out.write(m_count);
+   writeRing(out, m_x, m_head, m_count);
+   writeRing(out, m_y, m_head, m_count);
+   writeRing(out, m_dx, m_head, m_count);
+   writeRing(out, m_dy, m_head, m_count);
+   writeRing(out, m_radius, m_head, m_count);
+   writeRing(out, m_life, m_head, m_count);
+   writeRing(out, m_alive, m_head, m_count);
+}
+
+/**********************************************************************
+* Method: restore
+* Description: Replaces the bullets with those in a snapshot, the
+*  oldest at the start of the arrays. Returns false if the snapshot
+*  runs short or holds too many.
+**********************************************************************/
+bool BulletRing::restore(SnapshotReader &in)
+{
+   int count = 0;
+   if (!in.readCount(count, SNAPSHOT_BULLET_SIZE))
+      return false;
+   if (count > getCapacity())
+   {
+      in.fail();
+      return false;
+   }
+
+   clear();
+   in.read(m_x, count);
+   in.read(m_y, count);
+   in.read(m_dx, count);
+   in.read(m_dy, count);
+   in.read(m_radius, count);
+   in.read(m_life, count);
+   in.read(m_alive, count);
+   if (!in.isOk())
+   {
+      clear();
+      return false;
+   }
+
+   m_count = count;
+   if (m_count > m_highWater)
+      m_highWater = m_count;
+
+   unsigned long long hash = computeHash();
+   m_bodyHash = (unsigned)(hash >> 32);
+   m_motionHash = (unsigned)hash;
+   return true;
+}
+
+/**********************************************************************
+* Method: swap
+* Description: Trades bullets, and capacity, with another ring
+**********************************************************************/
+void BulletRing::swap(BulletRing &other)
+{
+   std::swap(m_head, other.m_head);
+   std::swap(m_count, other.m_count);
+   std::swap(m_mask, other.m_mask);
+   std::swap(m_highWater, other.m_highWater);
+   std::swap(m_bodyHash, other.m_bodyHash);
+   std::swap(m_motionHash, other.m_motionHash);
+   m_x.swap(other.m_x);
+   m_y.swap(other.m_y);
+   m_dx.swap(other.m_dx);
+   m_dy.swap(other.m_dy);
+   m_radius.swap(other.m_radius);
+   m_rotation.swap(other.m_rotation);
+   m_spin.swap(other.m_spin);
+   m_life.swap(other.m_life);
+   m_alive.swap(other.m_alive);
+}
+
+/**********************************************************************
+* Method: computeHash
+* Description: The hash getHash keeps, added up bullet by bullet
+**********************************************************************/
+unsigned long long BulletRing::computeHash() const
+{
+   unsigned body = 0;
+   unsigned motion = 0;
+   for (int i = 0; i < m_count; i++)
+   {
+      int slot = getSlot(i);
+      body += getBodyHash(slot);
+      if (m_alive[slot])
+         motion += getMotionHash(slot);
+   }
+
+   return ((unsigned long long)body << 32) | motion;
+}
+
+/**********************************************************************
+* Method: getBodyHash
+* Description: The hash of what a bullet keeps all its life
+**********************************************************************/
+unsigned BulletRing::getBodyHash(int slot) const
+{
+   return hashBody(m_dx[slot], m_dy[slot], m_radius[slot], m_spin[slot], 0);
+}
+
+/**********************************************************************
+* Method: getMotionHash
+* Description: The hash of what changes about a bullet each tick
+**********************************************************************/
+unsigned BulletRing::getMotionHash(int slot) const
+{
+   return hashMotion(m_x[slot], m_y[slot], m_rotation[slot], m_life[slot]);
+}
+
+/**********************************************************************
+* Method: getLiveCount
+* Description: How many bullets are still flying, not counting
+*  tombstones
+**********************************************************************/
+int BulletRing::getLiveCount() const
+{
+   int live = 0;
+   for (int i = 0; i < m_count; i++)
+      if (isAlive(i))
+         live++;
+
+   return live;
+}
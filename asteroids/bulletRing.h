@@ -0,0 +1,131 @@
+/*************************************************************
+* File: bulletRing.h
+* Author: Matthew Burr
+*
+* Description: Contains the declaration of the BulletRing, a
+*  fixed-size ring buffer that holds every bullet in flight.
+*************************************************************/
+
+#ifndef bulletRing_h
+#define bulletRing_h
+
+#include "bullet.h"
+#include "point.h"
+#include "velocity.h"
+#include <cstddef>
+#include <vector>
+
+class TaskPool;
+class SnapshotWriter;
+class SnapshotReader;
+
+// The ship fires at most once a frame and every bullet lives exactly
+// BULLET_LIFE frames, so no more than this many can be in flight
+#define BULLETS_PER_FRAME 1
+#define MAX_BULLETS (BULLETS_PER_FRAME * BULLET_LIFE)
+
+// The ring size is a power of two so wrapping an index is a mask
+#define BULLET_RING_CAPACITY 64
+
+static_assert(BULLET_RING_CAPACITY >= MAX_BULLETS,
+   "the bullet ring must hold every bullet that can be in flight");
+static_assert((BULLET_RING_CAPACITY & (BULLET_RING_CAPACITY - 1)) == 0,
+   "the bullet ring capacity must be a power of two");
+
+/*****************************************
+* BULLET RING
+* Bullets all live the same number of
+* frames, so they run out in the order
+* they were fired: new ones go on the
+* tail and spent ones come off the head.
+* A bullet that hits something is left in
+* place as a tombstone until it reaches
+* the head. The slots are allocated once,
+* up front; firing never allocates.
+*
+* Indexes run from 0 (the oldest) to
+* size() - 1 and, like an EntityStore's,
+* only stay put until removeDead. The
+* ring keeps a hash of its bullets and
+* tombstones the same way, too.
+*****************************************/
+class BulletRing
+{
+public:
+   BulletRing(int in_capacity = BULLET_RING_CAPACITY);
+
+   void add(const Bullet &bullet);
+   void advance(const Point &in_topLeft, const Point &in_bottomRight,
+      TaskPool * pool = NULL);
+   void kill(int index);
+   void removeDead();
+   void clear();
+
+   // Every bullet and tombstone, oldest first. Restoring fails if the
+   // snapshot holds more than this ring can.
+   void save(SnapshotWriter &out) const;
+   bool restore(SnapshotReader &in);
+   void swap(BulletRing &other);
+
+   // As EntityStore's: the body hash high, the motion hash low
+   unsigned long long getHash() const
+   {
+      return ((unsigned long long)m_bodyHash << 32) | m_motionHash;
+   }
+   unsigned long long computeHash() const;
+
+   int size() const { return m_count; }
+   int getCapacity() const { return m_mask + 1; }
+   int getLiveCount() const;
+   int getHighWater() const { return m_highWater; }
+
+   // Per-entry accessors
+   Point getPoint(int index) const
+   {
+      int slot = getSlot(index);
+      return Point(m_x[slot], m_y[slot]);
+   }
+   Velocity getVelocity(int index) const
+   {
+      int slot = getSlot(index);
+      return Velocity(m_dx[slot], m_dy[slot]);
+   }
+   float getRadius(int index) const { return m_radius[getSlot(index)]; }
+   int getLife(int index) const { return m_life[getSlot(index)]; }
+   bool isAlive(int index) const { return m_alive[getSlot(index)] != 0; }
+
+   // True for a bullet that was flying at the start of the frame:
+   // one still alive, or one that ran out of life in this advance
+   // and so still gets to hit something along the way
+   bool isFlying(int index) const
+   {
+      int slot = getSlot(index);
+      return m_alive[slot] || m_life[slot] == 0;
+   }
+
+private:
+   int m_head;
+   int m_count;
+   int m_mask;
+   int m_highWater;     // the most bullets the ring has held
+   unsigned m_bodyHash;
+   unsigned m_motionHash;
+
+   std::vector<float> m_x;
+   std::vector<float> m_y;
+   std::vector<float> m_dx;
+   std::vector<float> m_dy;
+   std::vector<float> m_radius;
+   std::vector<int> m_rotation;
+   std::vector<int> m_spin;
+   std::vector<int> m_life;
+   std::vector<unsigned char> m_alive;
+
+   int getSlot(int index) const { return (m_head + index) & m_mask; }
+   unsigned getBodyHash(int slot) const;
+   unsigned getMotionHash(int slot) const;
+   unsigned advanceSlots(int first, int end, const Point &in_topLeft,
+      const Point &in_bottomRight, TaskPool * pool);
+};
+
+#endif /* bulletRing_h */
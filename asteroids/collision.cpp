@@ -0,0 +1,81 @@
+/*************************************************************
+* File: collision.cpp
+* Author: Matthew Burr
+*
+* Description: Contains the implementations of the closest
+*  distance functions used to detect collisions.
+*************************************************************/
+
+#include "collision.h"
+#include "point.h"
+#include "velocity.h"
+// These are needed for the getClosestDistance function...
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+using namespace std;
+
+/**********************************************************
+ * Function: getClosestDistance
+ * Description: Determine how close these two objects will
+ *   get in between the frames.
+ **********************************************************/
+float getClosestDistance(const Point &point1, const Velocity &velocity1,
+                         const Point &point2, const Velocity &velocity2)
+{
+   // find the maximum distance traveled
+   float dMax = max(abs(velocity1.getDx()), abs(velocity1.getDy()));
+   dMax = max(dMax, abs(velocity2.getDx()));
+   dMax = max(dMax, abs(velocity2.getDy()));
+   dMax = max(dMax, 0.1f); // when dx and dy are 0.0. Go through the loop once.
+
+   float distMin = std::numeric_limits<float>::max();
+   for (float i = 0.0; i <= dMax; i++)
+   {
+      Point sample1(point1.getX() - (velocity1.getDx() * i / dMax),
+                    point1.getY() - (velocity1.getDy() * i / dMax));
+      Point sample2(point2.getX() - (velocity2.getDx() * i / dMax),
+                    point2.getY() - (velocity2.getDy() * i / dMax));
+
+      distMin = min(distMin, sample1 - sample2);
+   }
+
+   return distMin;
+}
+
+/**********************************************************
+ * Function: getClosestDistanceSquared
+ * Description: Over the frame, each object travels back
+ *   from its point along its velocity, so the gap between
+ *   them at time t (0..1) is d - w * t, where d is the
+ *   difference in points and w the difference in
+ *   velocities. The square of that is a parabola in t,
+ *   smallest at t = (d . w) / (w . w); we clamp that to
+ *   the frame and measure the gap there.
+ **********************************************************/
+float getClosestDistanceSquared(const Point &point1, const Velocity &velocity1,
+                                const Point &point2, const Velocity &velocity2)
+{
+   float dx = point1.getX() - point2.getX();
+   float dy = point1.getY() - point2.getY();
+   float wx = velocity1.getDx() - velocity2.getDx();
+   float wy = velocity1.getDy() - velocity2.getDy();
+
+   float ww = wx * wx + wy * wy;
+   float t = 0.0f;
+
+   // Objects moving together keep the same gap all frame long
+   if (ww > 0.0f)
+   {
+      t = (dx * wx + dy * wy) / ww;
+      if (t < 0.0f)
+         t = 0.0f;
+      else if (t > 1.0f)
+         t = 1.0f;
+   }
+
+   float gapX = dx - wx * t;
+   float gapY = dy - wy * t;
+   return gapX * gapX + gapY * gapY;
+}
@@ -0,0 +1,57 @@
+/*************************************************************
+* File: collision.h
+* Author: Matthew Burr
+*
+* Description: Contains the functions that decide how close
+*  two moving objects came to each other during a frame.
+*************************************************************/
+
+#ifndef collision_h
+#define collision_h
+
+#include "point.h"
+#include "velocity.h"
+
+/**********************************************************
+ * GET CLOSEST DISTANCE
+ * Determine how close two objects got in between the
+ * frames by stepping both back along their velocities.
+ * This is the original, sampled version; it is kept as
+ * the reference the analytic version is checked against.
+ **********************************************************/
+float getClosestDistance(const Point &point1, const Velocity &velocity1,
+                         const Point &point2, const Velocity &velocity2);
+
+/**********************************************************
+ * GET CLOSEST DISTANCE SQUARED
+ * Determine, exactly and in constant time, the square of
+ * the closest two objects got in between the frames.
+ **********************************************************/
+float getClosestDistanceSquared(const Point &point1, const Velocity &velocity1,
+                                const Point &point2, const Velocity &velocity2);
+
+/**********************************************************
+ * IS SWEPT COLLISION
+ * True if two objects came within a distance (usually the
+ * sum of their radii) of each other between the frames.
+ **********************************************************/
+inline bool isSweptCollision(const Point &point1, const Velocity &velocity1,
+                             const Point &point2, const Velocity &velocity2,
+                             float distance)
+{
+   return getClosestDistanceSquared(point1, velocity1, point2, velocity2) <=
+      distance * distance;
+}
+
+/**********************************************************
+ * GET SWEPT REACH
+ * How far from its current point an object can touch
+ * something during this frame: its radius plus how far it
+ * moved. Broad phases use it to bound their searches.
+ **********************************************************/
+inline float getSweptReach(float dx, float dy, float radius)
+{
+   return radius + (dx < 0 ? -dx : dx) + (dy < 0 ? -dy : dy);
+}
+
+#endif /* collision_h */
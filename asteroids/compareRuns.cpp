@@ -0,0 +1,253 @@
+/*****************************************************
+ * File: compareRuns.cpp
+ * Author: Matthew Burr
+ *
+ * Description: Finds where two runs of the same game
+ *  came apart.
+ *
+ *  Usage: compareRuns first second
+ *
+ *  Given two hash logs (from the game or replay), it
+ *  reports the first tick the hashes differ on. Given
+ *  two snapshots of that tick (from replay), it
+ *  reports the first rock and bullet that differ and
+ *  anything else about the game that does.
+ *
+ *  It exits with 0 if the runs agree, 1 if they don't
+ *  and 2 if the files can't be compared.
+ ******************************************************/
+#include "game.h"
+#include "hashLog.h"
+#include "snapshot.h"
+#include "point.h"
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+using namespace std;
+
+#define SAME 0
+#define DIFFERENT 1
+#define UNREADABLE 2
+
+/*********************************
+ * READ FILE
+ * Every byte of a file
+ *********************************/
+bool readFile(const char * fileName, vector<unsigned char> &bytes)
+{
+   FILE *file = fopen(fileName, "rb");
+   if (file == NULL)
+      return false;
+
+   unsigned char buffer[4096];
+   size_t count;
+   while ((count = fread(buffer, 1, sizeof(buffer), file)) > 0)
+      bytes.insert(bytes.end(), buffer, buffer + count);
+   bool isRead = !ferror(file);
+   fclose(file);
+
+   return isRead && !bytes.empty();
+}
+
+/*********************************
+ * COMPARE HASHES
+ * The first tick two logs differ on
+ *********************************/
+int compareHashes(const HashLog &first, const HashLog &second)
+{
+   int tick = HashLog::findDivergence(first, second);
+   if (tick == NO_DIVERGENCE)
+   {
+      printf("the runs agree on all %d ticks\n", first.getTickCount());
+      return SAME;
+   }
+
+   if (tick >= first.getTickCount() || tick >= second.getTickCount())
+      printf("the runs agree until one stops after %d ticks\n", tick);
+   else
+      printf("the runs first differ on tick %d: %016llx vs %016llx\n", tick,
+         first.getHash(tick), second.getHash(tick));
+   return DIFFERENT;
+}
+
+/*********************************
+ * IS SAME ROCK
+ * True if every field of a rock is
+ * bit-for-bit the same in both
+ *********************************/
+bool isSameRock(const EntityStore &a, const EntityStore &b, int i)
+{
+   return a.getX(i) == b.getX(i) && a.getY(i) == b.getY(i) &&
+      a.getDx(i) == b.getDx(i) && a.getDy(i) == b.getDy(i) &&
+      a.getRadius(i) == b.getRadius(i) &&
+      a.getRotation(i) == b.getRotation(i) && a.getSpin(i) == b.getSpin(i) &&
+      a.getLife(i) == b.getLife(i) && a.isAlive(i) == b.isAlive(i) &&
+      a.getType(i) == b.getType(i);
+}
+
+/*********************************
+ * PRINT ROCK
+ *********************************/
+void printRock(const char * label, const EntityStore &rocks, int i)
+{
+   printf("  %s: type %d at (%.9g, %.9g) moving (%.9g, %.9g) radius %g "
+      "rotation %d spin %d life %d %s\n", label, (int)rocks.getType(i),
+      rocks.getX(i), rocks.getY(i), rocks.getDx(i), rocks.getDy(i),
+      rocks.getRadius(i), rocks.getRotation(i), rocks.getSpin(i),
+      rocks.getLife(i), rocks.isAlive(i) ? "alive" : "dead");
+}
+
+/*********************************
+ * COMPARE ROCKS
+ * Reports the first rock that
+ * differs. Rocks keep their order,
+ * so the same index is the same rock
+ * until the runs part.
+ *********************************/
+bool compareRocks(const EntityStore &first, const EntityStore &second)
+{
+   int count = min(first.size(), second.size());
+   for (int i = 0; i < count; i++)
+      if (!isSameRock(first, second, i))
+      {
+         printf("rock %d differs\n", i);
+         printRock("first ", first, i);
+         printRock("second", second, i);
+         return false;
+      }
+
+   if (first.size() != second.size())
+   {
+      printf("rocks: %d vs %d\n", first.size(), second.size());
+      return false;
+   }
+   return true;
+}
+
+/*********************************
+ * PRINT BULLET
+ *********************************/
+void printBullet(const char * label, const BulletRing &bullets, int i)
+{
+   printf("  %s: at (%.9g, %.9g) moving (%.9g, %.9g) life %d %s\n", label,
+      bullets.getPoint(i).getX(), bullets.getPoint(i).getY(),
+      bullets.getVelocity(i).getDx(), bullets.getVelocity(i).getDy(),
+      bullets.getLife(i), bullets.isAlive(i) ? "alive" : "dead");
+}
+
+/*********************************
+ * COMPARE BULLETS
+ * Reports the first bullet that
+ * differs, oldest first
+ *********************************/
+bool compareBullets(const BulletRing &first, const BulletRing &second)
+{
+   int count = min(first.size(), second.size());
+   for (int i = 0; i < count; i++)
+   {
+      Point a = first.getPoint(i);
+      Point b = second.getPoint(i);
+      Velocity va = first.getVelocity(i);
+      Velocity vb = second.getVelocity(i);
+      if (a.getX() != b.getX() || a.getY() != b.getY() ||
+          va.getDx() != vb.getDx() || va.getDy() != vb.getDy() ||
+          first.getRadius(i) != second.getRadius(i) ||
+          first.getLife(i) != second.getLife(i) ||
+          first.isAlive(i) != second.isAlive(i))
+      {
+         printf("bullet %d differs\n", i);
+         printBullet("first ", first, i);
+         printBullet("second", second, i);
+         return false;
+      }
+   }
+
+   if (first.size() != second.size())
+   {
+      printf("bullets: %d vs %d\n", first.size(), second.size());
+      return false;
+   }
+   return true;
+}
+
+/*********************************
+ * COMPARE GAMES
+ * Everything that differs between
+ * two snapshots, a part at a time
+ *********************************/
+int compareGames(const Game &first, const Game &second)
+{
+   bool isSame = true;
+
+   if (first.getScore() != second.getScore())
+   {
+      printf("score: %d vs %d\n", first.getScore(), second.getScore());
+      isSame = false;
+   }
+   if (first.getLives() != second.getLives())
+   {
+      printf("lives: %d vs %d\n", first.getLives(), second.getLives());
+      isSame = false;
+   }
+
+   const Ship &a = first.getShip();
+   const Ship &b = second.getShip();
+   if (a.getHash() != b.getHash())
+   {
+      printf("the ship differs\n");
+      printf("  first : at (%.9g, %.9g) moving (%.9g, %.9g) %s\n",
+         a.getPoint().getX(), a.getPoint().getY(), a.getVelocity().getDx(),
+         a.getVelocity().getDy(), a.isAlive() ? "alive" : "dead");
+      printf("  second: at (%.9g, %.9g) moving (%.9g, %.9g) %s\n",
+         b.getPoint().getX(), b.getPoint().getY(), b.getVelocity().getDx(),
+         b.getVelocity().getDy(), b.isAlive() ? "alive" : "dead");
+      isSame = false;
+   }
+
+   isSame = compareRocks(first.getRocks(), second.getRocks()) && isSame;
+   isSame = compareBullets(first.getBullets(), second.getBullets()) && isSame;
+
+   if (isSame)
+      printf("the snapshots agree\n");
+   return isSame ? SAME : DIFFERENT;
+}
+
+/*********************************
+ * Main works out what it was given
+ * and compares it
+ *********************************/
+int main(int argc, char ** argv)
+{
+   if (argc != 3)
+   {
+      fprintf(stderr, "usage: compareRuns first second\n");
+      return UNREADABLE;
+   }
+
+   vector<unsigned char> firstBytes;
+   vector<unsigned char> secondBytes;
+   if (!readFile(argv[1], firstBytes) || !readFile(argv[2], secondBytes))
+   {
+      fprintf(stderr, "compareRuns: can't read %s and %s\n", argv[1],
+         argv[2]);
+      return UNREADABLE;
+   }
+
+   HashLog firstHashes;
+   HashLog secondHashes;
+   if (firstHashes.read(&firstBytes[0], firstBytes.size()) &&
+       secondHashes.read(&secondBytes[0], secondBytes.size()))
+      return compareHashes(firstHashes, secondHashes);
+
+   Point topLeft(-200, 200);
+   Point bottomRight(200, -200);
+   Game first(topLeft, bottomRight, 0);
+   Game second(topLeft, bottomRight, 0);
+   if (first.restoreSnapshot(&firstBytes[0], firstBytes.size()) &&
+       second.restoreSnapshot(&secondBytes[0], secondBytes.size()))
+      return compareGames(first, second);
+
+   fprintf(stderr, "compareRuns: %s and %s aren't both hash logs or both "
+      "snapshots\n", argv[1], argv[2]);
+   return UNREADABLE;
+}
@@ -6,9 +6,81 @@
  *  that starts the game and the callback function
  *  that specifies what methods of the game class are
  *  called each time through the game loop.
+ *
+ *  Usage: a.out [record.log]
+ *
+ *  Given a file name, the keys held on every tick
+ *  are written to it when the game closes, for the
+ *  replay program to play the same game again, and
+ *  the state hash after every tick to the same name
+ *  with .hashes on the end, for compareRuns to check
+ *  the replay against.
+ *
+ *  Holding the down arrow plays the last minute
+ *  backwards. A recording has to play from the
+ *  start, so there is no rewinding while recording.
  ******************************************************/
 #include "game.h"
+#include "gameInput.h"
+#include "hashLog.h"
+#include "inputLog.h"
+#include "rewindBuffer.h"
 #include "uiInteract.h"
+#include "fixedTimestep.h"
+#include "framePacer.h"
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+// The game always plays at this many ticks a second, however fast the
+// screen is drawn
+#define TICKS_PER_SECOND 30
+#define FRAMES_PER_SECOND 60
+#define MAX_TICKS_PER_FRAME 5
+#define REWIND_SECONDS 60
+
+// GLUT ends the program with exit(), so the recording outlives main
+static InputLog recording;
+static HashLog recordedHashes;
+static const char * recordingFileName = NULL;
+
+/*************************************
+ * LOOP
+ * What the callback needs from one
+ * frame to the next
+ **************************************/
+struct Loop
+{
+   Game * game;
+   FixedTimestep timestep;
+   long long lastFrame;
+   bool isFirePending;
+   InputLog * log;      // NULL when not recording
+   HashLog * hashes;
+   RewindBuffer * rewind;  // NULL when recording
+
+   Loop(Game * in_game)
+      : game(in_game), timestep(TICKS_PER_SECOND, MAX_TICKS_PER_FRAME),
+      lastFrame(FramePacer::getNow()), isFirePending(false), log(NULL),
+      hashes(NULL), rewind(NULL)
+   {
+   }
+};
+
+/*************************************
+ * SAVE RECORDING
+ * Writes out the keys and hashes
+ * recorded, as the program ends
+ **************************************/
+void saveRecording()
+{
+   if (!recording.save(recordingFileName))
+      fprintf(stderr, "asteroids: can't write %s\n", recordingFileName);
+
+   std::string hashFileName = std::string(recordingFileName) + ".hashes";
+   if (!recordedHashes.save(hashFileName.c_str()))
+      fprintf(stderr, "asteroids: can't write %s\n", hashFileName.c_str());
+}
 
 /*************************************
  * All the interesting work happens here, when
@@ -16,14 +88,56 @@
  * When I am finished drawing, then the graphics
  * engine will wait until the proper amount of
  * time has passed and put the drawing on the screen.
+ *
+ * The game runs however many ticks the time since
+ * the last frame pays for (maybe none) and is then
+ * drawn partway between its last two ticks.
+ *
+ * While rewinding, each tick's worth of time
+ * steps the game back a tick instead, and it
+ * is drawn partway on toward the tick before,
+ * so it runs backwards as smoothly as forwards.
  **************************************/
 void callBack(const Interface *pUI, void *p)
 {
-   Game *pGame = (Game *)p;
-   
-   pGame->advance();
-   pGame->handleInput(*pUI);
-   pGame->draw(*pUI);
+   Loop *pLoop = (Loop *)p;
+
+   long long now = FramePacer::getNow();
+   int ticks = pLoop->timestep.addTime(now - pLoop->lastFrame);
+   pLoop->lastFrame = now;
+
+   if (pLoop->rewind && pUI->isDown())
+   {
+      for (int i = 0; i < ticks; i++)
+         if (!pLoop->rewind->stepBack(*pLoop->game))
+            break;
+      pLoop->game->draw(pLoop->rewind->getTickCount() > 0 ?
+         1.0f - pLoop->timestep.getAlpha() : 1.0f);
+      return;
+   }
+
+   // A tap of the fire key only shows for one frame, so we hold on to
+   // it until there is a tick to fire on
+   pLoop->isFirePending = pLoop->isFirePending || pUI->isSpace();
+
+   for (int i = 0; i < ticks; i++)
+   {
+      GameInput input = { pUI->isLeft() != 0, pUI->isRight() != 0,
+         pUI->isUp() != 0, pLoop->isFirePending };
+      if (pLoop->rewind)
+         pLoop->rewind->record(*pLoop->game, input);
+
+      pLoop->game->advance();
+      pLoop->game->handleInput(input);
+      pLoop->isFirePending = false;
+
+      if (pLoop->log)
+         pLoop->log->add(input);
+      if (pLoop->hashes)
+         pLoop->hashes->add(pLoop->game->getStateHash());
+   }
+
+   pLoop->game->draw(pLoop->timestep.getAlpha());
 }
 
 
@@ -36,10 +150,28 @@ int main(int argc, char ** argv)
 {
    Point topLeft(-200, 200);
    Point bottomRight(200, -200);
-   
+   const char * fileName = (argc > 1) ? argv[1] : NULL;
+
    Interface ui(argc, argv, "Asteroids", topLeft, bottomRight);
-   Game game(topLeft, bottomRight);
-   ui.run(callBack, &game);
+   ui.setFramesPerSecond(FRAMES_PER_SECOND);
+   // a different game every time
+   unsigned long long seed = FramePacer::getNow();
+   Game game(topLeft, bottomRight, START_ROCK_COUNT, MAX_BULLETS, seed);
+   Loop loop(&game);
+   RewindBuffer rewind(REWIND_SECONDS * TICKS_PER_SECOND);
+
+   if (fileName != NULL)
+   {
+      recording = InputLog(seed, START_ROCK_COUNT);
+      recordingFileName = fileName;
+      loop.log = &recording;
+      loop.hashes = &recordedHashes;
+      atexit(saveRecording);
+   }
+   else
+      loop.rewind = &rewind;
+
+   ui.run(callBack, &loop);
    
    return 0;
 }
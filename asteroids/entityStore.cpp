@@ -0,0 +1,452 @@
+/*************************************************************
+* File: entityStore.cpp
+* Author: Matthew Burr
+*
+* Description: Contains the implementations of the
+*  method bodies for the EntityStore class.
+*************************************************************/
+
+#include "entityStore.h"
+#include "advanceKernel.h"
+#include "point.h"
+#include "velocity.h"
+#include "snapshot.h"
+#include "stateHash.h"
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+#define NO_SLOT -1
+
+// What an entry takes up in a snapshot
+#define SNAPSHOT_ENTRY_SIZE (5 * sizeof(float) + 3 * sizeof(int) + 2)
+using namespace std;
+
+/**********************************************************************
+* Method: EntityStore
+* Description: Creates a new, empty EntityStore
+**********************************************************************/
+EntityStore::EntityStore() : m_highWater(0), m_bodyHash(0), m_motionHash(0)
+{
+}
+
+/**********************************************************************
+* Method: add
+* Description: Adds an entry to the end of the store and returns a
+*  handle that stays valid until the entry is removed
+**********************************************************************/
+EntityHandle EntityStore::add(EntityType in_type, const Point &in_point,
+   const Velocity &in_velocity, float in_radius, int in_spin,
+   int in_life, int in_rotation)
+{
+   int index = size();
+
+   m_x.push_back(in_point.getX());
+   m_y.push_back(in_point.getY());
+   m_dx.push_back(in_velocity.getDx());
+   m_dy.push_back(in_velocity.getDy());
+   m_radius.push_back(in_radius);
+   m_rotation.push_back(in_rotation);
+   m_spin.push_back(in_spin);
+   m_life.push_back(in_life);
+   m_alive.push_back(true);
+   m_type.push_back((unsigned char)in_type);
+   if (size() > m_highWater)
+      m_highWater = size();
+
+   // Reuse a free slot if we have one, otherwise make a new one
+   int slot;
+   if (!m_freeSlots.empty())
+   {
+      slot = m_freeSlots.back();
+      m_freeSlots.pop_back();
+   }
+   else
+   {
+      slot = (int)m_slotIndex.size();
+      m_slotIndex.push_back(NO_SLOT);
+      m_slotGeneration.push_back(0);
+   }
+
+   m_slotIndex[slot] = index;
+   m_slot.push_back(slot);
+
+   m_bodyHash += getBodyHash(index);
+   m_motionHash += getMotionHash(index);
+
+   EntityHandle handle = { slot, m_slotGeneration[slot] };
+   return handle;
+}
+
+/**********************************************************************
+* Method: advance
+* Description: Moves every entry by its velocity, wrapping it around
+*  the given boundaries, spins it and counts down its life. This is
+*  the same work FlyingObject, Rock and Bullet do in their advance
+*  methods, done for the whole store at once by a batch kernel. Given
+*  a pool, the store is split between its threads. Every live entry
+*  moves, so the kernel works the motion hash out afresh.
+**********************************************************************/
+void EntityStore::advance(const Point &in_topLeft, const Point &in_bottomRight,
+   TaskPool * pool)
+{
+   if (m_type.empty())
+      return;
+
+   AdvanceArrays arrays = { &m_x[0], &m_y[0], &m_dx[0], &m_dy[0],
+      &m_rotation[0], &m_spin[0], &m_life[0], &m_alive[0] };
+   AdvanceBounds bounds = { in_topLeft.getX(), in_bottomRight.getX(),
+      in_topLeft.getY(), in_bottomRight.getY() };
+
+   if (pool)
+      m_motionHash = advanceEntities(arrays, size(), bounds, *pool);
+   else
+      m_motionHash = advanceEntities(arrays, size(), bounds);
+}
+
+/**********************************************************************
+* Method: kill
+* Description: Marks an entry dead; it stays where it is until
+*  removeDead
+**********************************************************************/
+void EntityStore::kill(int index)
+{
+   if (m_alive[index])
+   {
+      m_motionHash -= getMotionHash(index);
+      m_alive[index] = false;
+   }
+}
+
+/**********************************************************************
+* Method: removeDead
+* Description: Compacts the store, dropping dead entries while keeping
+*  the survivors in their original order
+**********************************************************************/
+void EntityStore::removeDead()
+{
+   const int count = size();
+   int kept = 0;
+
+   // Most frames kill few entries, so everything before the first
+   // dead one stays exactly where it is
+   while (kept < count && m_alive[kept])
+      kept++;
+
+   if (kept == count)
+      return;
+
+   for (int i = kept; i < count; i++)
+   {
+      if (!m_alive[i])
+      {
+         // Free the slot and bump its generation so that any
+         // outstanding handles to it become invalid
+         int slot = m_slot[i];
+         m_slotIndex[slot] = NO_SLOT;
+         m_slotGeneration[slot]++;
+         m_freeSlots.push_back(slot);
+         m_bodyHash -= getBodyHash(i);
+         continue;
+      }
+
+      if (kept != i)
+      {
+         m_x[kept] = m_x[i];
+         m_y[kept] = m_y[i];
+         m_dx[kept] = m_dx[i];
+         m_dy[kept] = m_dy[i];
+         m_radius[kept] = m_radius[i];
+         m_rotation[kept] = m_rotation[i];
+         m_spin[kept] = m_spin[i];
+         m_life[kept] = m_life[i];
+         m_alive[kept] = m_alive[i];
+         m_type[kept] = m_type[i];
+         m_slot[kept] = m_slot[i];
+         m_slotIndex[m_slot[kept]] = kept;
+      }
+
+      kept++;
+   }
+
+   m_x.resize(kept);
+   m_y.resize(kept);
+   m_dx.resize(kept);
+   m_dy.resize(kept);
+   m_radius.resize(kept);
+   m_rotation.resize(kept);
+   m_spin.resize(kept);
+   m_life.resize(kept);
+   m_alive.resize(kept);
+   m_type.resize(kept);
+   m_slot.resize(kept);
+}
+
+/**********************************************************************
+* Method: clear
+* Description: Removes every entry from the store
+**********************************************************************/
+void EntityStore::clear()
+{
+   for (int i = 0; i < size(); i++)
+      m_alive[i] = false;
+
+   removeDead();
+   m_motionHash = 0;
+}
+
+/**********************************************************************
+* Method: reserve
+* Description: Makes room for a number of entries up front so that
+*  adding them does not reallocate the arrays
+**********************************************************************/
+void EntityStore::reserve(int in_capacity)
+{
+   assert(in_capacity >= 0);
+
+   m_x.reserve(in_capacity);
+   m_y.reserve(in_capacity);
+   m_dx.reserve(in_capacity);
+   m_dy.reserve(in_capacity);
+   m_radius.reserve(in_capacity);
+   m_rotation.reserve(in_capacity);
+   m_spin.reserve(in_capacity);
+   m_life.reserve(in_capacity);
+   m_alive.reserve(in_capacity);
+   m_type.reserve(in_capacity);
+   m_slot.reserve(in_capacity);
+}
+
+/**********************************************************************
+* Method: getLiveCount
+* Description: How many entries are alive; dead ones still take up
+*  room until removeDead
+**********************************************************************/
+int EntityStore::getLiveCount() const
+{
+   int live = 0;
+   for (int i = 0; i < size(); i++)
+      if (m_alive[i])
+         live++;
+   return live;
+}
+
+/**********************************************************************
+* Method: save
+* Description: Writes the entries to a snapshot, a whole array at a
+*  time
+**********************************************************************/
+void EntityStore::save(SnapshotWriter &out) const
+{
+   int count = size();
+   out.write(count);
+   out.write(m_x, count);
+   out.write(m_y, count);
+   out.write(m_dx, count);
+   out.write(m_dy, count);
+   out.write(m_radius, count);
+   out.write(m_rotation, count);
+   out.write(m_spin, count);
+   out.write(m_life, count);
+   out.write(m_alive, count);
+   out.write(m_type, count);
+}
+
+/**********************************************************************
+* Method: restore
+* Description: Replaces the entries with those in a snapshot. Each gets
+*  a new slot, and the old slots move on a generation so no handle from
+*  before still works. Returns false, leaving the store empty, if the
+*  snapshot runs short or holds a type no entry can have.
+**********************************************************************/
+bool EntityStore::restore(SnapshotReader &in)
+{
+   int count = 0;
+   if (in.readCount(count, SNAPSHOT_ENTRY_SIZE))
+   {
+      resize(count);
+      in.read(m_x, count);
+      in.read(m_y, count);
+      in.read(m_dx, count);
+      in.read(m_dy, count);
+      in.read(m_radius, count);
+      in.read(m_rotation, count);
+      in.read(m_spin, count);
+      in.read(m_life, count);
+      in.read(m_alive, count);
+      in.read(m_type, count);
+
+      for (int i = 0; i < count; i++)
+         if (m_type[i] > ENTITY_BULLET)
+            in.fail();
+   }
+   if (!in.isOk())
+      resize(0);
+   if (size() > m_highWater)
+      m_highWater = size();
+
+   resetSlots();
+   unsigned long long hash = computeHash();
+   m_bodyHash = (unsigned)(hash >> 32);
+   m_motionHash = (unsigned)hash;
+
+   return in.isOk();
+}
+
+/**********************************************************************
+* Method: swap
+* Description: Trades entries with another store. Every handle to
+*  either store goes stale, as it would on a restore.
+**********************************************************************/
+void EntityStore::swap(EntityStore &other)
+{
+   m_x.swap(other.m_x);
+   m_y.swap(other.m_y);
+   m_dx.swap(other.m_dx);
+   m_dy.swap(other.m_dy);
+   m_radius.swap(other.m_radius);
+   m_rotation.swap(other.m_rotation);
+   m_spin.swap(other.m_spin);
+   m_life.swap(other.m_life);
+   m_alive.swap(other.m_alive);
+   m_type.swap(other.m_type);
+   std::swap(m_bodyHash, other.m_bodyHash);
+   std::swap(m_motionHash, other.m_motionHash);
+   std::swap(m_highWater, other.m_highWater);
+
+   // The slots go with the entries. Where both stores have a slot, it
+   // moves past both generations, so no handle to either still works.
+   m_slot.swap(other.m_slot);
+   m_slotIndex.swap(other.m_slotIndex);
+   m_slotGeneration.swap(other.m_slotGeneration);
+   m_freeSlots.swap(other.m_freeSlots);
+   size_t slots = min(m_slotGeneration.size(), other.m_slotGeneration.size());
+   for (size_t slot = 0; slot < slots; slot++)
+   {
+      int generation = max(m_slotGeneration[slot],
+         other.m_slotGeneration[slot]) + 1;
+      m_slotGeneration[slot] = generation;
+      other.m_slotGeneration[slot] = generation;
+   }
+}
+
+/**********************************************************************
+* Method: resize
+* Description: Sizes every array to hold a number of entries, leaving
+*  the slots and hashes to the caller
+**********************************************************************/
+void EntityStore::resize(int in_count)
+{
+   m_x.resize(in_count);
+   m_y.resize(in_count);
+   m_dx.resize(in_count);
+   m_dy.resize(in_count);
+   m_radius.resize(in_count);
+   m_rotation.resize(in_count);
+   m_spin.resize(in_count);
+   m_life.resize(in_count);
+   m_alive.resize(in_count);
+   m_type.resize(in_count);
+}
+
+/**********************************************************************
+* Method: resetSlots
+* Description: Gives entry i slot i, moving every slot there was on a
+*  generation first, and frees the slots past the last entry
+**********************************************************************/
+void EntityStore::resetSlots()
+{
+   int count = size();
+   for (size_t slot = 0; slot < m_slotGeneration.size(); slot++)
+      m_slotGeneration[slot]++;
+
+   int slots = max(count, (int)m_slotIndex.size());
+   m_slotIndex.assign(slots, NO_SLOT);
+   m_slotGeneration.resize(slots, 0);
+   m_slot.resize(count);
+   for (int i = 0; i < count; i++)
+   {
+      m_slot[i] = i;
+      m_slotIndex[i] = i;
+   }
+
+   m_freeSlots.clear();
+   for (int slot = slots - 1; slot >= count; slot--)
+      m_freeSlots.push_back(slot);
+}
+
+/**********************************************************************
+* Method: computeHash
+* Description: The hash getHash keeps, added up entry by entry
+**********************************************************************/
+unsigned long long EntityStore::computeHash() const
+{
+   unsigned body = 0;
+   unsigned motion = 0;
+   for (int i = 0; i < size(); i++)
+   {
+      body += getBodyHash(i);
+      if (m_alive[i])
+         motion += getMotionHash(i);
+   }
+
+   return ((unsigned long long)body << 32) | motion;
+}
+
+/**********************************************************************
+* Method: getBodyHash
+* Description: The hash of what an entry keeps all its life
+**********************************************************************/
+unsigned EntityStore::getBodyHash(int index) const
+{
+   return hashBody(m_dx[index], m_dy[index], m_radius[index], m_spin[index],
+      m_type[index]);
+}
+
+/**********************************************************************
+* Method: getMotionHash
+* Description: The hash of what changes about an entry each tick
+**********************************************************************/
+unsigned EntityStore::getMotionHash(int index) const
+{
+   return hashMotion(m_x[index], m_y[index], m_rotation[index],
+      m_life[index]);
+}
+
+/**********************************************************************
+* Method: isValid
+* Description: True if the handle still refers to an entry in the store
+**********************************************************************/
+bool EntityStore::isValid(const EntityHandle &handle) const
+{
+   return handle.slot >= 0 &&
+      handle.slot < (int)m_slotIndex.size() &&
+      m_slotGeneration[handle.slot] == handle.generation &&
+      m_slotIndex[handle.slot] != NO_SLOT;
+}
+
+/**********************************************************************
+* Method: getIndex
+* Description: Gets the current index of the entry a handle refers to,
+*  or -1 if the handle is no longer valid
+**********************************************************************/
+int EntityStore::getIndex(const EntityHandle &handle) const
+{
+   if (!isValid(handle))
+      return NO_SLOT;
+
+   return m_slotIndex[handle.slot];
+}
+
+/**********************************************************************
+* Method: getHandle
+* Description: Gets a stable handle for the entry at an index
+**********************************************************************/
+EntityHandle EntityStore::getHandle(int index) const
+{
+   assert(index >= 0 && index < size());
+
+   int slot = m_slot[index];
+   EntityHandle handle = { slot, m_slotGeneration[slot] };
+   return handle;
+}
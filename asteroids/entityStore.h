@@ -0,0 +1,153 @@
+/*************************************************************
+* File: entityStore.h
+* Author: Matthew Burr
+*
+* Description: Contains the declaration of the EntityStore, a
+*  structure-of-arrays container that holds the state of many
+*  flying objects in contiguous memory.
+*************************************************************/
+
+#ifndef entityStore_h
+#define entityStore_h
+
+#include "point.h"
+#include "velocity.h"
+#include <cstddef>
+#include <vector>
+
+class TaskPool;
+class SnapshotWriter;
+class SnapshotReader;
+
+/*****************************************
+* ENTITY TYPE
+* A compact tag identifying what kind of
+* object an entry in the store represents
+*****************************************/
+enum EntityType
+{
+   ENTITY_BIG_ROCK,
+   ENTITY_MEDIUM_ROCK,
+   ENTITY_SMALL_ROCK,
+   ENTITY_BULLET
+};
+
+/*****************************************
+* ENTITY HANDLE
+* A stable reference to an entry in the
+* store. The index moves as the store is
+* compacted; the handle does not.
+*****************************************/
+struct EntityHandle
+{
+   int slot;
+   int generation;
+};
+
+/*****************************************
+* ENTITY STORE
+* Keeps position, velocity, radius,
+* rotation, life, alive flags and type
+* tags in separate arrays so that the
+* per-frame passes walk linear memory.
+* Dead entries stay in place (so indexes
+* are stable within a frame) until
+* removeDead is called.
+*
+* The arrays are the store's pool: entries
+* come and go without touching the heap
+* until there are more of them than ever
+* before. The counters show how full it
+* is, how full it has been, and how much
+* room it has.
+*
+* The store keeps a hash of everything in
+* it up to date as it changes (see
+* stateHash.h).
+*****************************************/
+class EntityStore
+{
+public:
+   EntityStore();
+
+   EntityHandle add(EntityType in_type, const Point &in_point,
+      const Velocity &in_velocity, float in_radius, int in_spin,
+      int in_life, int in_rotation = 0);
+   void advance(const Point &in_topLeft, const Point &in_bottomRight,
+      TaskPool * pool = NULL);
+   void kill(int index);
+   void removeDead();
+   void clear();
+   void reserve(int in_capacity);
+
+   // Every entry, array by array. Restoring replaces what is in the
+   // store, and every handle to it goes stale.
+   void save(SnapshotWriter &out) const;
+   bool restore(SnapshotReader &in);
+   void swap(EntityStore &other);
+
+   // The body hash in the high half and the motion hash in the low.
+   // computeHash works it out from scratch, to check getHash against.
+   unsigned long long getHash() const
+   {
+      return ((unsigned long long)m_bodyHash << 32) | m_motionHash;
+   }
+   unsigned long long computeHash() const;
+
+   int size() const { return (int)m_type.size(); }
+   int getLiveCount() const;
+   int getHighWater() const { return m_highWater; }
+   int getCapacity() const { return (int)m_type.capacity(); }
+   bool isValid(const EntityHandle &handle) const;
+   int getIndex(const EntityHandle &handle) const;
+   EntityHandle getHandle(int index) const;
+
+   // Per-entry accessors
+   EntityType getType(int index) const { return (EntityType)m_type[index]; }
+   Point getPoint(int index) const { return Point(m_x[index], m_y[index]); }
+   Velocity getVelocity(int index) const
+   {
+      return Velocity(m_dx[index], m_dy[index]);
+   }
+   float getX(int index) const { return m_x[index]; }
+   float getY(int index) const { return m_y[index]; }
+   float getDx(int index) const { return m_dx[index]; }
+   float getDy(int index) const { return m_dy[index]; }
+   float getRadius(int index) const { return m_radius[index]; }
+   int getRotation(int index) const { return m_rotation[index]; }
+   int getLife(int index) const { return m_life[index]; }
+   bool isAlive(int index) const { return m_alive[index] != 0; }
+   int getSpin(int index) const { return m_spin[index]; }
+
+private:
+   unsigned getBodyHash(int index) const;
+   unsigned getMotionHash(int index) const;
+   void resize(int in_count);
+   void resetSlots();
+
+   std::vector<float> m_x;
+   std::vector<float> m_y;
+   std::vector<float> m_dx;
+   std::vector<float> m_dy;
+   std::vector<float> m_radius;
+   std::vector<int> m_rotation;
+   std::vector<int> m_spin;
+   std::vector<int> m_life;
+   std::vector<unsigned char> m_alive;
+   std::vector<unsigned char> m_type;
+
+   // Handle bookkeeping: each entry owns a slot, each slot knows
+   // which entry it points to (or -1 if it is free)
+   std::vector<int> m_slot;
+   std::vector<int> m_slotIndex;
+   std::vector<int> m_slotGeneration;
+   std::vector<int> m_freeSlots;
+
+   int m_highWater;     // the most entries the store has held
+
+   // Sums over every entry, and over the live ones
+   unsigned m_bodyHash;
+   unsigned m_motionHash;
+};
+
+#endif /* entityStore_h */
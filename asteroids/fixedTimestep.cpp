@@ -0,0 +1,48 @@
+/*************************************************************
+* File: fixedTimestep.cpp
+* Author: Matthew Burr
+*
+* Description: Contains the implementations of the
+*  method bodies for the FixedTimestep class.
+*************************************************************/
+
+#include "fixedTimestep.h"
+#include <cassert>
+
+#define NANOSECONDS_PER_SECOND 1e9
+
+/**********************************************************************
+* Method: FixedTimestep
+* Description: Creates a FixedTimestep with nothing saved up
+**********************************************************************/
+FixedTimestep::FixedTimestep(double in_ticksPerSecond,
+   int in_maxTicksPerFrame)
+   : m_tick((long long)(NANOSECONDS_PER_SECOND / in_ticksPerSecond)),
+   m_saved(0), m_maxTicksPerFrame(in_maxTicksPerFrame), m_droppedTicks(0)
+{
+   assert(in_ticksPerSecond > 0);
+   assert(in_maxTicksPerFrame > 0);
+}
+
+/**********************************************************************
+* Method: addTime
+* Description: Saves up the time since the last frame and returns how
+*  many ticks to run before drawing this one
+**********************************************************************/
+int FixedTimestep::addTime(long long in_nanoseconds)
+{
+   if (in_nanoseconds > 0)
+      m_saved += in_nanoseconds;
+
+   long long ticks = m_saved / m_tick;
+   if (ticks > m_maxTicksPerFrame)
+   {
+      m_droppedTicks += ticks - m_maxTicksPerFrame;
+      ticks = m_maxTicksPerFrame;
+   }
+
+   // The ticks run and any dropped are spent; only a part of a tick
+   // is carried over
+   m_saved %= m_tick;
+   return (int)ticks;
+}
@@ -0,0 +1,47 @@
+/*************************************************************
+* File: fixedTimestep.h
+* Author: Matthew Burr
+*
+* Description: Contains the declaration of FixedTimestep,
+*  which turns the time between displayed frames into a
+*  whole number of fixed simulation ticks.
+*************************************************************/
+
+#ifndef fixedTimestep_h
+#define fixedTimestep_h
+
+/*****************************************
+* FIXED TIMESTEP
+* Saves up the time that passes between
+* displayed frames and pays it out a
+* tick's worth at a time, so the game
+* runs at the same speed however fast it
+* is drawn. What is left over, as a share
+* of a tick, says how far the display is
+* between the last tick and the next.
+*
+* After a long stall only a few ticks are
+* run and the rest of the backlog is
+* dropped; otherwise a frame that takes
+* too long to catch up makes the next one
+* longer still.
+*****************************************/
+class FixedTimestep
+{
+public:
+   FixedTimestep(double in_ticksPerSecond, int in_maxTicksPerFrame);
+
+   int addTime(long long in_nanoseconds);
+   float getAlpha() const { return (float)m_saved / m_tick; }
+
+   long long getTick() const { return m_tick; }
+   long long getDroppedTicks() const { return m_droppedTicks; }
+
+private:
+   long long m_tick;       // all times in nanoseconds
+   long long m_saved;
+   int m_maxTicksPerFrame;
+   long long m_droppedTicks;
+};
+
+#endif /* fixedTimestep_h */
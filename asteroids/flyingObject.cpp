@@ -9,30 +9,31 @@
 #include "flyingObject.h"
 #include "point.h"
 #include "velocity.h"
-
-bool FlyingObject::s_hasBoundaries(false);
-Point FlyingObject::s_topLeft(0, 0);
-Point FlyingObject::s_bottomRight(0, 0);
+#include "snapshot.h"
 
 /**********************************************************************
- * Method: setBoundaries
- * Description: Sets the boundaries for all FlyingObjects. They will
- * stay within these boundaries - wrapping around to the other side
- * if they reach one of the bounds.
- **********************************************************************/
-void FlyingObject::setBoundaries(const Point &in_tl, const Point &in_br)
+* Method: FlyingObject
+* Description: Creates a new FlyingObject, with no boundaries until it
+*  is given some
+**********************************************************************/
+FlyingObject::FlyingObject()
+   : m_isAlive(true), m_hasBoundaries(false), m_topLeft(0, 0),
+   m_bottomRight(0, 0)
 {
-   s_topLeft = in_tl;
-   s_bottomRight = in_br;
-   s_hasBoundaries = true;
 }
 
 /**********************************************************************
-* Method: FlyingObject
-* Description: Creates a new FlyingObject
-**********************************************************************/
-FlyingObject::FlyingObject() : m_isAlive(true)
+ * Method: setBoundaries
+ * Description: Sets the boundaries of the world this object is in. It
+ * will stay within them - wrapping around to the other side if it
+ * reaches one of the bounds. Each object has its own, so objects in
+ * different worlds never interfere.
+ **********************************************************************/
+void FlyingObject::setBoundaries(const Point &in_tl, const Point &in_br)
 {
+   m_topLeft = in_tl;
+   m_bottomRight = in_br;
+   m_hasBoundaries = true;
 }
 
 /**********************************************************************
@@ -99,27 +100,27 @@ void FlyingObject::advance()
    m_point += m_velocity;
 
    // If we have boundaries, then we need to keep the point within 
-   // the bounds of s_topLeft &
-   // s_bottomRight. 
-   if (!s_hasBoundaries)
+   // the bounds of m_topLeft &
+   // m_bottomRight.
+   if (!m_hasBoundaries)
       return;
 
-   if (m_point.getX() < s_topLeft.getX())
+   if (m_point.getX() < m_topLeft.getX())
    {
-      m_point.setX(s_bottomRight.getX());
+      m_point.setX(m_bottomRight.getX());
    }
-   else if (m_point.getX() > s_bottomRight.getX())
+   else if (m_point.getX() > m_bottomRight.getX())
    {
-      m_point.setX(s_topLeft.getX());
+      m_point.setX(m_topLeft.getX());
    }
 
-   if (m_point.getY() < s_bottomRight.getY())
+   if (m_point.getY() < m_bottomRight.getY())
    {
-      m_point.setY(s_topLeft.getY());
+      m_point.setY(m_topLeft.getY());
    }
-   else if (m_point.getY() > s_topLeft.getY())
+   else if (m_point.getY() > m_topLeft.getY())
    {
-      m_point.setY(s_bottomRight.getY());
+      m_point.setY(m_bottomRight.getY());
    }
 }
 
@@ -133,3 +134,37 @@ FlyingObject & FlyingObject::operator+=(const Velocity & rhs)
    m_velocity += rhs;
    return *this;
 }
+
+/**********************************************************************
+* Method: save
+* Description: Writes the object's state to a snapshot
+**********************************************************************/
+void FlyingObject::save(SnapshotWriter &out) const
+{
+   out.write(m_point.getX());
+   out.write(m_point.getY());
+   out.write(m_velocity.getDx());
+   out.write(m_velocity.getDy());
+   out.write((unsigned char)m_isAlive);
+}
+
+/**********************************************************************
+* Method: restore
+* Description: Reads back what save wrote. Nothing changes unless all
+*  of it is there.
+**********************************************************************/
+void FlyingObject::restore(SnapshotReader &in)
+{
+   float x, y, dx, dy;
+   unsigned char isAlive;
+   in.read(x);
+   in.read(y);
+   in.read(dx);
+   in.read(dy);
+   if (!in.read(isAlive))
+      return;
+
+   m_point = Point(x, y);
+   m_velocity = Velocity(dx, dy);
+   m_isAlive = isAlive != 0;
+}
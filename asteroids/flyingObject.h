@@ -11,6 +11,9 @@
 #include "point.h"
 #include "velocity.h"
 
+class SnapshotWriter;
+class SnapshotReader;
+
 /*****************************************
 * FLYING OBJECT
 * A class from which all flying objects
@@ -23,16 +26,13 @@ private:
    Point m_point;
    Velocity m_velocity;
    bool m_isAlive;
-   static bool s_hasBoundaries;
-   static Point s_topLeft;
-   static Point s_bottomRight;   
-
-   static Point getTopLeft() { return s_topLeft; }
-   static Point getBottomRight() { return s_bottomRight; }
+   bool m_hasBoundaries;
+   Point m_topLeft;
+   Point m_bottomRight;
 
 public:
-   static void setBoundaries(const Point &in_tl, const Point &in_br);
    FlyingObject();
+   void setBoundaries(const Point &in_tl, const Point &in_br);
 
    Point getPoint() const;
    Velocity getVelocity() const;
@@ -44,6 +44,11 @@ public:
    virtual void advance();
    virtual void draw() const = 0;
    FlyingObject & operator+=(const Velocity & rhs);
+
+   // Point, velocity and whether it's alive; the boundaries belong to
+   // whatever world the object is in
+   void save(SnapshotWriter &out) const;
+   void restore(SnapshotReader &in);
 };
 
 #endif /* flyingObject_h */
@@ -0,0 +1,205 @@
+/*************************************************************
+* File: framePacer.cpp
+* Author: Matthew Burr
+*
+* Description: Contains the implementations of the
+*  method bodies for the FramePacer class.
+*
+*  On Linux this uses CLOCK_MONOTONIC and sleeps with
+*  clock_nanosleep to an absolute time, so a sleep that
+*  is interrupted or starts late still ends on time.
+*  Elsewhere it uses the standard library's steady clock.
+*************************************************************/
+
+#include "framePacer.h"
+#include <cmath>
+
+#ifdef __linux__
+#include <time.h>
+#else
+#include <chrono>
+#include <thread>
+#endif
+
+#define NANOSECONDS_PER_SECOND 1000000000LL
+
+// The OS may wake us this late from a sleep, so we spin instead for
+// the last stretch before a frame is due
+#define SPIN_NANOSECONDS 500000LL
+using namespace std;
+
+/**********************************************************************
+* Method: FramePacer
+* Description: Creates a new FramePacer; the first frame is due as
+*  soon as it is waited for
+**********************************************************************/
+FramePacer::FramePacer(double in_framesPerSecond)
+   : m_deadline(0), m_lastFrame(0)
+{
+   setFramesPerSecond(in_framesPerSecond);
+   resetStats();
+}
+
+/**********************************************************************
+* Method: setFramesPerSecond
+* Description: Sets how many frames are due each second
+**********************************************************************/
+void FramePacer::setFramesPerSecond(double in_framesPerSecond)
+{
+   if (in_framesPerSecond <= 0)
+      in_framesPerSecond = DEFAULT_FRAMES_PER_SECOND;
+
+   m_period = (long long)(NANOSECONDS_PER_SECOND / in_framesPerSecond);
+}
+
+/**********************************************************************
+* Method: getNow
+* Description: The monotonic clock, in nanoseconds
+**********************************************************************/
+long long FramePacer::getNow()
+{
+#ifdef __linux__
+   timespec now;
+   clock_gettime(CLOCK_MONOTONIC, &now);
+   return now.tv_sec * NANOSECONDS_PER_SECOND + now.tv_nsec;
+#else
+   return chrono::duration_cast<chrono::nanoseconds>(
+      chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+/**********************************************************************
+* Method: sleepUntil
+* Description: Sleeps until a time on the monotonic clock
+**********************************************************************/
+void FramePacer::sleepUntil(long long time)
+{
+#ifdef __linux__
+   timespec until;
+   until.tv_sec = (time_t)(time / NANOSECONDS_PER_SECOND);
+   until.tv_nsec = (long)(time % NANOSECONDS_PER_SECOND);
+
+   // Signals cut the sleep short; the deadline is absolute, so we can
+   // just go back to sleep
+   while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &until, NULL) != 0)
+      ;
+#else
+   this_thread::sleep_until(chrono::steady_clock::time_point(
+      chrono::duration_cast<chrono::steady_clock::duration>(
+      chrono::nanoseconds(time))));
+#endif
+}
+
+/**********************************************************************
+* Method: isTimeToDraw
+* Description: True once the next frame is due
+**********************************************************************/
+bool FramePacer::isTimeToDraw() const
+{
+   return getNow() >= m_deadline;
+}
+
+/**********************************************************************
+* Method: getTimeToNextFrame
+* Description: Seconds until the next frame is due; 0 if it already is
+**********************************************************************/
+double FramePacer::getTimeToNextFrame() const
+{
+   long long remaining = m_deadline - getNow();
+   return remaining > 0 ? remaining / 1e9 : 0.0;
+}
+
+/**********************************************************************
+* Method: waitForNextFrame
+* Description: Returns when the next frame is due, and schedules the
+*  one after it
+**********************************************************************/
+void FramePacer::waitForNextFrame()
+{
+   long long now = getNow();
+   if (m_deadline == 0)
+      m_deadline = now;
+
+   if (now < m_deadline)
+   {
+      if (m_deadline - now > SPIN_NANOSECONDS)
+         sleepUntil(m_deadline - SPIN_NANOSECONDS);
+
+      while ((now = getNow()) < m_deadline)
+         ;
+   }
+
+   record(now, now - m_deadline);
+
+   m_deadline += m_period;
+   if (m_deadline <= now)
+   {
+      m_missed++;
+      m_deadline = now + m_period;
+   }
+}
+
+/**********************************************************************
+* Method: record
+* Description: Adds a frame to the stats. The interval's mean and
+*  spread are kept with Welford's method, which doesn't lose precision
+*  over a long run.
+**********************************************************************/
+void FramePacer::record(long long start, long long lateness)
+{
+   if (m_frames > 0)
+   {
+      long long interval = start - m_lastFrame;
+
+      m_intervals++;
+      double delta = interval - m_mean;
+      m_mean += delta / m_intervals;
+      m_sumSquares += delta * (interval - m_mean);
+
+      if (m_intervals == 1 || interval < m_minInterval)
+         m_minInterval = interval;
+      if (interval > m_maxInterval)
+         m_maxInterval = interval;
+   }
+
+   if (lateness > m_maxLateness)
+      m_maxLateness = lateness;
+
+   m_lastFrame = start;
+   m_frames++;
+}
+
+/**********************************************************************
+* Method: getStats
+* Description: How steady the frames have been since the stats were
+*  last reset
+**********************************************************************/
+FrameStats FramePacer::getStats() const
+{
+   FrameStats stats;
+   stats.frames = m_frames;
+   stats.meanInterval = m_mean / 1e9;
+   stats.jitter = m_intervals > 1 ?
+      sqrt(m_sumSquares / (m_intervals - 1)) / 1e9 : 0.0;
+   stats.minInterval = m_minInterval / 1e9;
+   stats.maxInterval = m_maxInterval / 1e9;
+   stats.maxLateness = m_maxLateness / 1e9;
+   stats.missed = m_missed;
+   return stats;
+}
+
+/**********************************************************************
+* Method: resetStats
+* Description: Starts the stats over from the next frame
+**********************************************************************/
+void FramePacer::resetStats()
+{
+   m_frames = 0;
+   m_intervals = 0;
+   m_mean = 0;
+   m_sumSquares = 0;
+   m_minInterval = 0;
+   m_maxInterval = 0;
+   m_maxLateness = 0;
+   m_missed = 0;
+}
@@ -0,0 +1,82 @@
+/*************************************************************
+* File: framePacer.h
+* Author: Matthew Burr
+*
+* Description: Contains the declaration of the FramePacer,
+*  which keeps frames to a steady rate by the wall clock.
+*************************************************************/
+
+#ifndef framePacer_h
+#define framePacer_h
+
+#define DEFAULT_FRAMES_PER_SECOND 30.0
+
+/*****************************************
+* FRAME STATS
+* How steady the frames have been, in
+* seconds
+*****************************************/
+struct FrameStats
+{
+   int frames;            // frames started
+   double meanInterval;   // from the start of one frame to the next
+   double jitter;         // standard deviation of the interval
+   double minInterval;
+   double maxInterval;
+   double maxLateness;    // latest a frame started after it was due
+   int missed;            // frames a whole period or more late
+};
+
+/*****************************************
+* FRAME PACER
+* Frames are due a fixed period apart on
+* the monotonic clock. Waiting for one
+* sleeps until just before it is due and
+* spins for the last fraction of a
+* millisecond, which the OS can't be
+* trusted to wake us for on time.
+*
+* Each deadline is set from the last
+* deadline, not from when the frame
+* actually started, so a late wake-up
+* doesn't push every later frame back.
+* Fall a whole period behind, though,
+* and the schedule starts over from now
+* rather than rushing to catch up.
+*****************************************/
+class FramePacer
+{
+public:
+   FramePacer(double in_framesPerSecond = DEFAULT_FRAMES_PER_SECOND);
+
+   void setFramesPerSecond(double in_framesPerSecond);
+   double getPeriod() const { return m_period / 1e9; }
+
+   bool isTimeToDraw() const;
+   double getTimeToNextFrame() const;
+   void waitForNextFrame();
+
+   FrameStats getStats() const;
+   void resetStats();
+
+   static long long getNow();
+
+private:
+   long long m_period;     // all times in nanoseconds
+   long long m_deadline;
+   long long m_lastFrame;
+
+   int m_frames;
+   int m_intervals;
+   double m_mean;
+   double m_sumSquares;    // of differences from the mean
+   long long m_minInterval;
+   long long m_maxInterval;
+   long long m_maxLateness;
+   int m_missed;
+
+   void record(long long start, long long lateness);
+   static void sleepUntil(long long time);
+};
+
+#endif /* framePacer_h */
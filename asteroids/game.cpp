@@ -11,36 +11,100 @@
 #include "uiInteract.h"
 #include "point.h"
 #include "uiDraw.h"
+#include "random.h"
 #include "flyingObject.h"
 #include <cassert>
 #include <sstream>
-// These are needed for the getClosestDistance function...
-#include <limits>
 #include <algorithm>
 #include <vector>
-#include <list>
+#include <cmath>
+#include <chrono>
+#include <cstring>
+#include "entityStore.h"
+#include "bulletRing.h"
+#include "spatialGrid.h"
+#include "sweepAndPrune.h"
+#include "taskPool.h"
+#include "collision.h"
+#include "snapshot.h"
+#include "stateHash.h"
 
 #define MISS 0
 #define HIT 1
+#define NO_ROCK -1
+#define DETECT_GRAIN 64   // bullets per chunk when finding hits
 #define SCORE_X_OFFSET 5
 #define SCORE_Y_OFFSET -20
 #define LIVES_X_OFFSET SCORE_X_OFFSET
 #define LIVES_Y_OFFSET (SCORE_Y_OFFSET - 20)
 #define MAX_LIVES 3
 #define DEFAULT_INVULNERBILITY_TIME 100
-#define START_ROCK_COUNT 5
 #define MIN_ANGLE 0
 #define MAX_ANGLE 360
+#define GRID_CELL_SIZE BIG_ROCK_SIZE
 using namespace std;
 
+/*****************************************
+* PHASE TIMER
+* Charges the time since its last lap to
+* one field of a FrameProfile, and the
+* allocations since, if it counts them, to
+* another. With no profile it never reads
+* the clock.
+*****************************************/
+class PhaseTimer
+{
+public:
+   PhaseTimer(FrameProfile * in_profile) : m_profile(in_profile),
+      m_allocations(0)
+   {
+      if (!m_profile)
+         return;
+
+      m_start = chrono::steady_clock::now();
+      if (m_profile->allocationCount)
+         m_allocations = *m_profile->allocationCount;
+   }
+
+   void lap(double FrameProfile::*phase,
+      long FrameProfile::*allocations)
+   {
+      if (!m_profile)
+         return;
+
+      chrono::steady_clock::time_point now = chrono::steady_clock::now();
+      m_profile->*phase = chrono::duration<double>(now - m_start).count();
+      m_start = now;
+
+      if (m_profile->allocationCount)
+      {
+         long count = *m_profile->allocationCount;
+         m_profile->*allocations = count - m_allocations;
+         m_allocations = count;
+      }
+   }
+
+private:
+   FrameProfile * m_profile;
+   chrono::steady_clock::time_point m_start;
+   long m_allocations;
+};
+
 /**********************************************************************
  * Method: Game
  * Description: Creates a new instance of Game
  **********************************************************************/
-Game::Game(Point tl, Point br)
-   : m_topLeft(tl), m_bottomRight(br), m_lives(MAX_LIVES)
+Game::Game(Point tl, Point br, int in_rockCount, int in_bulletCapacity,
+   unsigned long long in_seed)
+   : m_topLeft(tl), m_bottomRight(br), m_bullets(in_bulletCapacity),
+   m_restoredBullets(in_bulletCapacity), m_newRocks(0), m_newBullets(0),
+   m_lives(MAX_LIVES), m_rockCount(in_rockCount),
+   m_broadPhase(BROAD_PHASE_GRID), m_profile(NULL), m_random(in_seed),
+   m_drawRandom(m_random.split())
 {
-   FlyingObject::setBoundaries(tl, br);
+   m_ship.setBoundaries(tl, br);
+   m_rockGrid.setBounds(tl, br, GRID_CELL_SIZE);
+   m_rockSweep.setBounds(tl, br);
    m_score = 0;
    
    initializeRocks();
@@ -56,13 +120,6 @@ Game::Game(Point tl, Point br)
  **********************************************************************/
 Game::~Game()
 {
-   // Delete all rock pointers
-   for (list<Rock*>::iterator it = m_rocks.begin();
-      it != m_rocks.end(); ++it)
-   {
-      delete *it;
-      *it = NULL;
-   }
 }
 
 /**********************************************************************
@@ -71,28 +128,207 @@ Game::~Game()
  **********************************************************************/
 void Game::advance()
 {
+   PhaseTimer timer(m_profile);
+
    advanceRocks();
+   timer.lap(&FrameProfile::advanceRocks,
+      &FrameProfile::advanceRocksAllocations);
 
    advanceBullets();
+   timer.lap(&FrameProfile::advanceBullets,
+      &FrameProfile::advanceBulletsAllocations);
+
+   advanceShip();
+   timer.lap(&FrameProfile::advanceShip,
+      &FrameProfile::advanceShipAllocations);
+
+   handleCollisions();
+   timer.lap(&FrameProfile::handleCollisions,
+      &FrameProfile::handleCollisionsAllocations);
+
+   cleanupZombies();
+   timer.lap(&FrameProfile::cleanupZombies,
+      &FrameProfile::cleanupZombiesAllocations);
+}
 
+/**********************************************************************
+ * Method: advanceShip
+ * Description: Advances the ship, or brings it back if it has died
+ *  and there are lives left
+ **********************************************************************/
+void Game::advanceShip()
+{
    // If the ship is alive, we advance it.
    // If it's dead, we see if we should revive it (i.e. if
    // we haven't heard our limit on deaths, we'll create it
    // anew
    if (m_ship.isAlive())
+   {
+      m_shipStep = m_ship.getVelocity();
       m_ship.advance();
+   }
    else
    {
       if (m_lives > 0)
       {
          m_ship = Ship();
+         m_ship.setBoundaries(m_topLeft, m_bottomRight);
          m_ship.setInvulnerable(DEFAULT_INVULNERBILITY_TIME);
+         m_shipStep = Velocity();
       }
    }
+}
 
-   handleCollisions();
+/**********************************************************************
+* Method: isOver
+* Description: True once the last ship is gone. Clearing the rocks
+*  doesn't end a game; a new set comes in.
+**********************************************************************/
+bool Game::isOver() const
+{
+   return m_lives <= 0 && !m_ship.isAlive();
+}
 
-   cleanupZombies();
+/**********************************************************************
+* Method: getStateHash
+* Description: Puts together the hashes the rocks and bullets keep with
+*  the ship's, the score and the lives
+**********************************************************************/
+unsigned long long Game::getStateHash() const
+{
+   unsigned long long hash = hashCombine(m_rocks.getHash(),
+      m_bullets.getHash());
+   hash = hashCombine(hash, m_ship.getHash());
+   return hashCombine(hash,
+      (unsigned long long)(unsigned)m_score << 32 | (unsigned)m_lives);
+}
+
+/**********************************************************************
+* Method: saveSnapshot
+* Description: Writes the game out as a snapshot, replacing whatever
+*  the buffer held. The grid, the sorted lists and the other scratch
+*  space are rebuilt from the rocks, so they're left out.
+**********************************************************************/
+void Game::saveSnapshot(vector<unsigned char> &out_snapshot) const
+{
+   out_snapshot.clear();
+   SnapshotWriter out(out_snapshot);
+
+   out.write((unsigned)SNAPSHOT_MAGIC);
+   out.write((int)SNAPSHOT_VERSION);
+   size_t sizeOffset = out.getSize();
+   out.write((unsigned)0);                  // filled in at the end
+
+   out.write(m_topLeft.getX());
+   out.write(m_topLeft.getY());
+   out.write(m_bottomRight.getX());
+   out.write(m_bottomRight.getY());
+   out.write(m_score);
+   out.write(m_lives);
+   out.write(m_rockCount);
+   out.write(m_shipStep.getDx());
+   out.write(m_shipStep.getDy());
+   out.write(m_newRocks);
+   out.write(m_newBullets);
+
+   m_random.save(out);
+   m_drawRandom.save(out);
+   m_ship.save(out);
+   m_rocks.save(out);
+   m_bullets.save(out);
+
+   unsigned size = (unsigned)out.getSize();
+   memcpy(&out_snapshot[sizeOffset], &size, sizeof(size));
+}
+
+/**********************************************************************
+* Method: restoreSnapshot
+* Description: Makes this game the one a snapshot was taken of. Returns
+*  false, leaving the game as it was, for anything that isn't a whole,
+*  sound snapshot of this version. Everything is read into copies
+*  first and only takes the game's place once all of it has read.
+**********************************************************************/
+bool Game::restoreSnapshot(const unsigned char * in_snapshot,
+   size_t in_size)
+{
+   SnapshotReader in(in_snapshot, in_size);
+
+   unsigned magic = 0;
+   int version = 0;
+   unsigned size = 0;
+   in.read(magic);
+   in.read(version);
+   in.read(size);
+   if (!in.isOk() || magic != SNAPSHOT_MAGIC ||
+       version != SNAPSHOT_VERSION || size != in_size)
+      return false;
+
+   float left, top, right, bottom, dx, dy;
+   int score, lives, rockCount, newRocks, newBullets;
+   in.read(left);
+   in.read(top);
+   in.read(right);
+   in.read(bottom);
+   in.read(score);
+   in.read(lives);
+   in.read(rockCount);
+   in.read(dx);
+   in.read(dy);
+   in.read(newRocks);
+   in.read(newBullets);
+
+   Random random = m_random;
+   Random drawRandom = m_drawRandom;
+   Ship ship = m_ship;
+   random.restore(in);
+   drawRandom.restore(in);
+   ship.restore(in);
+   if (!in.isOk())
+      return false;
+
+   if (!m_restoredRocks.restore(in) || !m_restoredBullets.restore(in) ||
+       in.getRemaining() != 0)
+      return false;
+
+   // A rock's type picks its archetype
+   for (int i = 0; i < m_restoredRocks.size(); i++)
+      if (m_restoredRocks.getType(i) >= ROCK_KINDS)
+         return false;
+   if (newRocks < 0 || newRocks > m_restoredRocks.size() ||
+       newBullets < 0 || newBullets > m_restoredBullets.size())
+      return false;
+
+   Point topLeft(left, top);
+   Point bottomRight(right, bottom);
+   if (topLeft.getX() != m_topLeft.getX() ||
+       topLeft.getY() != m_topLeft.getY() ||
+       bottomRight.getX() != m_bottomRight.getX() ||
+       bottomRight.getY() != m_bottomRight.getY())
+   {
+      m_topLeft = topLeft;
+      m_bottomRight = bottomRight;
+      m_rockGrid.setBounds(topLeft, bottomRight, GRID_CELL_SIZE);
+      m_rockSweep.setBounds(topLeft, bottomRight);
+   }
+
+   m_score = score;
+   m_lives = lives;
+   m_rockCount = rockCount;
+   m_shipStep = Velocity(dx, dy);
+   m_newRocks = newRocks;
+   m_newBullets = newBullets;
+   m_random = random;
+   m_drawRandom = drawRandom;
+   m_ship = ship;
+   m_ship.setBoundaries(m_topLeft, m_bottomRight);
+   m_rocks.swap(m_restoredRocks);
+   m_bullets.swap(m_restoredBullets);
+
+   // The sorted lists follow the rocks from frame to frame; these are
+   // different rocks
+   m_rockSweep.clear();
+
+   return true;
 }
 
 /**********************************************************************
@@ -107,51 +343,25 @@ void Game::cleanupZombies()
 
 /**********************************************************************
  * Method: cleanupBullets
- * Description: Removes any dead bullets
+ * Description: Removes spent bullets from the front of the ring
  **********************************************************************/
 void Game::cleanupBullets()
 {
-   list<Bullet>::iterator it = m_bullets.begin();
-   while (it != m_bullets.end())
-   {
-      if (it->isAlive())
-      {
-         ++it;
-      }
-      else
-      {
-         it = m_bullets.erase(it);
-      }
-   }
+   m_bullets.removeDead();
 }
 
 /**********************************************************************
 * Method: cleanupRocks
-* Description: Removes any dead or null rocks
+* Description: Removes any dead rocks
 **********************************************************************/
 void Game::cleanupRocks()
 {
-   list<Rock*>::iterator it = m_rocks.begin();
-
-   while (it != m_rocks.end())
-   {
-      Rock* pRock = *it;
+   // Fragments hit on the tick they broke off go, too
+   for (int i = m_rocks.size() - m_newRocks; i < m_rocks.size(); i++)
+      if (!m_rocks.isAlive(i))
+         m_newRocks--;
 
-      if (pRock != NULL && pRock->isAlive())
-      {
-         ++it;
-      }
-      else
-      {
-         if (pRock != NULL)
-         {
-            delete pRock;
-            pRock = NULL;
-         }
-
-         it = m_rocks.erase(it);
-      }
-   }
+   m_rocks.removeDead();
 }
 
 /**********************************************************************
@@ -160,15 +370,80 @@ void Game::cleanupRocks()
 **********************************************************************/
 void Game::initializeRocks()
 {
-   for (int i = 0; i < START_ROCK_COUNT; i++)
-   {
-      Point startPoint = getRandomPoint(m_topLeft, m_bottomRight);
-      float angle = random(MIN_ANGLE, MAX_ANGLE);
+   if (m_rockCount <= 0)
+      return;
+
+   m_rocks.reserve(m_rockCount);
+
+   // Draw everything the new rocks need in one go
+   vector<float> xs(m_rockCount);
+   vector<float> ys(m_rockCount);
+   vector<int> angles(m_rockCount);
+   m_random.fill(&xs[0], m_rockCount, m_topLeft.getX(), m_bottomRight.getX());
+   m_random.fill(&ys[0], m_rockCount, m_bottomRight.getY(), m_topLeft.getY());
+   m_random.fill(&angles[0], m_rockCount, MIN_ANGLE, MAX_ANGLE);
 
-      m_rocks.push_back(new BigRock(startPoint, angle));
+   for (int i = 0; i < m_rockCount; i++)
+   {
+      BigRock rock(Point(xs[i], ys[i]), angles[i]);
+      addRock(rock.getType(), rock.getPoint(), rock.getVelocity());
    }
 }
 
+/**********************************************************************
+* Method: addRock
+* Description: Adds a new rock of a given kind to the rock store
+**********************************************************************/
+void Game::addRock(EntityType type, const Point & point,
+   const Velocity & velocity)
+{
+   m_rocks.add(type, point, velocity, getRockRadius(type),
+      getRockSpin(type), 0 /*life*/);
+   m_newRocks++;
+
+   // Fragments created during the collision pass have to be findable
+   // by the objects that are checked after them
+   if (m_broadPhase == BROAD_PHASE_GRID)
+      insertRockInGrid(m_rocks.size() - 1);
+   else if (m_broadPhase == BROAD_PHASE_SWEEP_AND_PRUNE)
+      m_rockSweep.add(m_rocks, m_rocks.size() - 1);
+}
+
+/**********************************************************************
+* Method: setBroadPhase
+* Description: Chooses how collisions find their candidate rocks. The
+*  sorted lists are only kept up to date while they're in use, so
+*  switching away from them throws them out.
+**********************************************************************/
+void Game::setBroadPhase(BroadPhase in_broadPhase)
+{
+   m_broadPhase = in_broadPhase;
+   m_rockSweep.clear();
+}
+
+/**********************************************************************
+* Method: buildRockGrid
+* Description: Buckets every rock into the spatial grid
+**********************************************************************/
+void Game::buildRockGrid()
+{
+   m_rockGrid.clear();
+
+   for (int i = 0; i < m_rocks.size(); i++)
+      insertRockInGrid(i);
+}
+
+/**********************************************************************
+* Method: insertRockInGrid
+* Description: Buckets a single rock into the spatial grid
+**********************************************************************/
+void Game::insertRockInGrid(int index)
+{
+   m_rockGrid.insert(index, m_rocks.getX(index), m_rocks.getY(index),
+      getSweptReach(m_rocks.getDx(index), m_rocks.getDy(index),
+      m_rocks.getRadius(index)));
+}
+
 /**********************************************************************
  * Method: advanceRocks
  * Description: Advances the rocks.
@@ -180,12 +455,8 @@ void Game::advanceRocks()
    if (m_rocks.size() <= 0)
       initializeRocks();
 
-   for (list<Rock*>::iterator rock = m_rocks.begin();
-      rock != m_rocks.end(); ++rock)
-   {
-      if (*rock != NULL)
-         (*rock)->advance();
-   }
+   m_rocks.advance(m_topLeft, m_bottomRight, &m_pool);
+   m_newRocks = 0;
 }
 
 /**********************************************************************
@@ -194,142 +465,263 @@ void Game::advanceRocks()
  **********************************************************************/
 void Game::advanceBullets()
 {
-   for (list<Bullet>::iterator it = m_bullets.begin();
-      it != m_bullets.end(); ++it)
-      it->advance();
+   m_bullets.advance(m_topLeft, m_bottomRight, &m_pool);
+   m_newBullets = 0;
 }
 
 /**********************************************************************
 * Method: HANDLE COLLISIONS
 * Description: Checks to see if any collisions occurred and takes
-* care of them.
+* care of them. Finding the bullets' hits only reads the rocks, so
+* that is split between threads; the hits are then applied one
+* bullet at a time, in order, exactly as if each bullet had been
+* checked and resolved in turn.
 **********************************************************************/
  void Game::handleCollisions()
  {
+    if (m_broadPhase == BROAD_PHASE_GRID)
+       buildRockGrid();
+    else if (m_broadPhase == BROAD_PHASE_SWEEP_AND_PRUNE)
+       m_rockSweep.update(m_rocks);
+
     // If there are any bullets, check to see if they collided
     // We check bullets first to give the user a slight advantage
     // as we might destroy a rock just moments before the ship hits it
-    for (list<Bullet>::iterator it = m_bullets.begin();
-       it != m_bullets.end(); ++it)
-    {
-       if (HIT == handleCollisions(*it))
-          m_score++;
-    }
+    m_candidates.resize(m_pool.getThreadCount());
+    m_firstHits.resize(m_bullets.size());
+    m_pool.parallelFor(m_bullets.size(), DETECT_GRAIN, detectBulletHits,
+       this);
+    resolveBulletHits();
 
     // If the ship is dead, the game is over and this no longer
     // matters
 #ifndef INVINCIBLE
     if (m_ship.isAlive())
     {
-       if (HIT == handleCollisions(m_ship) && m_lives > 0)
-          m_lives--;
+       if (HIT == handleCollisions(m_ship.getPoint(), m_ship.getVelocity(),
+          m_ship.getRadius()))
+       {
+          m_ship.kill();
+          if (m_lives > 0)
+             m_lives--;
+       }
     }
 #endif
 
  }
 
  /**********************************************************************
- * Method: HANDLE COLLISIONS
- * Description: Checks to see if any collisions occurred between a
- * specific flying object and all of the rocks on screen
+ * Method: detectBulletHits
+ * Description: Finds the first rock each of bullets [begin, end) hits,
+ * as things stand before any of them is resolved. Runs on the pool's
+ * threads, so it must not change anything but its own bullets'
+ * entries in the list of first hits.
  **********************************************************************/
- int Game::handleCollisions(FlyingObject & obj)
+ void Game::detectBulletHits(void * context, int thread, int begin, int end)
  {
-    // We're going to iterate through our rocks and check each one
-    // to see if it collides with the object (obj)
-    list<Rock*>::iterator it = m_rocks.begin();
+    Game & game = *(Game *)context;
 
-    while (it != m_rocks.end())
+    for (int i = begin; i < end; i++)
     {
-       Rock* pRock = *it;
+       if (!game.m_bullets.isFlying(i))
+          game.m_firstHits[i] = NO_ROCK;
+       else
+          game.m_firstHits[i] = game.findFirstHit(game.m_bullets.getPoint(i),
+             game.m_bullets.getVelocity(i), game.m_bullets.getRadius(i),
+             game.m_candidates[thread]);
+    }
+ }
 
-       // We really shouldn't have any null pointers, but just in case
-       // we skip over the rock and move on to the next; such NULL
-       // rocks can be cleaned up in the cleanupRocks
-       assert(pRock != NULL);
-       if (pRock == NULL)
-       {
-          ++it;
+ /**********************************************************************
+ * Method: resolveBulletHits
+ * Description: Applies the hits found by detectBulletHits in bullet
+ * order. A bullet hits the lowest numbered live rock in its path, so:
+ *  - if the first rock it was found to hit is still alive, that's it;
+ *  - if an earlier bullet got there first, it is checked again from
+ *    scratch;
+ *  - if it hit nothing, only the fragments made by earlier bullets
+ *    can be in its way.
+ **********************************************************************/
+ void Game::resolveBulletHits()
+ {
+    int rocksBefore = m_rocks.size();
+
+    for (int i = 0; i < m_bullets.size(); i++)
+    {
+       int rock = m_firstHits[i];
+       if (rock == NO_ROCK && !m_bullets.isFlying(i))
           continue;
-       }
 
-       // Now, we get the closest distance and we check to see if it is
-       // within the sum of the radii of the rock and the object
-       float closestDistance = getClosestDistance(obj, *pRock);
+       Point point = m_bullets.getPoint(i);
+       Velocity velocity = m_bullets.getVelocity(i);
+       float radius = m_bullets.getRadius(i);
 
-       if (closestDistance <= (obj.getRadius() + pRock->getRadius()))
-       {
-          // If it is, we kill the object - bye bye!!
-          obj.kill();
-
-          // Then, we hit the rock, which kills it and will possibly break it into
-          // fragments, which we add just before the current rock
-          // (i.e. the rock we just hit)
-          list<Rock*> * frags = pRock->hit();
-          if (NULL != frags)
-          {
-             // By adding these before the current rock, we avoid
-             // problems with our iterator; plus, we're using a 
-             // list, so we can safely do this
-             m_rocks.splice(it, *frags);
-             delete frags;
-             frags = NULL;
-          }
-
-          // And exit because we can only collide with an object once
-          return HIT;
-       }
-       else
+       if (rock == NO_ROCK)
+          rock = findFirstHit(point, velocity, radius, rocksBefore);
+       else if (!m_rocks.isAlive(rock))
+          rock = findFirstHit(point, velocity, radius, m_candidates[0]);
+
+       if (rock != NO_ROCK)
        {
-          ++it;
+          hitRock(rock);
+          m_bullets.kill(i);
+          m_score++;
        }
     }
+ }
+
+ /**********************************************************************
+ * Method: HANDLE COLLISIONS
+ * Description: Checks to see if any collisions occurred between a
+ * specific flying object (given by its point, velocity and radius)
+ * and all of the rocks on screen
+ **********************************************************************/
+ int Game::handleCollisions(const Point & point, const Velocity & velocity,
+    float radius)
+ {
+    int rock = findFirstHit(point, velocity, radius, m_candidates[0]);
+    if (rock == NO_ROCK)
+       return MISS;
+
+    // If it is, we hit the rock, which kills it and will possibly
+    // break it into fragments. We can only collide with one rock.
+    hitRock(rock);
+    return HIT;
+ }
+
+ /**********************************************************************
+ * Method: findFirstHit
+ * Description: Finds the lowest numbered live rock an object collides
+ * with, or NO_ROCK. The broad phases find candidates in no particular
+ * order, so we keep the lowest that collides and get the same rock
+ * the brute force search would.
+ **********************************************************************/
+ int Game::findFirstHit(const Point & point, const Velocity & velocity,
+    float radius, vector<int> & candidates) const
+ {
+    if (m_broadPhase == BROAD_PHASE_BRUTE_FORCE)
+       return findFirstHit(point, velocity, radius, 0 /*first*/);
+
+    float reach = getSweptReach(velocity.getDx(), velocity.getDy(), radius);
+    candidates.clear();
+    if (m_broadPhase == BROAD_PHASE_GRID)
+       m_rockGrid.query(point, reach, candidates);
+    else
+       m_rockSweep.query(point, reach, candidates);
+
+    int first = NO_ROCK;
+    for (vector<int>::const_iterator it = candidates.begin();
+       it != candidates.end(); ++it)
+    {
+       if ((first == NO_ROCK || *it < first) &&
+          isCollision(*it, point, velocity, radius))
+          first = *it;
+    }
 
-    return MISS;
+    return first;
+ }
+
+ /**********************************************************************
+ * Method: findFirstHit
+ * Description: Checks rocks from a given one on, one at a time, for
+ * the first live rock an object collides with
+ **********************************************************************/
+ int Game::findFirstHit(const Point & point, const Velocity & velocity,
+    float radius, int first) const
+ {
+    for (int i = first; i < m_rocks.size(); i++)
+    {
+       if (isCollision(i, point, velocity, radius))
+          return i;
+    }
+
+    return NO_ROCK;
+ }
+
+ /**********************************************************************
+ * Method: isCollision
+ * Description: True if an object collides with a given rock
+ **********************************************************************/
+ bool Game::isCollision(int rock, const Point & point,
+    const Velocity & velocity, float radius) const
+ {
+    // A rock that was already hit this frame has been replaced by
+    // its fragments, so it can't be hit again
+    if (!m_rocks.isAlive(rock))
+       return false;
+
+    // Now, we check to see if the closest they got is within the sum
+    // of the radii of the rock and the object
+    return isSweptCollision(point, velocity,
+       m_rocks.getPoint(rock), m_rocks.getVelocity(rock),
+       radius + m_rocks.getRadius(rock));
+ }
+
+ /**********************************************************************
+ * Method: hitRock
+ * Description: Hits a rock, killing it and adding any fragments it
+ * breaks into to the end of the rock store
+ **********************************************************************/
+ void Game::hitRock(int index)
+ {
+    RockFragment frags[MAX_ROCK_FRAGMENTS];
+
+    m_rocks.kill(index);
+
+    // The archetype table knows how each kind of rock breaks apart
+    int fragCount = getRockFragments(m_rocks.getType(index),
+       m_rocks.getPoint(index), m_rocks.getVelocity(index), frags);
+
+    assert(fragCount <= MAX_ROCK_FRAGMENTS);
+    for (int i = 0; i < fragCount; i++)
+       addRock(frags[i].type, frags[i].point, frags[i].velocity);
  }
 
  /**********************************************************************
  * Method: handleInput
  * Description: Handles user input
  **********************************************************************/
-void Game::handleInput(const Interface &pUI)
+void Game::handleInput(const GameInput &input)
 {
    if (!m_ship.isAlive())
       return;
 
-   if (pUI.isRight())
+   if (input.right)
    {
       m_ship.rotateRight();
    }
 
-   if (pUI.isLeft())
+   if (input.left)
    {
       m_ship.rotateLeft();
    }
 
-   if (pUI.isUp())
+   if (input.up)
    {
       m_ship.thrust();
    }
 
-   if (pUI.isSpace())
+   if (input.fire)
    {
-      m_bullets.push_back(m_ship.fire());
+      m_bullets.add(m_ship.fire());
+      m_newBullets++;
    }
 }
 
 /**********************************************************************
  * Method: draw
- * Description: Draws game objects on the screen
+ * Description: Draws game objects on the screen, alpha of the way from
+ *  where they were on the last tick to where they are now
  **********************************************************************/
-void Game::draw(const Interface &pUI)
+void Game::draw(float in_alpha)
 {
    if (m_ship.isAlive())
-      m_ship.draw();
+      m_ship.draw(getBlendedPoint(m_ship.getPoint(), m_shipStep, in_alpha),
+         m_drawRandom.getInt(0, SHIP_FLAME_COUNT));
 
-   drawBullets();
+   drawBullets(in_alpha);
 
-   drawRocks();
+   drawRocks(in_alpha);
 
    drawScore();
 
@@ -340,22 +732,50 @@ void Game::draw(const Interface &pUI)
  * Method: drawRocks
  * Description: Draws rocks
  **********************************************************************/
-void Game::drawRocks()
+void Game::drawRocks(float in_alpha)
 {
-   for (list<Rock*>::iterator rock = m_rocks.begin();
-      rock != m_rocks.end(); ++rock)
-      (*rock)->draw();
+   int firstNew = m_rocks.size() - m_newRocks;
+   for (int i = 0; i < m_rocks.size(); i++)
+      drawRock(m_rocks.getType(i),
+         getBlendedPoint(m_rocks.getPoint(i),
+            i < firstNew ? m_rocks.getVelocity(i) : Velocity(), in_alpha),
+         m_rocks.getRotation(i));
 }
 
 /**********************************************************************
  * Method: drawBullets
  * Description: Draws bullets
  **********************************************************************/
-void Game::drawBullets()
+void Game::drawBullets(float in_alpha)
 {
-   for (list<Bullet>::iterator bullet = m_bullets.begin();
-      bullet != m_bullets.end(); ++bullet)
-      bullet->draw();
+   int firstNew = m_bullets.size() - m_newBullets;
+   for (int i = 0; i < m_bullets.size(); i++)
+      if (m_bullets.isAlive(i))
+         drawDot(getBlendedPoint(m_bullets.getPoint(i),
+            i < firstNew ? m_bullets.getVelocity(i) : Velocity(), in_alpha));
+}
+
+/**********************************************************************
+* Method: getBlendedPoint
+* Description: Where an object appears partway through a tick. The
+*  display runs up to a tick behind: alpha 0 shows the object where it
+*  was before the last tick and 1 where it is now. Every object moved
+*  by one step on the last tick, so it is drawn that step back from
+*  where it is, less alpha of it. One added since, such as a bullet
+*  just fired or a fragment just broken off, hasn't moved yet and is
+*  given no step, so it starts where it is. An object
+*  that wrapped is drawn just outside the edge it came in at, rather
+*  than partway across the screen.
+**********************************************************************/
+Point Game::getBlendedPoint(const Point & point, const Velocity & step,
+   float alpha)
+{
+   if (alpha >= 1.0f)
+      return point;
+
+   float back = 1.0f - alpha;
+   return Point(point.getX() - step.getDx() * back,
+                point.getY() - step.getDy() * back);
 }
 
 /**********************************************************************
@@ -399,49 +819,3 @@ Point Game::getLivesLocation() const
       m_topLeft.getY() + LIVES_Y_OFFSET
    );
 }
-
-/**************************************************************************
-* GAME :: GET RANDOM POINT
-* Gets a random point between two other points; think of the two points
-* defining a plane; this returns a random point somewhere on that plane
-**************************************************************************/
-Point Game::getRandomPoint(const Point & in_topLeft, const Point & in_bottomRight)
-{
-   assert(in_topLeft.getX() <= in_bottomRight.getX());
-   assert(in_bottomRight.getY() <= in_topLeft.getY());
-
-   // Choose random x and y coordinates and create a point from them
-   float x = random(in_topLeft.getX(), in_bottomRight.getX());
-   float y = random(in_bottomRight.getY(), in_topLeft.getY());
-   return Point(x, y);
-}
-
-// You may find this function helpful...
-
-/**********************************************************
- * Function: getClosestDistance
- * Description: Determine how close these two objects will
- *   get in between the frames.
- **********************************************************/
-float Game :: getClosestDistance(const FlyingObject &obj1, const FlyingObject &obj2) const
-{
-   // find the maximum distance traveled
-   float dMax = max(abs(obj1.getVelocity().getDx()), abs(obj1.getVelocity().getDy()));
-   dMax = max(dMax, abs(obj2.getVelocity().getDx()));
-   dMax = max(dMax, abs(obj2.getVelocity().getDy()));
-   dMax = max(dMax, 0.1f); // when dx and dy are 0.0. Go through the loop once.
-   
-   float distMin = std::numeric_limits<float>::max();
-   for (float i = 0.0; i <= dMax; i++)
-   {
-      Point point1(obj1.getPoint().getX() - (obj1.getVelocity().getDx() * i / dMax),
-                     obj1.getPoint().getY() - (obj1.getVelocity().getDy() * i / dMax));
-      Point point2(obj2.getPoint().getX() - (obj2.getVelocity().getDx() * i / dMax),
-                     obj2.getPoint().getY() - (obj2.getVelocity().getDy() * i / dMax));
-      
-      distMin = min(distMin, point1 - point2);
-   }
-   
-   return distMin;
-}
-
@@ -8,48 +8,184 @@
 #define GAME_H
 
 #include "uiInteract.h"
+#include "gameInput.h"
 #include "point.h"
-#include <list>
+#include "velocity.h"
+#include "entityStore.h"
+#include "bulletRing.h"
+#include "spatialGrid.h"
+#include "sweepAndPrune.h"
+#include "taskPool.h"
+#include "random.h"
 #include "rocks.h"
 #include "ship.h"
+#include <cstddef>
+#include <vector>
+
+#define START_ROCK_COUNT 5
+
+/*****************************************
+* BROAD PHASE
+* How the game finds which rocks to test
+* an object against. Every choice must
+* find the same hits in the same order.
+*****************************************/
+enum BroadPhase
+{
+   BROAD_PHASE_BRUTE_FORCE,
+   BROAD_PHASE_GRID,
+   BROAD_PHASE_SWEEP_AND_PRUNE
+};
+
+/*****************************************
+* FRAME PROFILE
+* How many seconds each phase of advance
+* took on the last frame. If whoever is
+* profiling counts its trips to the heap
+* and points allocationCount at the
+* count, each phase's share of them, too.
+*****************************************/
+struct FrameProfile
+{
+   FrameProfile() : allocationCount(NULL) {}
+
+   double advanceRocks;
+   double advanceBullets;
+   double advanceShip;
+   double handleCollisions;
+   double cleanupZombies;
+
+   const long * allocationCount;
+   long advanceRocksAllocations;
+   long advanceBulletsAllocations;
+   long advanceShipAllocations;
+   long handleCollisionsAllocations;
+   long cleanupZombiesAllocations;
+};
 
 class Game
 {
 public:
-   Game(Point tl, Point br);
+   Game(Point tl, Point br, int in_rockCount = START_ROCK_COUNT,
+      int in_bulletCapacity = MAX_BULLETS,
+      unsigned long long in_seed = DEFAULT_RANDOM_SEED);
    ~Game();
 
    void advance();
    
-   void handleInput(const Interface &pUI);
-   void draw(const Interface &pUI);
+   void handleInput(const GameInput &input);
+   void draw(float in_alpha = 1.0f);
+
+   // Reads the keys straight off the window; defined here so a build
+   // with no window system never needs the Interface
+   void handleInput(const Interface &pUI)
+   {
+      GameInput input = { pUI.isLeft() != 0, pUI.isRight() != 0,
+         pUI.isUp() != 0, pUI.isSpace() };
+      handleInput(input);
+   }
+
+   int getScore() const { return m_score; }
+   int getLives() const { return m_lives; }
+   int getRockCount() const { return m_rocks.size(); }
+   int getBulletCount() const { return m_bullets.getLiveCount(); }
+   bool isOver() const;
+   BroadPhase getBroadPhase() const { return m_broadPhase; }
+   void setBroadPhase(BroadPhase in_broadPhase);
+
+   // How many threads advance the rocks and bullets;
+   // TASK_POOL_ALL_CORES uses one per core
+   int getThreadCount() const { return m_pool.getThreadCount(); }
+   void setThreadCount(int in_threadCount)
+   {
+      m_pool.setThreadCount(in_threadCount);
+   }
+
+   // Times each phase of advance into the profile; NULL turns it off
+   void setProfile(FrameProfile * in_profile) { m_profile = in_profile; }
+
+   // A flat binary copy of everything that decides what happens next
+   // (see snapshot.h), to carry on from later in this game or another
+   void saveSnapshot(std::vector<unsigned char> &out_snapshot) const;
+   bool restoreSnapshot(const unsigned char * in_snapshot, size_t in_size);
+
+   // A hash of where everything is and how it is moving, the score and
+   // the lives, kept up to date as the game goes so it's cheap to take
+   // every tick. Two runs that hash differently have come apart.
+   unsigned long long getStateHash() const;
+
+   // For tools that look inside a game, such as one finding where two
+   // runs differ
+   const EntityStore & getRocks() const { return m_rocks; }
+   const BulletRing & getBullets() const { return m_bullets; }
+   const Ship & getShip() const { return m_ship; }
+
+   // For setting up a scene beyond what the game starts with
+   void addRock(EntityType type, const Point & point,
+      const Velocity & velocity);
+   // Every bullet lives BULLET_LIFE frames, so firing some number a
+   // frame needs a bullet capacity of that number times BULLET_LIFE
+   void addBullet(const Bullet & bullet)
+   {
+      m_bullets.add(bullet);
+      m_newBullets++;
+   }
 
 private:
    Point m_topLeft;
    Point m_bottomRight;
-   std::list<Rock*> m_rocks;
-   std::list<Bullet> m_bullets;
+   EntityStore m_rocks;
+   BulletRing m_bullets;
+   EntityStore m_restoredRocks;     // read into by restoreSnapshot, and
+   BulletRing m_restoredBullets;    // swapped in once all of it is sound
    Ship m_ship;
+   Velocity m_shipStep;    // how far the ship moved on the last tick
+   int m_newRocks;         // how many rocks and bullets at the ends of
+   int m_newBullets;       // their stores came after the last move
    int m_score;
    int m_lives;
+   int m_rockCount;
+   BroadPhase m_broadPhase;
+   SpatialGrid m_rockGrid;
+   SweepAndPrune m_rockSweep;
+   std::vector< std::vector<int> > m_candidates;   // one per thread
+   std::vector<int> m_firstHits;
+   TaskPool m_pool;
+   FrameProfile * m_profile;
    Point m_scoreLocation;
+   Random m_random;        // everything that happens in the game
+   Random m_drawRandom;    // only how it looks, such as the flames
 
    void initializeRocks();
    void advanceRocks();
    void advanceBullets();
+   void advanceShip();
    void handleCollisions();
-   int handleCollisions(FlyingObject & obj);
+   int handleCollisions(const Point & point, const Velocity & velocity,
+      float radius);
+   static void detectBulletHits(void * context, int thread, int begin,
+      int end);
+   void resolveBulletHits();
+   int findFirstHit(const Point & point, const Velocity & velocity,
+      float radius, std::vector<int> & candidates) const;
+   int findFirstHit(const Point & point, const Velocity & velocity,
+      float radius, int first) const;
+   bool isCollision(int rock, const Point & point, const Velocity & velocity,
+      float radius) const;
+   void buildRockGrid();
+   void insertRockInGrid(int index);
+   void hitRock(int index);
    void cleanupZombies();
    void cleanupBullets();
    void cleanupRocks();
-   void drawRocks();
-   void drawBullets();
+   void drawRocks(float in_alpha);
+   void drawBullets(float in_alpha);
    void drawScore() const;
    void drawLives() const;
    Point getScoreLocation() const;
    Point getLivesLocation() const;
-   static Point getRandomPoint(const Point & in_topLeft, const Point & in_bottomRight);
-   float getClosestDistance(const FlyingObject & obj1, const FlyingObject & obj2) const;
+   static Point getBlendedPoint(const Point & point, const Velocity & step,
+      float alpha);
 };
 
 
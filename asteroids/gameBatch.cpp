@@ -0,0 +1,108 @@
+/*************************************************************
+* File: gameBatch.cpp
+* Author: Matthew Burr
+*
+* Description: Contains the implementations of the
+*  method bodies for the GameBatch class.
+*************************************************************/
+
+#include "gameBatch.h"
+#include "game.h"
+#include "gameInput.h"
+#include "random.h"
+#include "taskPool.h"
+#include <cassert>
+using namespace std;
+
+#define STEP_GRAIN 4   // games per chunk when stepping
+
+/**********************************************************************
+* Method: GameBatch
+* Description: Creates a batch of new games, stepped on one thread per
+*  core until told otherwise
+**********************************************************************/
+GameBatch::GameBatch(int in_gameCount, const Point &in_topLeft,
+   const Point &in_bottomRight, int in_rockCount,
+   unsigned long long in_seed)
+   : m_topLeft(in_topLeft), m_bottomRight(in_bottomRight),
+   m_rockCount(in_rockCount), m_rewards(in_gameCount, 0),
+   m_dones(in_gameCount, 0), m_episodeCount(0),
+   m_pool(TASK_POOL_ALL_CORES), m_inputs(NULL)
+{
+   assert(in_gameCount > 0);
+
+   Random seeds(in_seed);
+   m_seeds.reserve(in_gameCount);
+   for (int i = 0; i < in_gameCount; i++)
+      m_seeds.push_back(seeds.split());
+
+   m_games.reserve(in_gameCount);
+   for (int i = 0; i < in_gameCount; i++)
+      m_games.push_back(newGame(i));
+}
+
+/**********************************************************************
+* Method: ~GameBatch
+* Description: Deletes every game
+**********************************************************************/
+GameBatch::~GameBatch()
+{
+   for (size_t i = 0; i < m_games.size(); i++)
+      delete m_games[i];
+}
+
+/**********************************************************************
+* Method: newGame
+* Description: Starts a game for one place in the batch, seeded from
+*  that place's own stream
+**********************************************************************/
+Game * GameBatch::newGame(int in_index)
+{
+   return new Game(m_topLeft, m_bottomRight, m_rockCount, MAX_BULLETS,
+      m_seeds[in_index].next());
+}
+
+/**********************************************************************
+* Method: step
+* Description: Steps every game a frame, one input each. The games
+*  share nothing, so the pool can take them in any order.
+**********************************************************************/
+void GameBatch::step(const GameInput * in_inputs)
+{
+   assert(in_inputs != NULL);
+
+   m_inputs = in_inputs;
+   m_pool.parallelFor(getGameCount(), STEP_GRAIN, stepGames, this);
+   m_inputs = NULL;
+
+   for (size_t i = 0; i < m_dones.size(); i++)
+      m_episodeCount += m_dones[i];
+}
+
+/**********************************************************************
+* Method: stepGames
+* Description: Steps games [begin, end), starting over any that finish.
+*  Runs on the pool's threads; each game is only touched by the thread
+*  stepping it.
+**********************************************************************/
+void GameBatch::stepGames(void * context, int thread, int begin, int end)
+{
+   GameBatch * batch = (GameBatch *)context;
+
+   for (int i = begin; i < end; i++)
+   {
+      Game * game = batch->m_games[i];
+      int score = game->getScore();
+
+      game->advance();
+      game->handleInput(batch->m_inputs[i]);
+
+      batch->m_rewards[i] = game->getScore() - score;
+      batch->m_dones[i] = game->isOver();
+      if (batch->m_dones[i])
+      {
+         delete game;
+         batch->m_games[i] = batch->newGame(i);
+      }
+   }
+}
@@ -0,0 +1,86 @@
+/*************************************************************
+* File: gameBatch.h
+* Author: Matthew Burr
+*
+* Description: Contains the declaration of the GameBatch, a
+*  set of independent games stepped together, for running
+*  many episodes at once (training a player, say).
+*************************************************************/
+
+#ifndef gameBatch_h
+#define gameBatch_h
+
+#include "game.h"
+#include "gameInput.h"
+#include "point.h"
+#include "random.h"
+#include "taskPool.h"
+#include <vector>
+
+/*****************************************
+* GAME BATCH
+* Holds a number of games, all the same
+* size, and steps every one of them a
+* frame with one call, spreading the games
+* between the threads of a pool (one per
+* core unless told otherwise). A game
+* that finishes is started over, with a
+* new seed, on the same step.
+*
+* Each game draws its seeds from a stream
+* of its own, so the games a batch plays
+* depend only on its seed and the inputs,
+* not on the number of threads.
+*****************************************/
+class GameBatch
+{
+public:
+   GameBatch(int in_gameCount, const Point &in_topLeft,
+      const Point &in_bottomRight, int in_rockCount = START_ROCK_COUNT,
+      unsigned long long in_seed = DEFAULT_RANDOM_SEED);
+   ~GameBatch();
+
+   // Advances game i a frame, then gives it in_inputs[i], as the
+   // driver and a replay do
+   void step(const GameInput * in_inputs);
+
+   int getGameCount() const { return (int)m_games.size(); }
+   const Game & getGame(int in_index) const { return *m_games[in_index]; }
+
+   // What happened to a game on the last step: the points it scored,
+   // and whether it finished (and so is now a new game)
+   int getReward(int in_index) const { return m_rewards[in_index]; }
+   bool isDone(int in_index) const { return m_dones[in_index] != 0; }
+
+   // Games finished since the batch was made
+   long long getEpisodeCount() const { return m_episodeCount; }
+
+   // How many threads step the games; TASK_POOL_ALL_CORES uses one
+   // per core
+   int getThreadCount() const { return m_pool.getThreadCount(); }
+   void setThreadCount(int in_threadCount)
+   {
+      m_pool.setThreadCount(in_threadCount);
+   }
+
+private:
+   Point m_topLeft;
+   Point m_bottomRight;
+   int m_rockCount;
+   std::vector<Game *> m_games;
+   std::vector<Random> m_seeds;           // one stream per game
+   std::vector<int> m_rewards;
+   std::vector<unsigned char> m_dones;    // not bool: threads write them
+   long long m_episodeCount;
+   TaskPool m_pool;
+   const GameInput * m_inputs;            // for the step being run
+
+   Game * newGame(int in_index);
+   static void stepGames(void * context, int thread, int begin, int end);
+
+   // A batch owns its games, so it can't be copied
+   GameBatch(const GameBatch &);
+   GameBatch & operator=(const GameBatch &);
+};
+
+#endif /* gameBatch_h */
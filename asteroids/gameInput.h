@@ -0,0 +1,52 @@
+/*************************************************************
+* File: gameInput.h
+* Author: Matthew Burr
+*
+* Description: Contains the GameInput, the controls the game
+*  reads each frame, kept apart from the window system so the
+*  game can be driven without one.
+*************************************************************/
+
+#ifndef gameInput_h
+#define gameInput_h
+
+/*****************************************
+* GAME INPUT
+* Which controls are held down this frame
+*****************************************/
+struct GameInput
+{
+   bool left;
+   bool right;
+   bool up;
+   bool fire;
+};
+
+// Each control's bit when the input is packed into a byte
+#define INPUT_LEFT  0x01
+#define INPUT_RIGHT 0x02
+#define INPUT_UP    0x04
+#define INPUT_FIRE  0x08
+
+/*****************************************
+* PACK INPUT
+* The controls held down as one byte
+*****************************************/
+inline unsigned char packInput(const GameInput &input)
+{
+   return (input.left ? INPUT_LEFT : 0) | (input.right ? INPUT_RIGHT : 0) |
+      (input.up ? INPUT_UP : 0) | (input.fire ? INPUT_FIRE : 0);
+}
+
+/*****************************************
+* UNPACK INPUT
+* The controls a packed byte stands for
+*****************************************/
+inline GameInput unpackInput(unsigned char keys)
+{
+   GameInput input = { (keys & INPUT_LEFT) != 0, (keys & INPUT_RIGHT) != 0,
+      (keys & INPUT_UP) != 0, (keys & INPUT_FIRE) != 0 };
+   return input;
+}
+
+#endif /* gameInput_h */
@@ -0,0 +1,141 @@
+/*************************************************************
+* File: hashLog.cpp
+* Author: Matthew Burr
+*
+* Description: Contains the implementations of the
+*  method bodies for the HashLog class.
+*************************************************************/
+
+#include "hashLog.h"
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+using namespace std;
+
+#define HEADER_SIZE 12    // magic, version and tick count
+#define HASH_SIZE 8
+
+/**********************************************************************
+* Function: writeBytes
+* Description: Appends the low bytes of a number, lowest first
+**********************************************************************/
+static void writeBytes(vector<unsigned char> &bytes, unsigned long long value,
+   int count)
+{
+   for (int i = 0; i < count; i++)
+      bytes.push_back((unsigned char)(value >> (i * 8)));
+}
+
+/**********************************************************************
+* Function: readBytes
+* Description: Takes a number of count bytes off the front of the
+*  bytes; the caller checks there are enough
+**********************************************************************/
+static unsigned long long readBytes(const unsigned char * &next, int count)
+{
+   unsigned long long value = 0;
+   for (int i = 0; i < count; i++)
+      value |= (unsigned long long)*next++ << (i * 8);
+   return value;
+}
+
+/**********************************************************************
+* Method: findDivergence
+* Description: Walks two logs side by side to the first tick they
+*  don't agree on
+**********************************************************************/
+int HashLog::findDivergence(const HashLog &in_first, const HashLog &in_second)
+{
+   int ticks = min(in_first.getTickCount(), in_second.getTickCount());
+   for (int tick = 0; tick < ticks; tick++)
+      if (in_first.m_hashes[tick] != in_second.m_hashes[tick])
+         return tick;
+
+   if (in_first.getTickCount() != in_second.getTickCount())
+      return ticks;
+
+   return NO_DIVERGENCE;
+}
+
+/**********************************************************************
+* Method: write
+* Description: Lays the log out as bytes, replacing what was there
+**********************************************************************/
+void HashLog::write(vector<unsigned char> &out_bytes) const
+{
+   out_bytes.clear();
+   out_bytes.reserve(HEADER_SIZE + m_hashes.size() * HASH_SIZE);
+
+   writeBytes(out_bytes, HASH_LOG_MAGIC, 4);
+   writeBytes(out_bytes, HASH_LOG_VERSION, 4);
+   writeBytes(out_bytes, m_hashes.size(), 4);
+   for (size_t i = 0; i < m_hashes.size(); i++)
+      writeBytes(out_bytes, m_hashes[i], HASH_SIZE);
+}
+
+/**********************************************************************
+* Method: read
+* Description: Takes the log back from bytes write laid out
+**********************************************************************/
+bool HashLog::read(const unsigned char * in_bytes, size_t in_size)
+{
+   clear();
+   if (in_size < HEADER_SIZE)
+      return false;
+
+   const unsigned char * next = in_bytes;
+   unsigned long long magic = readBytes(next, 4);
+   unsigned long long version = readBytes(next, 4);
+   unsigned long long ticks = readBytes(next, 4);
+   if (magic != HASH_LOG_MAGIC || version != HASH_LOG_VERSION ||
+       (in_size - HEADER_SIZE) / HASH_SIZE != ticks ||
+       (in_size - HEADER_SIZE) % HASH_SIZE != 0)
+      return false;
+
+   m_hashes.resize((size_t)ticks);
+   for (size_t i = 0; i < m_hashes.size(); i++)
+      m_hashes[i] = readBytes(next, HASH_SIZE);
+
+   return true;
+}
+
+/**********************************************************************
+* Method: save
+* Description: Writes the log to a file. Returns false if it can't.
+**********************************************************************/
+bool HashLog::save(const char * in_fileName) const
+{
+   vector<unsigned char> bytes;
+   write(bytes);
+
+   FILE *file = fopen(in_fileName, "wb");
+   if (file == NULL)
+      return false;
+
+   bool isWritten = fwrite(&bytes[0], 1, bytes.size(), file) == bytes.size();
+   return fclose(file) == 0 && isWritten;
+}
+
+/**********************************************************************
+* Method: load
+* Description: Reads a log from a file. Returns false if it can't, or
+*  the file doesn't hold a whole log.
+**********************************************************************/
+bool HashLog::load(const char * in_fileName)
+{
+   clear();
+
+   FILE *file = fopen(in_fileName, "rb");
+   if (file == NULL)
+      return false;
+
+   vector<unsigned char> bytes;
+   unsigned char buffer[4096];
+   size_t count;
+   while ((count = fread(buffer, 1, sizeof(buffer), file)) > 0)
+      bytes.insert(bytes.end(), buffer, buffer + count);
+   bool isRead = !ferror(file);
+   fclose(file);
+
+   return isRead && !bytes.empty() && read(&bytes[0], bytes.size());
+}
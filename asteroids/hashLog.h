@@ -0,0 +1,57 @@
+/*************************************************************
+* File: hashLog.h
+* Author: Matthew Burr
+*
+* Description: Contains the declaration of the HashLog, the
+*  state hash of a game after every tick, kept beside an
+*  InputLog so two runs of the same input can be checked
+*  against each other.
+*************************************************************/
+
+#ifndef hashLog_h
+#define hashLog_h
+
+#include <cstddef>
+#include <vector>
+
+#define HASH_LOG_MAGIC 0x48545341u   // "ASTH"
+#define HASH_LOG_VERSION 1
+#define NO_DIVERGENCE -1
+
+/*****************************************
+* HASH LOG
+* One Game::getStateHash a tick, in tick
+* order. On disk it is the magic number,
+* the version and the tick count as four
+* bytes each, then eight bytes a tick, all
+* lowest byte first.
+*****************************************/
+class HashLog
+{
+public:
+   HashLog() {}
+
+   // The hash after the next tick
+   void add(unsigned long long in_hash) { m_hashes.push_back(in_hash); }
+   void clear() { m_hashes.clear(); }
+
+   int getTickCount() const { return (int)m_hashes.size(); }
+   unsigned long long getHash(int in_tick) const { return m_hashes[in_tick]; }
+
+   // The first tick on which two logs disagree, or NO_DIVERGENCE. A
+   // log that stops short disagrees where it stops.
+   static int findDivergence(const HashLog &in_first,
+      const HashLog &in_second);
+
+   // To and from memory, and to and from a file. Reading fails, and
+   // leaves the log empty, for anything that isn't a whole log.
+   void write(std::vector<unsigned char> &out_bytes) const;
+   bool read(const unsigned char * in_bytes, size_t in_size);
+   bool save(const char * in_fileName) const;
+   bool load(const char * in_fileName);
+
+private:
+   std::vector<unsigned long long> m_hashes;
+};
+
+#endif /* hashLog_h */
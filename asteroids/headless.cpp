@@ -0,0 +1,150 @@
+/*****************************************************
+ * File: headless.cpp
+ * Author: Matthew Burr
+ *
+ * Description: Runs the game with no window, as fast
+ *  as it will go, for a fixed number of frames and
+ *  reports how long that took. Input comes from a
+ *  script or, with no script, from random key
+ *  presses.
+ *
+ *  Usage: headless [frames] [rocks] [seed] [script]
+ *
+ *  A script has one line per frame listing the keys
+ *  held down that frame: l (left), r (right),
+ *  u (thrust) and f (fire). Anything else on a line,
+ *  an empty line included, means no keys. When the
+ *  script runs out it starts over.
+ ******************************************************/
+#include "game.h"
+#include "gameInput.h"
+#include "point.h"
+#include "random.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#define DEFAULT_FRAMES 10000
+#define DEFAULT_SEED 1
+
+// How often random input presses each key, out of 100
+#define TURN_CHANCE 20
+#define THRUST_CHANCE 10
+#define FIRE_CHANCE 30
+using namespace std;
+
+/*************************************
+ * PARSE INPUT
+ * The keys listed on one script line
+ **************************************/
+GameInput parseInput(const string &line)
+{
+   GameInput input = { false, false, false, false };
+
+   for (size_t i = 0; i < line.size(); i++)
+   {
+      switch (line[i])
+      {
+         case 'l':
+            input.left = true;
+            break;
+         case 'r':
+            input.right = true;
+            break;
+         case 'u':
+            input.up = true;
+            break;
+         case 'f':
+            input.fire = true;
+            break;
+      }
+   }
+
+   return input;
+}
+
+/*************************************
+ * READ SCRIPT
+ * Loads every line of a script file.
+ * Returns false if it can't be read.
+ **************************************/
+bool readScript(const char * fileName, vector<GameInput> &script)
+{
+   ifstream fin(fileName);
+   if (fin.fail())
+      return false;
+
+   string line;
+   while (getline(fin, line))
+      script.push_back(parseInput(line));
+
+   return true;
+}
+
+/*************************************
+ * RANDOM INPUT
+ * A random set of keys, as a bot
+ * mashing the controls might press
+ **************************************/
+GameInput randomInput(Random &bot)
+{
+   GameInput input;
+   input.left = bot.getInt(0, 100) < TURN_CHANCE;
+   input.right = !input.left && bot.getInt(0, 100) < TURN_CHANCE;
+   input.up = bot.getInt(0, 100) < THRUST_CHANCE;
+   input.fire = bot.getInt(0, 100) < FIRE_CHANCE;
+   return input;
+}
+
+/*********************************
+ * Main sets up the game and runs
+ * it frame after frame, the same
+ * way the display loop would, just
+ * without drawing or waiting
+ *********************************/
+int main(int argc, char ** argv)
+{
+   int frames = (argc > 1) ? atoi(argv[1]) : DEFAULT_FRAMES;
+   int rocks = (argc > 2) ? atoi(argv[2]) : START_ROCK_COUNT;
+   int seed = (argc > 3) ? atoi(argv[3]) : DEFAULT_SEED;
+
+   vector<GameInput> script;
+   if (argc > 4 && (!readScript(argv[4], script) || script.empty()))
+   {
+      fprintf(stderr, "headless: can't read a script from %s\n", argv[4]);
+      return 1;
+   }
+
+   Point topLeft(-200, 200);
+   Point bottomRight(200, -200);
+
+   // the game and the bot pressing the keys each get a stream
+   Random bot(seed);
+   Game game(topLeft, bottomRight, rocks, MAX_BULLETS, bot.next());
+
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   for (int frame = 0; frame < frames; frame++)
+   {
+      game.advance();
+
+      if (script.empty())
+         game.handleInput(randomInput(bot));
+      else
+         game.handleInput(script[frame % script.size()]);
+   }
+   chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+   printf("frames:  %d\n", frames);
+   printf("seconds: %.3f\n", elapsed.count());
+   printf("fps:     %.0f\n",
+      elapsed.count() > 0 ? frames / elapsed.count() : 0.0);
+   printf("score:   %d\n", game.getScore());
+   printf("lives:   %d\n", game.getLives());
+   printf("rocks:   %d\n", game.getRockCount());
+   printf("bullets: %d\n", game.getBulletCount());
+
+   return 0;
+}
@@ -0,0 +1,217 @@
+/*************************************************************
+* File: inputLog.cpp
+* Author: Matthew Burr
+*
+* Description: Contains the implementations of the
+*  method bodies for the InputLog class.
+*************************************************************/
+
+#include "inputLog.h"
+#include "gameInput.h"
+#include <climits>
+#include <cstdio>
+#include <vector>
+using namespace std;
+
+#define ALL_KEYS (INPUT_LEFT | INPUT_RIGHT | INPUT_UP | INPUT_FIRE)
+#define VARINT_BITS 7
+#define VARINT_MORE 0x80
+#define MAX_VARINT_SIZE 10     // bytes in the longest 64-bit varint
+
+/**********************************************************************
+* Function: writeVarint
+* Description: Appends a number seven bits to a byte, lowest first,
+*  with the top bit set on every byte but the last
+**********************************************************************/
+static void writeVarint(vector<unsigned char> &bytes, unsigned long long value)
+{
+   while (value >= VARINT_MORE)
+   {
+      bytes.push_back((unsigned char)(value | VARINT_MORE));
+      value >>= VARINT_BITS;
+   }
+   bytes.push_back((unsigned char)value);
+}
+
+/**********************************************************************
+* Function: readVarint
+* Description: Takes a number off the front of the bytes. Returns false
+*  if they run out first or it's too long to be a varint.
+**********************************************************************/
+static bool readVarint(const unsigned char * &next, const unsigned char * end,
+   unsigned long long &value)
+{
+   value = 0;
+   for (int i = 0; i < MAX_VARINT_SIZE && next < end; i++)
+   {
+      unsigned char byte = *next++;
+      value |= (unsigned long long)(byte & ~VARINT_MORE) << (i * VARINT_BITS);
+      if (!(byte & VARINT_MORE))
+         return true;
+   }
+   return false;
+}
+
+/**********************************************************************
+* Method: InputLog
+* Description: Creates an empty log for a game started with a seed
+*  and a number of rocks
+**********************************************************************/
+InputLog::InputLog(unsigned long long in_seed, int in_rockCount)
+   : m_seed(in_seed), m_rockCount(in_rockCount), m_tickCount(0)
+{
+}
+
+/**********************************************************************
+* Method: add
+* Description: Records the input for the next tick, stretching the
+*  last run if the keys haven't changed
+**********************************************************************/
+void InputLog::add(const GameInput &in_input)
+{
+   unsigned char keys = packInput(in_input);
+
+   if (!m_runs.empty() && m_runs.back().keys == keys &&
+       m_runs.back().length < INT_MAX)
+      m_runs.back().length++;
+   else
+   {
+      InputRun run = { keys, 1 };
+      m_runs.push_back(run);
+   }
+
+   m_tickCount++;
+}
+
+/**********************************************************************
+* Method: clear
+* Description: Forgets every tick, keeping the seed and rock count
+**********************************************************************/
+void InputLog::clear()
+{
+   m_runs.clear();
+   m_tickCount = 0;
+}
+
+/**********************************************************************
+* Method: write
+* Description: Lays the log out as bytes, replacing what was there
+**********************************************************************/
+void InputLog::write(vector<unsigned char> &out_bytes) const
+{
+   out_bytes.clear();
+
+   unsigned magic = INPUT_LOG_MAGIC;
+   for (int i = 0; i < 4; i++)
+      out_bytes.push_back((unsigned char)(magic >> (i * 8)));
+
+   writeVarint(out_bytes, INPUT_LOG_VERSION);
+   writeVarint(out_bytes, m_seed);
+   writeVarint(out_bytes, m_rockCount);
+   writeVarint(out_bytes, m_tickCount);
+   writeVarint(out_bytes, m_runs.size());
+
+   for (size_t i = 0; i < m_runs.size(); i++)
+   {
+      out_bytes.push_back(m_runs[i].keys);
+      writeVarint(out_bytes, m_runs[i].length);
+   }
+}
+
+/**********************************************************************
+* Method: read
+* Description: Takes the log back from bytes write laid out. Every run
+*  has to be there and add up to the tick count.
+**********************************************************************/
+bool InputLog::read(const unsigned char * in_bytes, size_t in_size)
+{
+   clear();
+
+   const unsigned char * next = in_bytes;
+   const unsigned char * end = in_bytes + in_size;
+   if (in_size < 4)
+      return false;
+
+   unsigned magic = 0;
+   for (int i = 0; i < 4; i++)
+      magic |= (unsigned)*next++ << (i * 8);
+
+   unsigned long long version, seed, rockCount, tickCount, runCount;
+   if (magic != INPUT_LOG_MAGIC ||
+       !readVarint(next, end, version) || version != INPUT_LOG_VERSION ||
+       !readVarint(next, end, seed) ||
+       !readVarint(next, end, rockCount) || rockCount > INT_MAX ||
+       !readVarint(next, end, tickCount) ||
+       !readVarint(next, end, runCount) ||
+       runCount > (unsigned long long)(end - next) / 2)
+      return false;
+
+   m_runs.resize((size_t)runCount);
+   unsigned long long ticks = 0;
+   bool isWhole = true;
+   for (size_t i = 0; isWhole && i < m_runs.size(); i++)
+   {
+      unsigned long long length = 0;
+      isWhole = next < end && (*next & ~ALL_KEYS) == 0;
+      if (isWhole)
+      {
+         m_runs[i].keys = *next++;
+         isWhole = readVarint(next, end, length) && length >= 1 &&
+            length <= INT_MAX;
+      }
+      m_runs[i].length = (int)length;
+      ticks += length;
+   }
+
+   if (!isWhole || next != end || ticks != tickCount)
+   {
+      clear();
+      return false;
+   }
+
+   m_seed = seed;
+   m_rockCount = (int)rockCount;
+   m_tickCount = (long long)tickCount;
+   return true;
+}
+
+/**********************************************************************
+* Method: save
+* Description: Writes the log to a file. Returns false if it can't.
+**********************************************************************/
+bool InputLog::save(const char * in_fileName) const
+{
+   vector<unsigned char> bytes;
+   write(bytes);
+
+   FILE *file = fopen(in_fileName, "wb");
+   if (file == NULL)
+      return false;
+
+   bool isWritten = fwrite(&bytes[0], 1, bytes.size(), file) == bytes.size();
+   return fclose(file) == 0 && isWritten;
+}
+
+/**********************************************************************
+* Method: load
+* Description: Reads a log from a file. Returns false if it can't, or
+*  the file doesn't hold a whole log.
+**********************************************************************/
+bool InputLog::load(const char * in_fileName)
+{
+   clear();
+
+   FILE *file = fopen(in_fileName, "rb");
+   if (file == NULL)
+      return false;
+
+   vector<unsigned char> bytes;
+   unsigned char buffer[4096];
+   size_t count;
+   while ((count = fread(buffer, 1, sizeof(buffer), file)) > 0)
+      bytes.insert(bytes.end(), buffer, buffer + count);
+   bool isRead = !ferror(file);
+   fclose(file);
+
+   return isRead && !bytes.empty() && read(&bytes[0], bytes.size());
+}
@@ -0,0 +1,75 @@
+/*************************************************************
+* File: inputLog.h
+* Author: Matthew Burr
+*
+* Description: Contains the declaration of the InputLog, a
+*  record of the input a game was given on every tick, from
+*  which the same game can be played again.
+*************************************************************/
+
+#ifndef inputLog_h
+#define inputLog_h
+
+#include "gameInput.h"
+#include "random.h"
+#include <cstddef>
+#include <vector>
+
+#define INPUT_LOG_MAGIC 0x49545341u   // "ASTI"
+#define INPUT_LOG_VERSION 1
+
+/*****************************************
+* INPUT RUN
+* The same keys held for a number of ticks
+* in a row
+*****************************************/
+struct InputRun
+{
+   unsigned char keys;     // packed, as packInput() gives them
+   int length;
+};
+
+/*****************************************
+* INPUT LOG
+* The seed and rock count a game started
+* with and the input for each of its
+* ticks, one run of ticks at a time.
+* Players hold keys down for many ticks,
+* so the runs are long and few.
+*
+* On disk it is the magic number, then
+* varints: the version, seed, rock count,
+* tick count and run count, then each run
+* as its keys byte and a varint length.
+*****************************************/
+class InputLog
+{
+public:
+   InputLog(unsigned long long in_seed = DEFAULT_RANDOM_SEED,
+      int in_rockCount = 0);
+
+   // The input for the next tick
+   void add(const GameInput &in_input);
+   void clear();
+
+   unsigned long long getSeed() const { return m_seed; }
+   int getRockCount() const { return m_rockCount; }
+   long long getTickCount() const { return m_tickCount; }
+   int getRunCount() const { return (int)m_runs.size(); }
+   const InputRun & getRun(int in_index) const { return m_runs[in_index]; }
+
+   // To and from memory, and to and from a file. Reading fails, and
+   // leaves the log empty, for anything that isn't a whole log.
+   void write(std::vector<unsigned char> &out_bytes) const;
+   bool read(const unsigned char * in_bytes, size_t in_size);
+   bool save(const char * in_fileName) const;
+   bool load(const char * in_fileName);
+
+private:
+   unsigned long long m_seed;
+   int m_rockCount;
+   long long m_tickCount;
+   std::vector<InputRun> m_runs;
+};
+
+#endif /* inputLog_h */
@@ -0,0 +1,132 @@
+/*************************************************************
+* File: mappedFile.cpp
+* Author: Matthew Burr
+*
+* Description: Contains the implementations of the
+*  method bodies for the MappedFile class.
+*
+*  On Windows this uses a file mapping object; elsewhere it
+*  uses mmap.
+*************************************************************/
+
+#include "mappedFile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**********************************************************************
+* Method: MappedFile
+* Description: Creates a MappedFile with no file open
+**********************************************************************/
+MappedFile::MappedFile()
+   : m_data(NULL), m_size(0)
+#ifdef _WIN32
+   , m_file(INVALID_HANDLE_VALUE), m_mapping(NULL)
+#endif
+{
+}
+
+#ifdef _WIN32
+
+/**********************************************************************
+* Method: open
+* Description: Maps the whole of a file for reading
+**********************************************************************/
+bool MappedFile::open(const char * in_fileName)
+{
+   close();
+
+   m_file = CreateFileA(in_fileName, GENERIC_READ, FILE_SHARE_READ, NULL,
+      OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+   LARGE_INTEGER size;
+   if (m_file == INVALID_HANDLE_VALUE || !GetFileSizeEx(m_file, &size) ||
+       size.QuadPart <= 0 || (unsigned long long)size.QuadPart > (size_t)-1)
+   {
+      close();
+      return false;
+   }
+
+   m_mapping = CreateFileMappingA(m_file, NULL, PAGE_READONLY, 0, 0, NULL);
+   void * view = (m_mapping == NULL) ? NULL :
+      MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+   if (view == NULL)
+   {
+      close();
+      return false;
+   }
+
+   m_data = (const unsigned char *)view;
+   m_size = (size_t)size.QuadPart;
+   return true;
+}
+
+/**********************************************************************
+* Method: close
+* Description: Unmaps the file, if one is open
+**********************************************************************/
+void MappedFile::close()
+{
+   if (m_data != NULL)
+      UnmapViewOfFile(m_data);
+   if (m_mapping != NULL)
+      CloseHandle(m_mapping);
+   if (m_file != INVALID_HANDLE_VALUE)
+      CloseHandle(m_file);
+
+   m_data = NULL;
+   m_size = 0;
+   m_mapping = NULL;
+   m_file = INVALID_HANDLE_VALUE;
+}
+
+#else
+
+/**********************************************************************
+* Method: open
+* Description: Maps the whole of a file for reading. The descriptor
+*  isn't needed once the file is mapped.
+**********************************************************************/
+bool MappedFile::open(const char * in_fileName)
+{
+   close();
+
+   int file = ::open(in_fileName, O_RDONLY);
+   if (file < 0)
+      return false;
+
+   struct stat status;
+   void * view = MAP_FAILED;
+   if (fstat(file, &status) == 0 && status.st_size > 0 &&
+       (unsigned long long)status.st_size <= (size_t)-1)
+      view = mmap(NULL, (size_t)status.st_size, PROT_READ, MAP_PRIVATE,
+         file, 0);
+   ::close(file);
+
+   if (view == MAP_FAILED)
+      return false;
+
+   m_data = (const unsigned char *)view;
+   m_size = (size_t)status.st_size;
+   return true;
+}
+
+/**********************************************************************
+* Method: close
+* Description: Unmaps the file, if one is open
+**********************************************************************/
+void MappedFile::close()
+{
+   if (m_data != NULL)
+      munmap((void *)m_data, m_size);
+
+   m_data = NULL;
+   m_size = 0;
+}
+
+#endif
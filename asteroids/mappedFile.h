@@ -0,0 +1,49 @@
+/*************************************************************
+* File: mappedFile.h
+* Author: Matthew Burr
+*
+* Description: Contains the declaration of the MappedFile, a
+*  file mapped read-only into memory, so its bytes can be
+*  read in place and only the pages actually touched are
+*  ever loaded.
+*************************************************************/
+
+#ifndef mappedFile_h
+#define mappedFile_h
+
+#include <cstddef>
+
+/*****************************************
+* MAPPED FILE
+* A whole file as one read-only block of
+* memory, for as long as it stays open
+*****************************************/
+class MappedFile
+{
+public:
+   MappedFile();
+   ~MappedFile() { close(); }
+
+   // Maps the file, closing any the object had open. Fails for a file
+   // that can't be opened or is empty.
+   bool open(const char * in_fileName);
+   void close();
+
+   bool isOpen() const { return m_data != NULL; }
+   const unsigned char * getData() const { return m_data; }
+   size_t getSize() const { return m_size; }
+
+private:
+   // A mapping belongs to one object
+   MappedFile(const MappedFile &);
+   MappedFile & operator = (const MappedFile &);
+
+   const unsigned char * m_data;
+   size_t m_size;
+#ifdef _WIN32
+   void * m_file;
+   void * m_mapping;
+#endif
+};
+
+#endif /* mappedFile_h */
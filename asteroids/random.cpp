@@ -0,0 +1,234 @@
+/*************************************************************
+* File: random.cpp
+* Author: Br. Helfrich
+*
+* Description: Contains the implementations of the random
+*  number helpers.
+*
+*  The generator is xoshiro256** by Blackman and Vigna, seeded
+*  through splitmix64 so that nearby seeds still give
+*  unrelated sequences.
+*************************************************************/
+
+#include "random.h"
+#include "snapshot.h"
+#include <cassert>    // I feel the need... the need for asserts
+
+// Moves a generator on 2^128 numbers
+const unsigned long long JUMP[4] =
+{
+   0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+   0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL
+};
+
+/******************************************************************
+ * ROTATE LEFT
+ ****************************************************************/
+inline unsigned long long rotateLeft(unsigned long long x, int k)
+{
+   return (x << k) | (x >> (64 - k));
+}
+
+/**********************************************************************
+* Method: seed
+* Description: Starts the sequence over from a seed
+**********************************************************************/
+void Random::seed(unsigned long long in_seed)
+{
+   unsigned long long splitMix = in_seed;
+   for (int i = 0; i < 4; i++)
+   {
+      unsigned long long z = (splitMix += 0x9e3779b97f4a7c15ULL);
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+      m_state[i] = z ^ (z >> 31);
+   }
+}
+
+/**********************************************************************
+* Method: save
+* Description: Writes the generator's state to a snapshot
+**********************************************************************/
+void Random::save(SnapshotWriter &out) const
+{
+   out.write(m_state);
+}
+
+/**********************************************************************
+* Method: restore
+* Description: Picks the sequence up where a snapshot left it. A state
+*  of all zeros would only ever give zeros, so no generator saves one.
+**********************************************************************/
+void Random::restore(SnapshotReader &in)
+{
+   unsigned long long state[4];
+   if (!in.read(state))
+      return;
+
+   if ((state[0] | state[1] | state[2] | state[3]) == 0)
+   {
+      in.fail();
+      return;
+   }
+
+   for (int i = 0; i < 4; i++)
+      m_state[i] = state[i];
+}
+
+/**********************************************************************
+* Method: next
+* Description: 64 random bits
+**********************************************************************/
+unsigned long long Random::next()
+{
+   unsigned long long result = rotateLeft(m_state[1] * 5, 7) * 9;
+   unsigned long long t = m_state[1] << 17;
+
+   m_state[2] ^= m_state[0];
+   m_state[3] ^= m_state[1];
+   m_state[1] ^= m_state[2];
+   m_state[0] ^= m_state[3];
+   m_state[2] ^= t;
+   m_state[3] = rotateLeft(m_state[3], 45);
+
+   return result;
+}
+
+/**********************************************************************
+* Method: jump
+* Description: Moves on as far as 2^128 calls to next() would
+**********************************************************************/
+void Random::jump()
+{
+   unsigned long long jumped[4] = { 0, 0, 0, 0 };
+   for (int i = 0; i < 4; i++)
+      for (int bit = 0; bit < 64; bit++)
+      {
+         if (JUMP[i] & (1ULL << bit))
+            for (int j = 0; j < 4; j++)
+               jumped[j] ^= m_state[j];
+         next();
+      }
+
+   for (int j = 0; j < 4; j++)
+      m_state[j] = jumped[j];
+}
+
+/**********************************************************************
+* Method: split
+* Description: A generator for another stream. It carries on from
+*  where this one is, and this one jumps ahead, so neither will ever
+*  give the numbers the other does.
+**********************************************************************/
+Random Random::split()
+{
+   Random stream(*this);
+   jump();
+   return stream;
+}
+
+/**********************************************************************
+* Method: getInt
+* Description: A random integer, min <= num < max. The top 32 bits are
+*  scaled to the range, which unlike % doesn't favor small numbers.
+**********************************************************************/
+int Random::getInt(int min, int max)
+{
+   assert(min < max);
+   unsigned long long range = (unsigned long long)((long long)max - min);
+   int num = min + (int)(((next() >> 32) * range) >> 32);
+
+   assert(min <= num && num < max);
+   return num;
+}
+
+/**********************************************************************
+* Method: getFloat
+* Description: A random float, min <= num < max, from the top 24 bits
+**********************************************************************/
+float Random::getFloat(float min, float max)
+{
+   assert(min <= max);
+   float unit = (float)(next() >> 40) * (1.0f / 16777216.0f);
+   float num = min + unit * (max - min);
+
+   // rounding can land on max itself
+   return num < max ? num : min;
+}
+
+/**********************************************************************
+* Method: getDouble
+* Description: A random double, min <= num < max, from the top 53 bits
+**********************************************************************/
+double Random::getDouble(double min, double max)
+{
+   assert(min <= max);
+   double unit = (double)(next() >> 11) * (1.0 / 9007199254740992.0);
+   double num = min + unit * (max - min);
+
+   return num < max ? num : min;
+}
+
+/**********************************************************************
+* Method: fill
+* Description: Fills an array with random integers
+**********************************************************************/
+void Random::fill(int * out, int count, int min, int max)
+{
+   for (int i = 0; i < count; i++)
+      out[i] = getInt(min, max);
+}
+
+/**********************************************************************
+* Method: fill
+* Description: Fills an array with random floats
+**********************************************************************/
+void Random::fill(float * out, int count, float min, float max)
+{
+   for (int i = 0; i < count; i++)
+      out[i] = getFloat(min, max);
+}
+
+/******************************************************************
+ * THREAD RANDOM
+ * The generator the free functions use; each thread has its own
+ ****************************************************************/
+static Random & getThreadRandom()
+{
+   static thread_local Random threadRandom;
+   return threadRandom;
+}
+
+/******************************************************************
+ * RANDOM
+ * This function generates a random number.  
+ *
+ *    INPUT:   min, max : The number of values (min <= num <= max)
+ *    OUTPUT   <return> : Return the integer
+ ****************************************************************/
+int random(int min, int max)
+{
+   return getThreadRandom().getInt(min, max);
+}
+
+/******************************************************************
+ * RANDOM
+ * This function generates a random number.  
+ *
+ *    INPUT:   min, max : The number of values (min <= num <= max)
+ *    OUTPUT   <return> : Return the double
+ ****************************************************************/
+double random(double min, double max)
+{
+   return getThreadRandom().getDouble(min, max);
+}
+
+/******************************************************************
+ * SEED RANDOM
+ * Starts the calling thread's generator over from a seed, so a
+ * run that draws from random() can be repeated
+ ****************************************************************/
+void seedRandom(unsigned long long seed)
+{
+   getThreadRandom() = Random(seed);
+}
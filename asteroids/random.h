@@ -0,0 +1,72 @@
+/*************************************************************
+* File: random.h
+* Author: Br. Helfrich
+*
+* Description: Contains the random number helpers the game
+*  uses. They live apart from uiDraw so the simulation can be
+*  built without any graphics.
+*************************************************************/
+
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#define DEFAULT_RANDOM_SEED 1
+
+class SnapshotWriter;
+class SnapshotReader;
+
+/******************************************************************
+ * RANDOM
+ * A random number generator (xoshiro256**) with state of its own,
+ * so each game can have one and get the same numbers every time
+ * it is given the same seed, whatever else is running. split()
+ * hands out further streams that never overlap this one, for
+ * anything that needs numbers without changing this sequence.
+ ****************************************************************/
+class Random
+{
+public:
+   explicit Random(unsigned long long in_seed = DEFAULT_RANDOM_SEED)
+   {
+      seed(in_seed);
+   }
+
+   void seed(unsigned long long in_seed);
+   Random split();
+
+   unsigned long long next();
+   int getInt(int min, int max);                // min <= num < max
+   float getFloat(float min, float max);        // min <= num < max
+   double getDouble(double min, double max);    // min <= num < max
+
+   // Many numbers at once, as getInt() and getFloat() would give them
+   void fill(int * out, int count, int min, int max);
+   void fill(float * out, int count, float min, float max);
+
+   // Where the sequence has got to, to carry on from later
+   void save(SnapshotWriter &out) const;
+   void restore(SnapshotReader &in);
+
+private:
+   unsigned long long m_state[4];
+
+   void jump();
+};
+
+/******************************************************************
+ * RANDOM
+ * This function generates a random number.  The user specifies
+ * The parameters 
+ *    INPUT:   min, max : The number of values (min <= num <= max)
+ *    OUTPUT   <return> : Return the integer
+ *
+ * These draw from a generator kept for each thread, for anything
+ * that doesn't have a Random of its own.
+ ****************************************************************/
+int    random(int    min, int    max);
+double random(double min, double max);
+
+// Starts the calling thread's generator over, as srand() did for rand()
+void seedRandom(unsigned long long seed);
+
+#endif // RANDOM_H
@@ -0,0 +1,119 @@
+/*****************************************************
+ * File: replay.cpp
+ * Author: Matthew Burr
+ *
+ * Description: Plays a game again from the keys the
+ *  game recorded, with no window and no waiting
+ *  between ticks, and reports how it ended and how
+ *  long it took.
+ *
+ *  Usage: replay record.log [hashes.log [tick snapshot]]
+ *
+ *  Given a second file, the state hash after every
+ *  tick is written to it, for compareRuns to check
+ *  against another run's. Given a tick as well, the
+ *  whole game after that tick is saved as a snapshot,
+ *  for compareRuns to find the rock or bullet that
+ *  went astray.
+ ******************************************************/
+#include "game.h"
+#include "gameInput.h"
+#include "hashLog.h"
+#include "inputLog.h"
+#include "point.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+using namespace std;
+
+#define NO_TICK -1
+
+/*********************************
+ * SAVE SNAPSHOT
+ * Writes a game's snapshot to a file
+ *********************************/
+bool saveSnapshot(const Game &game, const char * fileName)
+{
+   vector<unsigned char> bytes;
+   game.saveSnapshot(bytes);
+
+   FILE *file = fopen(fileName, "wb");
+   if (file == NULL)
+      return false;
+
+   bool isWritten = fwrite(&bytes[0], 1, bytes.size(), file) == bytes.size();
+   return fclose(file) == 0 && isWritten;
+}
+
+/*********************************
+ * Main loads the log and runs its
+ * ticks, in the same order the
+ * display loop did
+ *********************************/
+int main(int argc, char ** argv)
+{
+   if (argc < 2 || argc == 4)
+   {
+      fprintf(stderr,
+         "usage: replay record.log [hashes.log [tick snapshot]]\n");
+      return 1;
+   }
+
+   InputLog log;
+   if (!log.load(argv[1]))
+   {
+      fprintf(stderr, "replay: can't read a recording from %s\n", argv[1]);
+      return 1;
+   }
+
+   const char * hashFileName = (argc > 2) ? argv[2] : NULL;
+   long long snapshotTick = (argc > 4) ? atoll(argv[3]) : NO_TICK;
+   const char * snapshotFileName = (argc > 4) ? argv[4] : NULL;
+   HashLog hashes;
+
+   Point topLeft(-200, 200);
+   Point bottomRight(200, -200);
+   Game game(topLeft, bottomRight, log.getRockCount(), MAX_BULLETS,
+      log.getSeed());
+
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   long long ticks = 0;
+   for (int run = 0; run < log.getRunCount(); run++)
+   {
+      GameInput input = unpackInput(log.getRun(run).keys);
+      for (int tick = 0; tick < log.getRun(run).length; tick++, ticks++)
+      {
+         game.advance();
+         game.handleInput(input);
+
+         if (hashFileName)
+            hashes.add(game.getStateHash());
+         if (ticks == snapshotTick && !saveSnapshot(game, snapshotFileName))
+         {
+            fprintf(stderr, "replay: can't write %s\n", snapshotFileName);
+            return 1;
+         }
+      }
+   }
+   chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+   if (hashFileName && !hashes.save(hashFileName))
+   {
+      fprintf(stderr, "replay: can't write %s\n", hashFileName);
+      return 1;
+   }
+
+   printf("ticks:   %lld\n", log.getTickCount());
+   printf("runs:    %d\n", log.getRunCount());
+   printf("seconds: %.3f\n", elapsed.count());
+   printf("tps:     %.0f\n",
+      elapsed.count() > 0 ? log.getTickCount() / elapsed.count() : 0.0);
+   printf("score:   %d\n", game.getScore());
+   printf("lives:   %d\n", game.getLives());
+   printf("rocks:   %d\n", game.getRockCount());
+   printf("bullets: %d\n", game.getBulletCount());
+   printf("hash:    %016llx\n", game.getStateHash());
+
+   return 0;
+}
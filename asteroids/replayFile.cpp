@@ -0,0 +1,305 @@
+/*************************************************************
+* File: replayFile.cpp
+* Author: Matthew Burr
+*
+* Description: Contains the implementations of the
+*  method bodies for the ReplayWriter and ReplayReader
+*  classes.
+*************************************************************/
+
+#include "replayFile.h"
+#include "game.h"
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+using namespace std;
+
+#define HEADER_SIZE 24    // magic, version, seed, rock count, interval
+#define FOOTER_SIZE 24    // index offset, ticks, segments, magic
+#define OFFSET_SIZE 8
+#define SNAPSHOT_SIZE_SIZE 4
+
+/**********************************************************************
+* Function: readBytes
+* Description: Takes a number of count bytes off the front of the
+*  bytes, lowest first; the caller checks there are enough
+**********************************************************************/
+static unsigned long long readBytes(const unsigned char * &next, int count)
+{
+   unsigned long long value = 0;
+   for (int i = 0; i < count; i++)
+      value |= (unsigned long long)*next++ << (i * 8);
+   return value;
+}
+
+/**********************************************************************
+* Method: ReplayWriter
+* Description: Creates a ReplayWriter with no file open
+**********************************************************************/
+ReplayWriter::ReplayWriter()
+   : m_file(NULL), m_offset(0), m_tickCount(0),
+     m_interval(KEYFRAME_INTERVAL), m_isOk(true)
+{
+}
+
+/**********************************************************************
+* Method: open
+* Description: Creates the file and writes its header
+**********************************************************************/
+bool ReplayWriter::open(const char * in_fileName, unsigned long long in_seed,
+   int in_rockCount, int in_interval)
+{
+   close();
+   if (in_interval < 1 || in_rockCount < 0)
+      return false;
+
+   m_file = fopen(in_fileName, "wb");
+   if (m_file == NULL)
+      return false;
+
+   m_offset = 0;
+   m_tickCount = 0;
+   m_interval = in_interval;
+   m_isOk = true;
+   m_segments.clear();
+
+   write(REPLAY_FILE_MAGIC, 4);
+   write(REPLAY_FILE_VERSION, 4);
+   write(in_seed, 8);
+   write(in_rockCount, 4);
+   write(in_interval, 4);
+   return m_isOk;
+}
+
+/**********************************************************************
+* Method: addTick
+* Description: Starts a new segment with a keyframe every interval
+*  ticks, then adds the tick's keys to the segment
+**********************************************************************/
+bool ReplayWriter::addTick(const Game &in_game, const GameInput &in_input)
+{
+   if (m_file == NULL)
+      return false;
+
+   if (m_tickCount % m_interval == 0)
+   {
+      m_segments.push_back(m_offset);
+      in_game.saveSnapshot(m_snapshot);
+      write(m_snapshot.size(), SNAPSHOT_SIZE_SIZE);
+      write(m_snapshot);
+   }
+
+   write(packInput(in_input), 1);
+   m_tickCount++;
+   return m_isOk;
+}
+
+/**********************************************************************
+* Method: close
+* Description: Finishes the file with the index and footer
+**********************************************************************/
+bool ReplayWriter::close()
+{
+   if (m_file == NULL)
+      return m_isOk;
+
+   unsigned long long indexOffset = m_offset;
+   for (size_t i = 0; i < m_segments.size(); i++)
+      write(m_segments[i], OFFSET_SIZE);
+   write(indexOffset, OFFSET_SIZE);
+   write(m_tickCount, 8);
+   write(m_segments.size(), 4);
+   write(REPLAY_FOOTER_MAGIC, 4);
+
+   if (fclose(m_file) != 0)
+      m_isOk = false;
+   m_file = NULL;
+   return m_isOk;
+}
+
+/**********************************************************************
+* Method: write
+* Description: Writes the low bytes of a number, lowest first
+**********************************************************************/
+bool ReplayWriter::write(unsigned long long in_value, int in_count)
+{
+   unsigned char bytes[8];
+   for (int i = 0; i < in_count; i++)
+      bytes[i] = (unsigned char)(in_value >> (i * 8));
+
+   if (fwrite(bytes, 1, in_count, m_file) != (size_t)in_count)
+      m_isOk = false;
+   m_offset += in_count;
+   return m_isOk;
+}
+
+/**********************************************************************
+* Method: write
+* Description: Writes bytes as they are
+**********************************************************************/
+bool ReplayWriter::write(const vector<unsigned char> &in_bytes)
+{
+   if (!in_bytes.empty() &&
+       fwrite(&in_bytes[0], 1, in_bytes.size(), m_file) != in_bytes.size())
+      m_isOk = false;
+   m_offset += in_bytes.size();
+   return m_isOk;
+}
+
+/**********************************************************************
+* Method: ReplayReader
+* Description: Creates a ReplayReader with no file open
+**********************************************************************/
+ReplayReader::ReplayReader()
+{
+   close();
+}
+
+/**********************************************************************
+* Method: open
+* Description: Maps the file and checks that its header and footer
+*  agree with each other and with the file's size. The segments
+*  aren't looked at until they are needed.
+**********************************************************************/
+bool ReplayReader::open(const char * in_fileName)
+{
+   close();
+   if (!m_file.open(in_fileName) ||
+       m_file.getSize() < HEADER_SIZE + FOOTER_SIZE)
+   {
+      close();
+      return false;
+   }
+
+   const unsigned char * next = m_file.getData();
+   unsigned long long magic = readBytes(next, 4);
+   unsigned long long version = readBytes(next, 4);
+   m_seed = readBytes(next, 8);
+   unsigned long long rockCount = readBytes(next, 4);
+   unsigned long long interval = readBytes(next, 4);
+
+   unsigned long long size = m_file.getSize();
+   next = m_file.getData() + size - FOOTER_SIZE;
+   m_indexOffset = readBytes(next, OFFSET_SIZE);
+   unsigned long long ticks = readBytes(next, 8);
+   unsigned long long segments = readBytes(next, 4);
+   unsigned long long footerMagic = readBytes(next, 4);
+
+   // Every tick takes a byte, which keeps the sums below from
+   // overflowing
+   if (magic != REPLAY_FILE_MAGIC || version != REPLAY_FILE_VERSION ||
+       footerMagic != REPLAY_FOOTER_MAGIC || rockCount > 0x7fffffff ||
+       interval < 1 || interval > 0x7fffffff || ticks > size ||
+       segments != (ticks + interval - 1) / interval ||
+       m_indexOffset < HEADER_SIZE ||
+       m_indexOffset + segments * OFFSET_SIZE + FOOTER_SIZE != size)
+   {
+      close();
+      return false;
+   }
+
+   m_rockCount = (int)rockCount;
+   m_interval = (int)interval;
+   m_tickCount = (long long)ticks;
+   m_segmentCount = (int)segments;
+   return true;
+}
+
+/**********************************************************************
+* Method: close
+* Description: Unmaps the file, if one is open
+**********************************************************************/
+void ReplayReader::close()
+{
+   m_file.close();
+   m_seed = 0;
+   m_rockCount = 0;
+   m_interval = KEYFRAME_INTERVAL;
+   m_tickCount = 0;
+   m_indexOffset = 0;
+   m_segmentCount = 0;
+}
+
+/**********************************************************************
+* Method: findSegment
+* Description: Finds a segment's snapshot and keys through the index,
+*  checking that they fill the space between it and the next one
+**********************************************************************/
+bool ReplayReader::findSegment(int in_segment,
+   const unsigned char * &out_snapshot, size_t &out_snapshotSize,
+   const unsigned char * &out_keys) const
+{
+   if (in_segment < 0 || in_segment >= m_segmentCount)
+      return false;
+
+   const unsigned char * next = m_file.getData() + m_indexOffset +
+      (size_t)in_segment * OFFSET_SIZE;
+   unsigned long long start = readBytes(next, OFFSET_SIZE);
+   unsigned long long end = (in_segment + 1 < m_segmentCount) ?
+      readBytes(next, OFFSET_SIZE) : m_indexOffset;
+   if (start < HEADER_SIZE || end > m_indexOffset ||
+       start + SNAPSHOT_SIZE_SIZE > end)
+      return false;
+
+   next = m_file.getData() + start;
+   unsigned long long snapshotSize = readBytes(next, SNAPSHOT_SIZE_SIZE);
+   long long ticks = min((long long)m_interval,
+      m_tickCount - (long long)in_segment * m_interval);
+   if (start + SNAPSHOT_SIZE_SIZE + snapshotSize + ticks != end)
+      return false;
+
+   out_snapshot = next;
+   out_snapshotSize = (size_t)snapshotSize;
+   out_keys = next + snapshotSize;
+   return true;
+}
+
+/**********************************************************************
+* Method: getInput
+* Description: Reads a tick's keys out of its segment
+**********************************************************************/
+bool ReplayReader::getInput(long long in_tick, GameInput &out_input) const
+{
+   if (in_tick < 0 || in_tick >= m_tickCount)
+      return false;
+
+   int segment = (int)(in_tick / m_interval);
+   const unsigned char * snapshot;
+   size_t snapshotSize;
+   const unsigned char * keys;
+   if (!findSegment(segment, snapshot, snapshotSize, keys))
+      return false;
+
+   out_input = unpackInput(keys[in_tick - (long long)segment * m_interval]);
+   return true;
+}
+
+/**********************************************************************
+* Method: seek
+* Description: Restores the last keyframe at or before the tick and
+*  plays the segment's keys up to it, in the order the game plays
+*  them. The tick count itself falls past the last keyframe when the
+*  ticks fill the last segment, so it is played to from there.
+**********************************************************************/
+bool ReplayReader::seek(Game &out_game, long long in_tick) const
+{
+   if (in_tick < 0 || in_tick > m_tickCount || m_segmentCount == 0)
+      return false;
+
+   int segment = (int)min(in_tick / m_interval,
+      (long long)m_segmentCount - 1);
+   const unsigned char * snapshot;
+   size_t snapshotSize;
+   const unsigned char * keys;
+   if (!findSegment(segment, snapshot, snapshotSize, keys) ||
+       !out_game.restoreSnapshot(snapshot, snapshotSize))
+      return false;
+
+   long long ticks = in_tick - (long long)segment * m_interval;
+   for (long long tick = 0; tick < ticks; tick++)
+   {
+      out_game.advance();
+      out_game.handleInput(unpackInput(keys[tick]));
+   }
+   return true;
+}
@@ -0,0 +1,131 @@
+/*************************************************************
+* File: replayFile.h
+* Author: Matthew Burr
+*
+* Description: Contains the ReplayWriter and ReplayReader,
+*  which write and read a replay that can be played from any
+*  tick without playing everything before it.
+*
+*  A replay file is, in order:
+*     header    magic, version, seed, rock count and the
+*               keyframe interval
+*     segments  one every interval ticks: the size of a game
+*               snapshot, the snapshot taken before the
+*               segment's first tick, then the packed keys of
+*               each of its ticks, a byte a tick
+*     index     the offset of each segment in the file
+*     footer    the offset of the index, the tick count, the
+*               segment count and a second magic number
+*  Every segment but the last holds interval ticks, so a
+*  tick's segment and place in it are a division away. The
+*  numbers outside the snapshots are stored lowest byte first;
+*  the snapshots are as Game::saveSnapshot lays them out.
+*************************************************************/
+
+#ifndef replayFile_h
+#define replayFile_h
+
+#include "gameInput.h"
+#include "mappedFile.h"
+#include <cstdio>
+#include <vector>
+
+class Game;
+
+#define REPLAY_FILE_MAGIC 0x52545341u     // "ASTR"
+#define REPLAY_FOOTER_MAGIC 0x58545341u   // "ASTX"
+#define REPLAY_FILE_VERSION 1
+
+// Ten seconds of play, as the game runs
+#define KEYFRAME_INTERVAL 300
+
+/*****************************************
+* REPLAY WRITER
+* Streams a game to a replay file as it
+* is played, a tick at a time, and writes
+* the index when it is closed
+*****************************************/
+class ReplayWriter
+{
+public:
+   ReplayWriter();
+   ~ReplayWriter() { close(); }
+
+   // Starts a new file for a game started with this seed and rock
+   // count, closing any file already open
+   bool open(const char * in_fileName, unsigned long long in_seed,
+      int in_rockCount, int in_interval = KEYFRAME_INTERVAL);
+
+   // The game as it is before the next tick, and the input that tick
+   // is given. Fails if the file can't be written.
+   bool addTick(const Game &in_game, const GameInput &in_input);
+
+   // Writes the index and footer. Fails if any write failed.
+   bool close();
+
+   long long getTickCount() const { return m_tickCount; }
+
+private:
+   // A writer owns its file
+   ReplayWriter(const ReplayWriter &);
+   ReplayWriter & operator = (const ReplayWriter &);
+
+   bool write(unsigned long long in_value, int in_count);
+   bool write(const std::vector<unsigned char> &in_bytes);
+
+   FILE *m_file;
+   unsigned long long m_offset;
+   long long m_tickCount;
+   int m_interval;
+   bool m_isOk;
+   std::vector<unsigned long long> m_segments;
+   std::vector<unsigned char> m_snapshot;
+};
+
+/*****************************************
+* REPLAY READER
+* A replay file mapped into memory.
+* Opening only checks the header, footer
+* and where the index lies, and reads
+* nothing else. Seeking restores the
+* nearest keyframe before the tick and
+* plays the rest of the way, so it never
+* plays more than an interval of ticks.
+*****************************************/
+class ReplayReader
+{
+public:
+   ReplayReader();
+
+   bool open(const char * in_fileName);
+   void close();
+
+   unsigned long long getSeed() const { return m_seed; }
+   int getRockCount() const { return m_rockCount; }
+   int getInterval() const { return m_interval; }
+   long long getTickCount() const { return m_tickCount; }
+   int getKeyframeCount() const { return m_segmentCount; }
+
+   // The input tick in_tick was given. Fails if the tick is out of
+   // range or its segment is damaged.
+   bool getInput(long long in_tick, GameInput &out_input) const;
+
+   // Puts the game as it was after in_tick ticks, from 0 to the tick
+   // count. Fails, leaving the game unknown, if the tick is out of
+   // range or its segment is damaged.
+   bool seek(Game &out_game, long long in_tick) const;
+
+private:
+   bool findSegment(int in_segment, const unsigned char * &out_snapshot,
+      size_t &out_snapshotSize, const unsigned char * &out_keys) const;
+
+   MappedFile m_file;
+   unsigned long long m_seed;
+   int m_rockCount;
+   int m_interval;
+   long long m_tickCount;
+   unsigned long long m_indexOffset;
+   int m_segmentCount;
+};
+
+#endif /* replayFile_h */
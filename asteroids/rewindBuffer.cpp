@@ -0,0 +1,380 @@
+/*************************************************************
+* File: rewindBuffer.cpp
+* Author: Matthew Burr
+*
+* Description: Contains the implementations of the
+*  method bodies for the RewindBuffer class.
+*
+*  A delta is the size of the older keyframe as a varint,
+*  then pairs of runs to the end of it: a varint count of
+*  four-byte words that are the same in both, a varint count
+*  of words that differ, and those words' bytes XOR'd
+*  together. Past the end of the newer keyframe its bytes
+*  count as zero.
+*************************************************************/
+
+#include "rewindBuffer.h"
+#include "game.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+using namespace std;
+
+#define VARINT_BITS 7
+#define VARINT_MORE 0x80
+#define MAX_VARINT_SIZE 10     // bytes in the longest 64-bit varint
+
+// Runs are counted in words, the size of most of what a snapshot holds
+#define WORD_SIZE 4
+
+/**********************************************************************
+* Function: writeVarint
+* Description: Appends a number seven bits to a byte, lowest first,
+*  with the top bit set on every byte but the last
+**********************************************************************/
+static void writeVarint(vector<unsigned char> &bytes, unsigned long long value)
+{
+   while (value >= VARINT_MORE)
+   {
+      bytes.push_back((unsigned char)(value | VARINT_MORE));
+      value >>= VARINT_BITS;
+   }
+   bytes.push_back((unsigned char)value);
+}
+
+/**********************************************************************
+* Function: readVarint
+* Description: Takes a number off the front of the bytes. Returns false
+*  if they run out first or it's too long to be a varint.
+**********************************************************************/
+static bool readVarint(const unsigned char * &next, const unsigned char * end,
+   unsigned long long &value)
+{
+   value = 0;
+   for (int i = 0; i < MAX_VARINT_SIZE && next < end; i++)
+   {
+      unsigned char byte = *next++;
+      value |= (unsigned long long)(byte & ~VARINT_MORE) << (i * VARINT_BITS);
+      if (!(byte & VARINT_MORE))
+         return true;
+   }
+   return false;
+}
+
+/**********************************************************************
+* Function: xorBytes
+* Description: XORs two runs of bytes into a third, which may be one
+*  of them, eight bytes at a time. The build isn't vectorized, and a
+*  byte at a time costs several times as much.
+**********************************************************************/
+static void xorBytes(unsigned char * out, const unsigned char * a,
+   const unsigned char * b, size_t count)
+{
+   size_t i = 0;
+   for (; i + sizeof(unsigned long long) <= count;
+        i += sizeof(unsigned long long))
+   {
+      unsigned long long x;
+      unsigned long long y;
+      memcpy(&x, a + i, sizeof(x));
+      memcpy(&y, b + i, sizeof(y));
+      x ^= y;
+      memcpy(out + i, &x, sizeof(x));
+   }
+   for (; i < count; i++)
+      out[i] = a[i] ^ b[i];
+}
+
+/**********************************************************************
+* Function: isSameWord
+* Description: True if a word both keyframes hold whole is the same in
+*  each
+**********************************************************************/
+static inline bool isSameWord(const unsigned char * older,
+   const unsigned char * newer, size_t word)
+{
+   unsigned a;
+   unsigned b;
+   memcpy(&a, older + word * WORD_SIZE, WORD_SIZE);
+   memcpy(&b, newer + word * WORD_SIZE, WORD_SIZE);
+   return a == b;
+}
+
+/**********************************************************************
+* Function: isSameTailWord
+* Description: True if a word of the older keyframe is the same in the
+*  newer one, which may stop partway through it or before it
+**********************************************************************/
+static bool isSameTailWord(const unsigned char * older, size_t olderSize,
+   const unsigned char * newer, size_t newerSize, size_t word)
+{
+   size_t begin = word * WORD_SIZE;
+   for (size_t i = begin; i < begin + WORD_SIZE && i < olderSize; i++)
+      if (older[i] != (i < newerSize ? newer[i] : 0))
+         return false;
+   return true;
+}
+
+/**********************************************************************
+* Function: encodeDelta
+* Description: Lays out what it takes to get the older keyframe back
+*  from the newer one. The keyframes are read through pointers taken
+*  out of the loops, as bytes written through a vector could be any of
+*  the vectors' own insides.
+**********************************************************************/
+static void encodeDelta(const vector<unsigned char> &older,
+   const vector<unsigned char> &newer, vector<unsigned char> &delta)
+{
+   delta.clear();
+   writeVarint(delta, older.size());
+
+   const unsigned char * a = older.empty() ? NULL : &older[0];
+   const unsigned char * b = newer.empty() ? NULL : &newer[0];
+   size_t aSize = older.size();
+   size_t bSize = newer.size();
+   size_t words = (aSize + WORD_SIZE - 1) / WORD_SIZE;
+   size_t common = min(aSize, bSize);
+   size_t wholeWords = common / WORD_SIZE;
+   size_t word = 0;
+   while (word < words)
+   {
+      size_t changed = word;
+      while (changed < wholeWords && isSameWord(a, b, changed))
+         changed++;
+      while (changed >= wholeWords && changed < words &&
+             isSameTailWord(a, aSize, b, bSize, changed))
+         changed++;
+      if (changed == words)
+         break;
+
+      size_t end = changed + 1;
+      while (end < wholeWords && !isSameWord(a, b, end))
+         end++;
+      while (end >= wholeWords && end < words &&
+             !isSameTailWord(a, aSize, b, bSize, end))
+         end++;
+
+      writeVarint(delta, changed - word);
+      writeVarint(delta, end - changed);
+
+      size_t from = changed * WORD_SIZE;
+      size_t to = min(end * WORD_SIZE, aSize);
+      size_t mixed = max(from, min(to, common));
+      size_t size = delta.size();
+      delta.resize(size + (to - from));
+      unsigned char * out = &delta[size];
+      xorBytes(out, a + from, b + from, mixed - from);
+      if (to > mixed)
+         memcpy(out + (mixed - from), a + mixed, to - mixed);
+      word = end;
+   }
+}
+
+/**********************************************************************
+* Function: decodeDelta
+* Description: Gets the older keyframe back from the newer one and the
+*  delta between them. Returns false if the delta is damaged.
+**********************************************************************/
+static bool decodeDelta(const vector<unsigned char> &delta,
+   const vector<unsigned char> &newer, vector<unsigned char> &older)
+{
+   const unsigned char * next = delta.empty() ? NULL : &delta[0];
+   const unsigned char * end = next + delta.size();
+   unsigned long long size;
+   if (!readVarint(next, end, size))
+      return false;
+
+   older.assign(newer.begin(), newer.begin() + min((size_t)size,
+      newer.size()));
+   older.resize((size_t)size, 0);
+
+   unsigned long long words = (size + WORD_SIZE - 1) / WORD_SIZE;
+   unsigned long long word = 0;
+   while (next < end)
+   {
+      unsigned long long same;
+      unsigned long long changed;
+      if (!readVarint(next, end, same) || !readVarint(next, end, changed) ||
+          same > words - word || changed > words - word - same)
+         return false;
+
+      size_t from = (size_t)((word + same) * WORD_SIZE);
+      size_t to = (size_t)min((word + same + changed) * WORD_SIZE, size);
+      if (to - from > (size_t)(end - next))
+         return false;
+
+      xorBytes(&older[from], &older[from], next, to - from);
+      next += to - from;
+      word += same + changed;
+   }
+   return true;
+}
+
+/**********************************************************************
+* Method: RewindBuffer
+* Description: Creates an empty buffer that holds at least
+*  in_tickCapacity ticks. It takes two more segments than that needs:
+*  one for the segment being filled, and one so dropping the oldest
+*  to start it still leaves enough whole ones behind.
+**********************************************************************/
+RewindBuffer::RewindBuffer(int in_tickCapacity, int in_interval)
+   : m_tickCapacity(max(in_tickCapacity, 1)),
+     m_interval(max(in_interval, 1)), m_tickCount(0), m_first(0),
+     m_count(0), m_cacheTicks(0)
+{
+   m_segments.resize((m_tickCapacity + m_interval - 1) / m_interval + 2);
+   for (size_t i = 0; i < m_segments.size(); i++)
+      m_segments[i].keys.reserve(m_interval);
+   m_cache.resize(m_interval);
+}
+
+/**********************************************************************
+* Method: record
+* Description: Adds the tick's keys to the newest segment, starting a
+*  new one with the game as its keyframe once the newest is full. The
+*  keyframe it follows is swapped for the delta back to it, and the
+*  buffers are swapped around so a full ring allocates nothing.
+**********************************************************************/
+void RewindBuffer::record(const Game &in_game, const GameInput &in_input)
+{
+   if (m_count == 0 || (int)getSegment(m_count - 1).keys.size() == m_interval)
+   {
+      if (m_count == (int)m_segments.size())
+         dropOldest();
+
+      in_game.saveSnapshot(m_snapshot);
+      Segment &next = getSegment(m_count);
+      if (m_count > 0)
+      {
+         Segment &last = getSegment(m_count - 1);
+         encodeDelta(last.keyframe, m_snapshot, next.keyframe);
+         last.keyframe.swap(next.keyframe);
+      }
+      next.keyframe.swap(m_snapshot);
+      next.keys.clear();
+      m_count++;
+      m_cacheTicks = 0;
+   }
+
+   // What was cached up to this tick still stands; what came after it
+   // may now play differently
+   Segment &newest = getSegment(m_count - 1);
+   m_cacheTicks = min(m_cacheTicks, (int)newest.keys.size());
+   newest.keys.push_back(packInput(in_input));
+   m_tickCount++;
+}
+
+/**********************************************************************
+* Method: stepBack
+* Description: Restores the state before the newest segment's last
+*  tick, from the cache or its keyframe, playing the segment into the
+*  cache first if it isn't there yet
+**********************************************************************/
+bool RewindBuffer::stepBack(Game &out_game)
+{
+   if (m_tickCount == 0)
+      return false;
+
+   if (getSegment(m_count - 1).keys.empty() && !dropNewest())
+   {
+      clear();
+      return false;
+   }
+
+   Segment &newest = getSegment(m_count - 1);
+   int tick = (int)newest.keys.size() - 1;
+   if (tick > m_cacheTicks && !fillCache(out_game, tick))
+      return false;
+
+   const vector<unsigned char> &state = (tick == 0) ? newest.keyframe :
+      m_cache[tick - 1];
+   if (!out_game.restoreSnapshot(&state[0], state.size()))
+      return false;
+
+   newest.keys.pop_back();
+   m_tickCount--;
+   return true;
+}
+
+/**********************************************************************
+* Method: clear
+* Description: Forgets every tick, keeping the memory for reuse
+**********************************************************************/
+void RewindBuffer::clear()
+{
+   m_tickCount = 0;
+   m_first = 0;
+   m_count = 0;
+   m_cacheTicks = 0;
+}
+
+/**********************************************************************
+* Method: getMemoryUsed
+* Description: Adds up what every buffer has allocated
+**********************************************************************/
+size_t RewindBuffer::getMemoryUsed() const
+{
+   size_t bytes = m_snapshot.capacity();
+   for (size_t i = 0; i < m_segments.size(); i++)
+      bytes += m_segments[i].keyframe.capacity() +
+         m_segments[i].keys.capacity();
+   for (size_t i = 0; i < m_cache.size(); i++)
+      bytes += m_cache[i].capacity();
+   return bytes;
+}
+
+/**********************************************************************
+* Method: dropOldest
+* Description: Forgets the oldest segment. Nothing depends on its
+*  keyframe, as each delta goes back from a newer one.
+**********************************************************************/
+void RewindBuffer::dropOldest()
+{
+   m_tickCount -= getSegment(0).keys.size();
+   m_first = (m_first + 1) % m_segments.size();
+   m_count--;
+}
+
+/**********************************************************************
+* Method: dropNewest
+* Description: Forgets the newest segment, once it has no ticks left,
+*  getting the keyframe before it back whole from its delta
+**********************************************************************/
+bool RewindBuffer::dropNewest()
+{
+   if (m_count < 2)
+      return false;
+
+   Segment &newest = getSegment(m_count - 1);
+   Segment &last = getSegment(m_count - 2);
+   if (!decodeDelta(last.keyframe, newest.keyframe, m_snapshot))
+      return false;
+
+   last.keyframe.swap(m_snapshot);
+   m_count--;
+   m_cacheTicks = 0;
+   return true;
+}
+
+/**********************************************************************
+* Method: fillCache
+* Description: Plays the newest segment on from the last state cached
+*  (or its keyframe) to in_tick, keeping each tick's state
+**********************************************************************/
+bool RewindBuffer::fillCache(Game &out_game, int in_tick)
+{
+   const Segment &newest = getSegment(m_count - 1);
+   const vector<unsigned char> &start = (m_cacheTicks == 0) ?
+      newest.keyframe : m_cache[m_cacheTicks - 1];
+   if (!out_game.restoreSnapshot(&start[0], start.size()))
+      return false;
+
+   for (int tick = m_cacheTicks; tick < in_tick; tick++)
+   {
+      out_game.advance();
+      out_game.handleInput(unpackInput(newest.keys[tick]));
+      out_game.saveSnapshot(m_cache[tick]);
+   }
+   m_cacheTicks = in_tick;
+   return true;
+}
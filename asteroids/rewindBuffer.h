@@ -0,0 +1,98 @@
+/*************************************************************
+* File: rewindBuffer.h
+* Author: Matthew Burr
+*
+* Description: Contains the declaration of the RewindBuffer,
+*  the last stretch of a game kept in a bounded amount of
+*  memory so it can be played backwards a tick at a time.
+*************************************************************/
+
+#ifndef rewindBuffer_h
+#define rewindBuffer_h
+
+#include "gameInput.h"
+#include <cstddef>
+#include <vector>
+
+class Game;
+
+// A second of play, as the game runs
+#define REWIND_KEYFRAME_INTERVAL 30
+
+/*****************************************
+* REWIND BUFFER
+* A ring of segments, each a keyframe and
+* the packed keys of up to an interval of
+* ticks played from it. The game plays the
+* same from the same state and keys, so
+* the ticks between keyframes never need
+* to be kept.
+*
+* The newest keyframe is kept whole. Each
+* older one is kept as its XOR with the
+* keyframe after it, with the runs of zero
+* words (what didn't change) left out, so
+* rewinding past a keyframe undoes one
+* delta. The oldest segment is dropped, and
+* its delta with it, once the buffer holds
+* its capacity in ticks.
+*
+* Stepping back into a segment plays it
+* once from its keyframe and keeps a
+* snapshot of each tick, so stepping on
+* back through it only restores them.
+*****************************************/
+class RewindBuffer
+{
+public:
+   RewindBuffer(int in_tickCapacity,
+      int in_interval = REWIND_KEYFRAME_INTERVAL);
+
+   // The game as it is before the next tick, and the input that tick
+   // is given
+   void record(const Game &in_game, const GameInput &in_input);
+
+   // Puts the game back as it was before the last tick recorded, and
+   // forgets that tick. Fails, leaving the game alone, once there are
+   // no ticks left.
+   bool stepBack(Game &out_game);
+
+   void clear();
+
+   long long getTickCount() const { return m_tickCount; }
+   int getTickCapacity() const { return m_tickCapacity; }
+
+   // Bytes held for keyframes, keys and the segment being rewound
+   size_t getMemoryUsed() const;
+
+private:
+   /*****************************************
+   * SEGMENT
+   * A keyframe and the keys played from it
+   *****************************************/
+   struct Segment
+   {
+      std::vector<unsigned char> keyframe;   // whole, or a delta
+      std::vector<unsigned char> keys;
+   };
+
+   Segment & getSegment(int in_index)
+   {
+      return m_segments[(m_first + in_index) % m_segments.size()];
+   }
+   void dropOldest();
+   bool dropNewest();
+   bool fillCache(Game &out_game, int in_tick);
+
+   int m_tickCapacity;
+   int m_interval;
+   long long m_tickCount;
+   std::vector<Segment> m_segments;
+   int m_first;
+   int m_count;
+   std::vector<unsigned char> m_snapshot;   // reused for new keyframes
+   std::vector< std::vector<unsigned char> > m_cache;
+   int m_cacheTicks;    // how many ticks of the newest segment are cached
+};
+
+#endif /* rewindBuffer_h */
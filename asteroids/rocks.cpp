@@ -9,7 +9,7 @@
 #include "point.h"
 #include "uiDraw.h"
 #include "velocity.h"
-#include <list>
+#include <cassert>
 
 #define MAX_DEGREES 360
 using namespace std;
@@ -22,17 +22,22 @@ using namespace std;
 * Method: Rock
 * Description: Creates a new instance of Rock
 **********************************************************************/
-Rock::Rock() : m_rotation(0)
+Rock::Rock(EntityType in_type) : m_type(in_type), m_rotation(0)
 {
+   assert(in_type < ROCK_KINDS);
 }
 
-Rock::Rock(const Point &in_point, float in_angle) : m_rotation(0)
+Rock::Rock(EntityType in_type, const Point &in_point, float in_angle)
+   : m_type(in_type), m_rotation(0)
 {
+   assert(in_type < ROCK_KINDS);
    launch(in_point, in_angle);
 }
 
-Rock::Rock(const Point & in_point, float dx, float dy) : m_rotation(0)
+Rock::Rock(EntityType in_type, const Point & in_point, float dx, float dy)
+   : m_type(in_type), m_rotation(0)
 {
+   assert(in_type < ROCK_KINDS);
    launch(in_point, dx, dy);
 }
 
@@ -61,12 +66,14 @@ void Rock::launch(const Point &in_point, float dx, float dy)
 /**********************************************************************
  * Method: HIT
  * Description: Hits the rock, potentially turning it into a set
- * of fragments.
+ * of fragments. The fragments are written to a caller's buffer,
+ * which must have room for MAX_ROCK_FRAGMENTS, and the number
+ * written is returned.
  **********************************************************************/
- std::list<Rock*>* Rock::hit()
+ int Rock::hit(RockFragment * fragments)
  {
     kill();
-    return getFragments();
+    return getRockFragments(m_type, getPoint(), getVelocity(), fragments);
  }
 
 /**********************************************************************
@@ -79,80 +86,31 @@ void Rock::advance()
    m_rotation = (m_rotation + getSpin()) % MAX_DEGREES;
 }
 
-/**********************************************************************
- * BIG ROCK CLASS IMPLEMENTATION
- **********************************************************************/
-/**********************************************************************
- * Method: getFragments
- * Description: Gets the fragments from this rock
- **********************************************************************/
-std::list<Rock*>* BigRock::getFragments()
-{
-   float dx = getVelocity().getDx();
-   float dy = getVelocity().getDy();
-   list<Rock*> * fragments = new list<Rock*>;
-
-   fragments->push_back(new MediumRock(getPoint(), dx, dy + 1));
-   fragments->push_back(new MediumRock(getPoint(), dx, dy - 1));
-   fragments->push_back(new SmallRock(getPoint(), dx + 2, dy));
-
-   return fragments;
-}
-
 /**********************************************************************
  * Method: draw
- * Description: Draws the BigRock on the screen
+ * Description: Draws the rock on the screen
  **********************************************************************/
-void BigRock::draw() const
+void Rock::draw() const
 {
-   drawLargeAsteroid(getPoint(), getRotation());
+   drawRock(m_type, getPoint(), getRotation());
 }
 
 /**********************************************************************
-* MEDIUM ROCK CLASS IMPLEMENTATION
-**********************************************************************/
-/**********************************************************************
- * Method: getFragments
- * Description: Gets the fragments from this rock
+ * ROCK SHAPES
+ * The outline each RockShape is drawn with
  **********************************************************************/
-std::list<Rock*>* MediumRock::getFragments()
+static void (* const ROCK_SHAPE_DRAWERS[])(const Point &, int) =
 {
-   float dx = getVelocity().getDx();
-   float dy = getVelocity().getDy();
-   list<Rock*> * fragments = new list<Rock*>;
-
-   fragments->push_back(new SmallRock(getPoint(), dx + 3, dy));
-   fragments->push_back(new SmallRock(getPoint(), dx - 3, dy));
-
-   return fragments;
-}
+   drawLargeAsteroid,   // ROCK_SHAPE_LARGE
+   drawMediumAsteroid,  // ROCK_SHAPE_MEDIUM
+   drawSmallAsteroid    // ROCK_SHAPE_SMALL
+};
 
 /**********************************************************************
- * Method: draw
- * Description: Draws the rock on the screen
+ * Function: drawRock
+ * Description: Draws a rock of a given kind on the screen
  **********************************************************************/
-void MediumRock::draw() const
-{
-   drawMediumAsteroid(getPoint(), getRotation());
-}
-
-/**********************************************************************
-* SMALL ROCK CLASS IMPLEMENTATION
-**********************************************************************/
-/**********************************************************************
-* Method: getFragments
-* Description: Gets the fragments from this rock
-**********************************************************************/
-std::list<Rock*>* SmallRock::getFragments()
+void drawRock(EntityType type, const Point &point, int rotation)
 {
-   return new std::list<Rock*> ;
+   ROCK_SHAPE_DRAWERS[getRockArchetype(type).shape](point, rotation);
 }
-
-/**********************************************************************
-* Method: draw
-* Description: Draws the rock on the screen
-**********************************************************************/
-void SmallRock::draw() const
-{
-   drawSmallAsteroid(getPoint(), getRotation());
-}
\ No newline at end of file
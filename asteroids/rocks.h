@@ -11,7 +11,8 @@
 
 #include "flyingObject.h"
 #include "point.h"
-#include <list>
+#include "entityStore.h"
+#include "velocity.h"
 
 #define BIG_ROCK_SIZE 16
 #define MEDIUM_ROCK_SIZE 8
@@ -23,101 +24,203 @@
 
 #define DEFAULT_ROCK_SPEED 1
 
-// Define the following classes here:
+// The most fragments any rock breaks into
+#define MAX_ROCK_FRAGMENTS 3
+
+/*****************************************
+* ROCK FRAGMENT
+* A description of a rock that breaks off
+* another rock when it is hit
+*****************************************/
+struct RockFragment
+{
+   EntityType type;
+   Point point;
+   Velocity velocity;
+};
+
+/*****************************************
+* ROCK SHAPE
+* Which outline a rock is drawn with
+*****************************************/
+enum RockShape
+{
+   ROCK_SHAPE_LARGE,
+   ROCK_SHAPE_MEDIUM,
+   ROCK_SHAPE_SMALL
+};
+
+/*****************************************
+* ROCK ARCHETYPE
+* Everything that makes one kind of rock
+* different from another. A fragment is
+* launched from the rock that broke, with
+* that rock's velocity plus an offset.
+*****************************************/
+struct FragmentRecipe
+{
+   EntityType type;
+   float dx;
+   float dy;
+};
+
+struct RockArchetype
+{
+   float radius;
+   int spin;
+   RockShape shape;
+   int fragmentCount;
+   FragmentRecipe fragments[MAX_ROCK_FRAGMENTS];
+};
+
+/*****************************************
+* ROCK ARCHETYPES
+* One row per kind of rock, in the same
+* order as the rock entries of EntityType.
+*****************************************/
+constexpr RockArchetype ROCK_ARCHETYPES[] =
+{
+   // ENTITY_BIG_ROCK: 2 Medium and 1 Small Rock
+   { BIG_ROCK_SIZE, BIG_ROCK_SPIN, ROCK_SHAPE_LARGE, 3,
+     { { ENTITY_MEDIUM_ROCK, 0, 1 },
+       { ENTITY_MEDIUM_ROCK, 0, -1 },
+       { ENTITY_SMALL_ROCK, 2, 0 } } },
+
+   // ENTITY_MEDIUM_ROCK: 2 Small Rocks
+   { MEDIUM_ROCK_SIZE, MEDIUM_ROCK_SPIN, ROCK_SHAPE_MEDIUM, 2,
+     { { ENTITY_SMALL_ROCK, 3, 0 },
+       { ENTITY_SMALL_ROCK, -3, 0 } } },
+
+   // ENTITY_SMALL_ROCK: simply disappears
+   { SMALL_ROCK_SIZE, SMALL_ROCK_SPIN, ROCK_SHAPE_SMALL, 0,
+     { } }
+};
+
+#define ROCK_KINDS ((int)(sizeof(ROCK_ARCHETYPES) / sizeof(ROCK_ARCHETYPES[0])))
+static_assert(ROCK_KINDS == ENTITY_BULLET,
+   "every rock kind in EntityType needs a row in ROCK_ARCHETYPES");
+
+/**********************************************************************
+* ROCK ARCHETYPE LOOKUPS
+* Inline so that a lookup with a known kind folds to a constant
+**********************************************************************/
+inline const RockArchetype & getRockArchetype(EntityType type)
+{
+   return ROCK_ARCHETYPES[type];
+}
+
+inline float getRockRadius(EntityType type)
+{
+   return ROCK_ARCHETYPES[type].radius;
+}
+
+inline int getRockSpin(EntityType type)
+{
+   return ROCK_ARCHETYPES[type].spin;
+}
+
+/**********************************************************************
+* GET ROCK FRAGMENTS
+* Writes the fragments a rock of a given kind breaks into to a buffer
+* with room for MAX_ROCK_FRAGMENTS and returns how many it wrote
+**********************************************************************/
+inline int getRockFragments(EntityType type, const Point &point,
+   const Velocity &velocity, RockFragment * fragments)
+{
+   const RockArchetype & archetype = ROCK_ARCHETYPES[type];
+
+   for (int i = 0; i < archetype.fragmentCount; i++)
+   {
+      fragments[i].type = archetype.fragments[i].type;
+      fragments[i].point = point;
+      fragments[i].velocity = Velocity(
+         velocity.getDx() + archetype.fragments[i].dx,
+         velocity.getDy() + archetype.fragments[i].dy);
+   }
+
+   return archetype.fragmentCount;
+}
+
+void drawRock(EntityType type, const Point &point, int rotation);
+
 /*****************************************
 * ROCK
-* An abstract class that is the base of
-* all Rock classes. A Rock is a FlyingObject
-* that also rotates and, when hit, may
-* fragment into other Rocks.
+* A Rock is a FlyingObject that also
+* rotates and, when hit, may fragment
+* into other Rocks. What kind of rock it
+* is comes from its type tag and the
+* ROCK_ARCHETYPES table, not from
+* virtual functions.
 *****************************************/
 class Rock : public FlyingObject
 {
 public:
-   Rock();
-   Rock(const Point &in_point, float in_angle);
-   Rock(const Point &in_point, float dx, float dy);
+   Rock(EntityType in_type);
+   Rock(EntityType in_type, const Point &in_point, float in_angle);
+   Rock(EntityType in_type, const Point &in_point, float dx, float dy);
    void launch(const Point &in_point, float in_angle);
    void launch(const Point &in_point, float dx, float dy);
-   virtual std::list<Rock*> * hit();
+   int hit(RockFragment * fragments);
    virtual void advance();
-
-protected:
-   virtual int getSpin() const = 0;
+   virtual void draw() const;
+   virtual float getRadius() const { return getRockRadius(m_type); }
+   EntityType getType() const { return m_type; }
+   int getSpin() const { return getRockSpin(m_type); }
    int getRotation() const { return m_rotation; }
-   virtual std::list<Rock*> * getFragments() = 0;
 
 private:
+   EntityType m_type;
    int m_rotation;
 };
 
 
 /*****************************************
 * BIG ROCK
-* A subclass of Rock representing a large
-* Rock that moves slowly and breaks into
-* 2 Medium and 1 Small Rock when hit.
+* A large Rock that moves slowly and
+* breaks into 2 Medium and 1 Small Rock
+* when hit.
 *****************************************/
 class BigRock : public Rock
 {
 public:
-   BigRock() {};
+   BigRock() : Rock(ENTITY_BIG_ROCK) {};
    BigRock(const Point &in_point, float in_angle) 
-      : Rock(in_point, in_angle) { };
+      : Rock(ENTITY_BIG_ROCK, in_point, in_angle) { };
    BigRock(const Point &in_point, float dx, float dy)
-      : Rock(in_point, dx, dy) { };
-   virtual std::list<Rock*> * getFragments();
-   virtual void draw() const;
-   virtual float getRadius() const { return BIG_ROCK_SIZE; }
-
-protected:
-   virtual int getSpin() const { return BIG_ROCK_SPIN; }
+      : Rock(ENTITY_BIG_ROCK, in_point, dx, dy) { };
 };
 
 
 /*****************************************
 * MEDIUM ROCK
-* A subclass of Rock representing a medium
-* Rock that breaks into 2 Small Rocks when hit.
+* A medium Rock that breaks into 2 Small
+* Rocks when hit.
 *****************************************/
 class MediumRock : public Rock
 {
 public:
-   MediumRock() {};
+   MediumRock() : Rock(ENTITY_MEDIUM_ROCK) {};
    MediumRock(const Point &in_point, float in_angle) 
-      : Rock(in_point, in_angle) { };
+      : Rock(ENTITY_MEDIUM_ROCK, in_point, in_angle) { };
    MediumRock(const Point &in_point, float dx, float dy)
-      : Rock(in_point, dx, dy) { };
-   virtual std::list<Rock*> * getFragments();
-   virtual void draw() const;
-   virtual float getRadius() const { return MEDIUM_ROCK_SIZE; }
-
-protected:
-   virtual int getSpin() const { return MEDIUM_ROCK_SPIN; }
+      : Rock(ENTITY_MEDIUM_ROCK, in_point, dx, dy) { };
 };
 
 
 /*****************************************
 * SMALL ROCK
-* A subclass of Rock representing a small
-* Rock that moves quickly and simply
-* disappears leaving no fragments when 
-* hit.
+* A small Rock that moves quickly and
+* simply disappears leaving no fragments
+* when hit.
 *****************************************/
 class SmallRock : public Rock
 {
 public:
-   SmallRock() {};
+   SmallRock() : Rock(ENTITY_SMALL_ROCK) {};
    SmallRock(const Point &in_point, float in_angle) 
-      : Rock(in_point, in_angle) { };
+      : Rock(ENTITY_SMALL_ROCK, in_point, in_angle) { };
    SmallRock(const Point &in_point, float dx, float dy)
-      : Rock(in_point, dx, dy) {};
-   virtual std::list<Rock*> * getFragments();
-   virtual void draw() const;
-   virtual float getRadius() const { return SMALL_ROCK_SIZE; }
-
-protected:
-   virtual int getSpin() const { return SMALL_ROCK_SPIN; }
+      : Rock(ENTITY_SMALL_ROCK, in_point, dx, dy) {};
 };
 
 
@@ -0,0 +1,89 @@
+/*************************************************************
+* File: rotatedShape.cpp
+* Author: Matthew Burr
+*
+* Description: Contains the implementations of the
+*  method bodies for the RotatedShape class.
+*************************************************************/
+
+#ifdef _WIN32
+#define _USE_MATH_DEFINES
+#endif
+
+#include "rotatedShape.h"
+#include <cassert>
+#include <cmath>
+#include <map>
+
+#define deg2rad(value) ((M_PI / 180) * (value))
+using namespace std;
+
+/**********************************************************************
+* Method: RotatedShape
+* Description: Works out the outline at every rotation. The math is
+*  rotate()'s: double precision, truncated toward zero with
+*  static_cast<int>.
+**********************************************************************/
+RotatedShape::RotatedShape(const ShapePoint *in_points, int in_count)
+   : m_count(in_count), m_outlines(in_count * SHAPE_ROTATIONS)
+{
+   assert(in_count > 0);
+
+   for (int rotation = 0; rotation < SHAPE_ROTATIONS; rotation++)
+   {
+      double cosA = cos(deg2rad(rotation));
+      double sinA = sin(deg2rad(rotation));
+      ShapePoint *outline = &m_outlines[rotation * m_count];
+
+      for (int i = 0; i < m_count; i++)
+      {
+         outline[i].x = static_cast<int> (in_points[i].x * cosA -
+                                          in_points[i].y * sinA);
+         outline[i].y = static_cast<int> (in_points[i].x * sinA +
+                                          in_points[i].y * cosA);
+      }
+   }
+}
+
+/**********************************************************************
+* Method: getOutline
+* Description: The outline turned by a number of degrees, which may be
+*  negative or more than a full turn
+**********************************************************************/
+const ShapePoint * RotatedShape::getOutline(int in_rotation) const
+{
+   int rotation = in_rotation % SHAPE_ROTATIONS;
+   if (rotation < 0)
+      rotation += SHAPE_ROTATIONS;
+
+   return &m_outlines[rotation * m_count];
+}
+
+/**********************************************************************
+* Method: getPolygon
+* Description: A regular polygon, as drawPolygon() draws it. Each size
+*  is worked out the first time it is asked for and kept.
+**********************************************************************/
+const RotatedShape & RotatedShape::getPolygon(int in_radius, int in_points)
+{
+   static map<pair<int, int>, RotatedShape> polygons;
+   pair<int, int> size(in_radius, in_points);
+   map<pair<int, int>, RotatedShape>::iterator it = polygons.find(size);
+
+   if (it == polygons.end())
+   {
+      // a point every so far around the circle
+      vector<ShapePoint> outline;
+      for (double i = 0; i < 2 * M_PI; i += (2 * M_PI) / in_points)
+      {
+         ShapePoint point = { (float)(in_radius * cos(i)),
+                              (float)(in_radius * sin(i)) };
+         outline.push_back(point);
+      }
+
+      RotatedShape polygon(&outline[0], (int)outline.size());
+      it = polygons.insert(make_pair(size, polygon)).first;
+   }
+
+   return it->second;
+}
@@ -0,0 +1,52 @@
+/*************************************************************
+* File: rotatedShape.h
+* Author: Matthew Burr
+*
+* Description: Contains the declaration of RotatedShape, an
+*  outline worked out ahead of time at every whole-degree
+*  rotation, so drawing it needs no sine or cosine.
+*************************************************************/
+
+#ifndef rotatedShape_h
+#define rotatedShape_h
+
+#include <vector>
+
+#define SHAPE_ROTATIONS 360
+
+/*****************************************
+* SHAPE POINT
+* A vertex as an offset from the center
+* of its shape
+*****************************************/
+struct ShapePoint
+{
+   float x;
+   float y;
+};
+
+/*****************************************
+* ROTATED SHAPE
+* Holds an outline turned to each of the
+* 360 whole degrees. The offsets are
+* snapped to whole pixels the same way
+* rotate() in uiDraw.cpp snaps them, so
+* the center plus an offset lands where
+* rotating the vertex would have put it.
+*****************************************/
+class RotatedShape
+{
+public:
+   RotatedShape(const ShapePoint *in_points, int in_count);
+
+   int getCount() const { return m_count; }
+   const ShapePoint * getOutline(int in_rotation) const;
+
+   static const RotatedShape & getPolygon(int in_radius, int in_points);
+
+private:
+   int m_count;
+   std::vector<ShapePoint> m_outlines;    // m_count per rotation
+};
+
+#endif /* rotatedShape_h */
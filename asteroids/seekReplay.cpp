@@ -0,0 +1,168 @@
+/*****************************************************
+ * File: seekReplay.cpp
+ * Author: Matthew Burr
+ *
+ * Description: Builds a replay that can be played
+ *  from any tick out of a recording, and jumps to a
+ *  tick in one.
+ *
+ *  Usage: seekReplay build record.log session.replay
+ *                    [interval]
+ *         seekReplay seek session.replay tick
+ *                    [snapshot]
+ *
+ *  Building plays the recording once, keeping the
+ *  game every interval ticks. Seeking reports how
+ *  long opening and seeking took and the game at
+ *  that tick, and given a file name saves the game
+ *  as a snapshot for compareRuns.
+ ******************************************************/
+#include "game.h"
+#include "gameInput.h"
+#include "inputLog.h"
+#include "replayFile.h"
+#include "point.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+using namespace std;
+
+/*********************************
+ * SECONDS SINCE
+ *********************************/
+double secondsSince(chrono::steady_clock::time_point start)
+{
+   return chrono::duration<double>(chrono::steady_clock::now() -
+      start).count();
+}
+
+/*********************************
+ * BUILD
+ * Plays a recording into a replay
+ * file, in the order the display
+ * loop played it
+ *********************************/
+int build(const char * logFileName, const char * replayFileName,
+   int interval)
+{
+   InputLog log;
+   if (!log.load(logFileName))
+   {
+      fprintf(stderr, "seekReplay: can't read a recording from %s\n",
+         logFileName);
+      return 1;
+   }
+
+   Point topLeft(-200, 200);
+   Point bottomRight(200, -200);
+   Game game(topLeft, bottomRight, log.getRockCount(), MAX_BULLETS,
+      log.getSeed());
+
+   ReplayWriter writer;
+   bool isWritten = writer.open(replayFileName, log.getSeed(),
+      log.getRockCount(), interval);
+   for (int run = 0; isWritten && run < log.getRunCount(); run++)
+   {
+      GameInput input = unpackInput(log.getRun(run).keys);
+      for (int tick = 0; isWritten && tick < log.getRun(run).length; tick++)
+      {
+         isWritten = writer.addTick(game, input);
+         game.advance();
+         game.handleInput(input);
+      }
+   }
+   if (!writer.close() || !isWritten)
+   {
+      fprintf(stderr, "seekReplay: can't write %s\n", replayFileName);
+      return 1;
+   }
+
+   printf("ticks:     %lld\n", writer.getTickCount());
+   printf("interval:  %d\n", interval);
+   printf("hash:      %016llx\n", game.getStateHash());
+   return 0;
+}
+
+/*********************************
+ * SEEK
+ * Jumps to a tick in a replay file
+ *********************************/
+int seek(const char * replayFileName, long long tick,
+   const char * snapshotFileName)
+{
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   ReplayReader reader;
+   if (!reader.open(replayFileName))
+   {
+      fprintf(stderr, "seekReplay: can't read a replay from %s\n",
+         replayFileName);
+      return 1;
+   }
+   double openSeconds = secondsSince(start);
+
+   Point topLeft(-200, 200);
+   Point bottomRight(200, -200);
+   Game game(topLeft, bottomRight, 0);
+   start = chrono::steady_clock::now();
+   if (!reader.seek(game, tick))
+   {
+      fprintf(stderr, "seekReplay: can't seek to tick %lld of %lld\n", tick,
+         reader.getTickCount());
+      return 1;
+   }
+   double seekSeconds = secondsSince(start);
+
+   if (snapshotFileName)
+   {
+      vector<unsigned char> bytes;
+      game.saveSnapshot(bytes);
+      FILE *file = fopen(snapshotFileName, "wb");
+      bool isWritten = file != NULL &&
+         fwrite(&bytes[0], 1, bytes.size(), file) == bytes.size();
+      if (file == NULL || fclose(file) != 0 || !isWritten)
+      {
+         fprintf(stderr, "seekReplay: can't write %s\n", snapshotFileName);
+         return 1;
+      }
+   }
+
+   printf("ticks:     %lld\n", reader.getTickCount());
+   printf("keyframes: %d\n", reader.getKeyframeCount());
+   printf("tick:      %lld\n", tick);
+   printf("open ms:   %.3f\n", openSeconds * 1e3);
+   printf("seek ms:   %.3f\n", seekSeconds * 1e3);
+   printf("score:     %d\n", game.getScore());
+   printf("lives:     %d\n", game.getLives());
+   printf("rocks:     %d\n", game.getRockCount());
+   printf("bullets:   %d\n", game.getBulletCount());
+   printf("hash:      %016llx\n", game.getStateHash());
+   return 0;
+}
+
+/*********************************
+ * Main builds or seeks
+ *********************************/
+int main(int argc, char ** argv)
+{
+   if (argc >= 4 && argc <= 5 && strcmp(argv[1], "build") == 0)
+   {
+      int interval = (argc > 4) ? atoi(argv[4]) : KEYFRAME_INTERVAL;
+      if (interval < 1)
+      {
+         fprintf(stderr, "seekReplay: the interval must be at least 1\n");
+         return 1;
+      }
+      return build(argv[2], argv[3], interval);
+   }
+
+   if (argc >= 4 && argc <= 5 && strcmp(argv[1], "seek") == 0)
+      return seek(argv[2], atoll(argv[3]), (argc > 4) ? argv[4] : NULL);
+
+   fprintf(stderr, "usage: seekReplay build record.log session.replay "
+      "[interval]\n");
+   fprintf(stderr, "       seekReplay seek session.replay tick "
+      "[snapshot]\n");
+   return 1;
+}
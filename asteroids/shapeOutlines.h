@@ -0,0 +1,133 @@
+/***********************************************************************
+ * Header File:
+ *    Shape Outlines : what everything looks like
+ * Author:
+ *    Matthew Burr
+ * Summary:
+ *    The outlines of the digits, the lander, the rocks and the ship,
+ *    each point an offset from where the shape is drawn. Every drawing
+ *    back end (uiDraw.cpp, uiDrawRaster.cpp) draws from these, so they
+ *    all look the same.
+ ************************************************************************/
+
+#ifndef SHAPE_OUTLINES_H
+#define SHAPE_OUTLINES_H
+
+#include "rotatedShape.h"   // for ShapePoint
+
+/*********************************************
+ * NUMBER OUTLINES
+ * We are drawing the text for score and things
+ * like that by hand to make it look "old school."
+ * These are how we render each individual charactger.
+ * Note how -1 indicates "done".  These are paired
+ * coordinates where the even are the x and the odd
+ * are the y and every 2 pairs represents a point
+ ********************************************/
+const char NUMBER_OUTLINES[10][20] =
+{
+  {0, 0,  7, 0,   7, 0,  7,10,   7,10,  0,10,   0,10,  0, 0,  -1,-1, -1,-1},//0
+  {7, 0,  7,10,  -1,-1, -1,-1,  -1,-1, -1,-1,  -1,-1, -1,-1,  -1,-1, -1,-1},//1
+  {0, 0,  7, 0,   7, 0,  7, 5,   7, 5,  0, 5,   0, 5,  0,10,   0,10,  7,10},//2
+  {0, 0,  7, 0,   7, 0,  7,10,   7,10,  0,10,   4, 5,  7, 5,  -1,-1, -1,-1},//3
+  {0, 0,  0, 5,   0, 5,  7, 5,   7, 0,  7,10,  -1,-1, -1,-1,  -1,-1, -1,-1},//4
+  {7, 0,  0, 0,   0, 0,  0, 5,   0, 5,  7, 5,   7, 5,  7,10,   7,10,  0,10},//5
+  {7, 0,  0, 0,   0, 0,  0,10,   0,10,  7,10,   7,10,  7, 5,   7, 5,  0, 5},//6
+  {0, 0,  7, 0,   7, 0,  7,10,  -1,-1, -1,-1,  -1,-1, -1,-1,  -1,-1, -1,-1},//7
+  {0, 0,  7, 0,   0, 5,  7, 5,   0,10,  7,10,   0, 0,  0,10,   7, 0,  7,10},//8
+  {0, 0,  7, 0,   7, 0,  7,10,   0, 0,  0, 5,   0, 5,  7, 5,  -1,-1, -1,-1} //9
+};
+
+/*********************************************
+ * LANDER
+ * A line strip
+ ********************************************/
+const ShapePoint LANDER_OUTLINE[] =
+{
+   {-6, 0}, {-10,0}, {-8, 0}, {-8, 3},  // left foot
+   {-5, 4}, {-5, 7}, {-8, 3}, {-5, 4},  // left leg
+   {-1, 4}, {-3, 2}, { 3, 2}, { 1, 4}, {-1, 4}, // bottom
+   { 5, 4}, { 5, 7}, {-5, 7}, {-3, 7},  // engine square
+   {-6,10}, {-6,13}, {-3,16}, { 3,16},   // left of habitat
+   { 6,13}, { 6,10}, { 3, 7}, { 5, 7},   // right of habitat
+   { 5, 4}, { 8, 3}, { 5, 7}, { 5, 4},  // right leg
+   { 8, 3}, { 8, 0}, {10, 0}, { 6, 0}   // right foot
+};
+
+/*********************************************
+ * LANDER FLAMES
+ * Three flickers of each thruster. The thrusters
+ * that are on are drawn as one line loop, each
+ * flame between the two points of its nozzle.
+ ********************************************/
+const ShapePoint LANDER_FLAMES_BOTTOM[3][3] =
+{
+   { {-5,  -6}, { 0, -1}, { 3, -10} },
+   { {-3,  -6}, {-1, -2}, { 0, -15} },
+   { { 2, -12}, { 1,  0}, { 6,  -4} }
+};
+const ShapePoint LANDER_NOZZLE_BOTTOM[2] = { {-2, 2}, { 2, 2} };
+
+const ShapePoint LANDER_FLAMES_RIGHT[3][3] =
+{
+   { {10, 14}, { 8, 12}, {12, 12} },
+   { {12, 10}, { 8, 10}, {10,  8} },
+   { {14, 11}, {14, 11}, {14, 11} }
+};
+const ShapePoint LANDER_NOZZLE_RIGHT[2] = { { 6, 12}, { 6, 10} };
+
+const ShapePoint LANDER_FLAMES_LEFT[3][3] =
+{
+   { {-10, 14}, { -8, 12}, {-12, 12} },
+   { {-12, 10}, { -8, 10}, {-10,  8} },
+   { {-14, 11}, {-14, 11}, {-14, 11} }
+};
+const ShapePoint LANDER_NOZZLE_LEFT[2] = { {-6, 12}, {-6, 10} };
+
+/*********************************************
+ * ROCKS
+ * Line strips, turned by the rock's rotation
+ ********************************************/
+const ShapePoint SMALL_ROCK_OUTLINE[] =
+{
+   {-5, 9},  {4, 8},   {8, 4},   
+   {8, -5},  {-2, -8}, {-2, -3}, 
+   {-8, -4}, {-8, 4},  {-5, 10}
+};
+
+const ShapePoint MEDIUM_ROCK_OUTLINE[] =
+{
+   {2, 8},    {8, 15},    {12, 8}, 
+   {6, 2},    {12, -6},   {2, -15},
+   {-6, -15}, {-14, -10}, {-15, 0},
+   {-4, 15},  {2, 8}
+};
+
+const ShapePoint LARGE_ROCK_OUTLINE[] =
+{
+   {0, 12},    {8, 20}, {16, 14},
+   {10, 12},   {20, 0}, {0, -20},
+   {-18, -10}, {-20, -2}, {-20, 14},
+   {-10, 20},  {0, 12}
+};
+
+/*********************************************
+ * SHIP
+ * A line strip, and three flickers of its red
+ * flame, all turned by the ship's rotation
+ ********************************************/
+const ShapePoint SHIP_OUTLINE[] =
+{ // top   r.wing   r.engine l.engine  l.wing    top
+   {0, 6}, {6, -6}, {2, -3}, {-2, -3}, {-6, -6}, {0, 6}  
+};
+
+const ShapePoint SHIP_FLAMES[3][5] =
+{
+   { {-2, -3}, {-2, -13}, { 0, -6}, { 2, -13}, {2, -3} },
+   { {-2, -3}, {-4,  -9}, {-1, -7}, { 1, -14}, {2, -3} },
+   { {-2, -3}, {-1, -14}, { 1, -7}, { 4,  -9}, {2, -3} }
+};
+
+#define SHAPE_COUNT(points) (int)(sizeof(points) / sizeof(points[0]))
+
+#endif // SHAPE_OUTLINES_H
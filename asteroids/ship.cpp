@@ -9,6 +9,8 @@
 #include "uiDraw.h"
 #include "bullet.h"
 #include "flyingObject.h"
+#include "snapshot.h"
+#include "stateHash.h"
 #include <cassert>
 
 #define ROTATION_DRAW_OFFSET 90
@@ -70,6 +72,16 @@ void Ship::advance()
  * Description: Draws a ship on the screen
  **********************************************************************/
 void Ship::draw() const
+{
+   draw(getPoint());
+}
+
+/**********************************************************************
+ * Method: draw
+ * Description: Draws the ship somewhere other than where it is, such
+ *  as partway along its last move, with one of its flames
+ **********************************************************************/
+void Ship::draw(const Point &in_point, int in_flame) const
 {
    // As an indicator of invulnerability, we "flash" the ship
    // on and off while it's invulnerable
@@ -79,11 +91,13 @@ void Ship::draw() const
       // using the timer as a convenient way to determine
       // whether to draw it this frame or not
       if (m_invulnerableTimer % BLINK_PACE < BLINK_LIMIT)
-         drawShip(getPoint(), m_rotation - ROTATION_DRAW_OFFSET, m_drawThrust);
+         drawShip(in_point, m_rotation - ROTATION_DRAW_OFFSET, m_drawThrust,
+            in_flame);
    }
    else
    {
-      drawShip(getPoint(), m_rotation - ROTATION_DRAW_OFFSET, m_drawThrust);
+      drawShip(in_point, m_rotation - ROTATION_DRAW_OFFSET, m_drawThrust,
+         in_flame);
    }
 }
 
@@ -151,4 +165,58 @@ Bullet Ship::fire() const
    b.fire(getPoint(), m_rotation);
    b += getVelocity();
    return b;
-}
\ No newline at end of file
+}
+
+/**********************************************************************
+* Method: save
+* Description: Writes the ship's state to a snapshot
+**********************************************************************/
+void Ship::save(SnapshotWriter &out) const
+{
+   FlyingObject::save(out);
+   out.write(m_rotation);
+   out.write(m_invulnerableTimer);
+   out.write((unsigned char)m_thrusted);
+   out.write((unsigned char)m_drawThrust);
+   out.write((unsigned char)m_isInvulnerable);
+}
+
+/**********************************************************************
+* Method: restore
+* Description: Reads back what save wrote
+**********************************************************************/
+void Ship::restore(SnapshotReader &in)
+{
+   FlyingObject::restore(in);
+
+   int rotation, invulnerableTimer;
+   unsigned char thrusted, drawThrust, isInvulnerable;
+   in.read(rotation);
+   in.read(invulnerableTimer);
+   in.read(thrusted);
+   in.read(drawThrust);
+   if (!in.read(isInvulnerable))
+      return;
+
+   m_rotation = rotation;
+   m_invulnerableTimer = invulnerableTimer;
+   m_thrusted = thrusted != 0;
+   m_drawThrust = drawThrust != 0;
+   m_isInvulnerable = isInvulnerable != 0;
+}
+
+/**********************************************************************
+* Method: getHash
+* Description: Hashes what save writes, so two ships hash the same
+*  exactly when their snapshots match
+**********************************************************************/
+unsigned Ship::getHash() const
+{
+   int flags = (int)isAlive() | (int)m_thrusted << 1 |
+      (int)m_drawThrust << 2 | (int)m_isInvulnerable << 3;
+
+   return hashMix(hashMotion(getPoint().getX(), getPoint().getY(),
+      m_rotation, m_invulnerableTimer) +
+      hashBody(getVelocity().getDx(), getVelocity().getDy(), getRadius(),
+      flags, 0));
+}
@@ -10,6 +10,7 @@
 
 #include "flyingObject.h"
 #include "bullet.h"
+#include "uiDraw.h"
 
 #define SHIP_SIZE 10
 
@@ -29,6 +30,7 @@ public:
    virtual float getRadius() const { return SHIP_SIZE; }
    virtual void advance();
    virtual void draw() const;
+   void draw(const Point &in_point, int in_flame = RANDOM_FLAME) const;
    void rotateRight();
    void rotateLeft();
    void thrust();
@@ -36,6 +38,13 @@ public:
    void setInvulnerable(int in_timer);
    Bullet fire() const;
 
+   // Everything about the ship, down to where it is in blinking
+   void save(SnapshotWriter &out) const;
+   void restore(SnapshotReader &in);
+
+   // The same, summed up as one number (see stateHash.h)
+   unsigned getHash() const;
+
 private:
    int m_rotation;
    int m_invulnerableTimer;
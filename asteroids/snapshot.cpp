@@ -0,0 +1,51 @@
+/*************************************************************
+* File: snapshot.cpp
+* Author: Matthew Burr
+*
+* Description: Contains the implementations of the
+*  method bodies for the SnapshotReader class.
+*************************************************************/
+
+#include "snapshot.h"
+#include <cstring>
+
+/**********************************************************************
+* Method: read
+* Description: Copies the next bytes of the snapshot out. Fails, and
+*  copies nothing, if there aren't that many left.
+**********************************************************************/
+bool SnapshotReader::read(void * out_data, size_t in_size)
+{
+   if (!m_isOk || in_size > getRemaining())
+   {
+      m_isOk = false;
+      return false;
+   }
+
+   if (in_size > 0)
+      memcpy(out_data, m_data + m_offset, in_size);
+   m_offset += in_size;
+   return true;
+}
+
+/**********************************************************************
+* Method: readCount
+* Description: Reads a count of entries that follow, checking it
+*  against what's left so a damaged snapshot can't ask for a vast
+*  amount of memory
+**********************************************************************/
+bool SnapshotReader::readCount(int &out_count, size_t in_entrySize)
+{
+   int count = 0;
+   if (!read(count))
+      return false;
+
+   if (count < 0 || (size_t)count * in_entrySize > getRemaining())
+   {
+      m_isOk = false;
+      return false;
+   }
+
+   out_count = count;
+   return true;
+}
@@ -0,0 +1,112 @@
+/*************************************************************
+* File: snapshot.h
+* Author: Matthew Burr
+*
+* Description: Contains the SnapshotWriter and SnapshotReader,
+*  which lay state out in, and take it back from, a flat
+*  binary snapshot.
+*
+*  A game snapshot (see Game::saveSnapshot) is, in order:
+*     header   magic, version and total size in bytes
+*     game     bounds, score, lives, rocks per wave, ship step
+*     random   the game's and the drawing generator's state
+*     ship     point, velocity, alive, rotation, thrust and
+*              invulnerability
+*     rocks    a count, then each array whole: x, y, dx, dy,
+*              radius, rotation, spin, life, alive, type
+*     bullets  a count, then each array whole, oldest first:
+*              x, y, dx, dy, radius, life, alive
+*  Numbers are stored as the machine holds them, so a snapshot
+*  is only good on the kind of machine that saved it.
+*************************************************************/
+
+#ifndef snapshot_h
+#define snapshot_h
+
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+#define SNAPSHOT_MAGIC 0x53545341u   // "ASTS"
+#define SNAPSHOT_VERSION 2
+
+/*****************************************
+* SNAPSHOT WRITER
+* Appends values and whole arrays to the
+* end of a buffer. Reusing the buffer for
+* the next snapshot reuses its memory.
+*****************************************/
+class SnapshotWriter
+{
+public:
+   SnapshotWriter(std::vector<unsigned char> &out_buffer)
+      : m_buffer(out_buffer) {}
+
+   void write(const void * in_data, size_t in_size)
+   {
+      size_t offset = m_buffer.size();
+      m_buffer.resize(offset + in_size);
+      if (in_size > 0)
+         memcpy(&m_buffer[offset], in_data, in_size);
+   }
+
+   template <class T>
+   void write(const T &in_value) { write(&in_value, sizeof(T)); }
+
+   // The first in_count entries of an array
+   template <class T>
+   void write(const std::vector<T> &in_values, int in_count)
+   {
+      if (in_count > 0)
+         write(&in_values[0], in_count * sizeof(T));
+   }
+
+   size_t getSize() const { return m_buffer.size(); }
+
+private:
+   std::vector<unsigned char> &m_buffer;
+};
+
+/*****************************************
+* SNAPSHOT READER
+* Takes values and arrays back off the
+* front of a snapshot. Reading past the
+* end fails, and once anything has failed
+* the reader stays failed, so a restore
+* can read everything and check once.
+*****************************************/
+class SnapshotReader
+{
+public:
+   SnapshotReader(const unsigned char * in_data, size_t in_size)
+      : m_data(in_data), m_size(in_size), m_offset(0), m_isOk(true) {}
+
+   bool read(void * out_data, size_t in_size);
+
+   template <class T>
+   bool read(T &out_value) { return read(&out_value, sizeof(T)); }
+
+   // in_count entries into the front of an array, which must be at
+   // least that long
+   template <class T>
+   bool read(std::vector<T> &out_values, int in_count)
+   {
+      return in_count <= 0 || read(&out_values[0], in_count * sizeof(T));
+   }
+
+   // A count of entries, each in_entrySize bytes, that are still to
+   // come; fails if the snapshot is too short to hold them
+   bool readCount(int &out_count, size_t in_entrySize);
+
+   void fail() { m_isOk = false; }
+   bool isOk() const { return m_isOk; }
+   size_t getRemaining() const { return m_size - m_offset; }
+
+private:
+   const unsigned char * m_data;
+   size_t m_size;
+   size_t m_offset;
+   bool m_isOk;
+};
+
+#endif /* snapshot_h */
@@ -0,0 +1,146 @@
+/*************************************************************
+* File: spatialGrid.cpp
+* Author: Matthew Burr
+*
+* Description: Contains the implementations of the
+*  method bodies for the SpatialGrid class.
+*************************************************************/
+
+#include "spatialGrid.h"
+#include "point.h"
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+#define EMPTY_CELL -1
+// Extra room on every query so float rounding in the distance
+// calculation can never put a hit just outside the searched cells
+#define REACH_SLACK 1.0f
+using namespace std;
+
+/**********************************************************************
+* Method: SpatialGrid
+* Description: Creates a new SpatialGrid with a single cell; call
+*  setBounds before using it
+**********************************************************************/
+SpatialGrid::SpatialGrid()
+   : m_left(0), m_bottom(0), m_cellSize(1), m_inverseCellSize(1),
+   m_columns(1), m_rows(1),
+   m_maxReach(0), m_cellHead(1, EMPTY_CELL)
+{
+}
+
+/**********************************************************************
+* Method: setBounds
+* Description: Sizes the grid to cover the playfield with square cells
+*  of a given size
+**********************************************************************/
+void SpatialGrid::setBounds(const Point &in_topLeft,
+   const Point &in_bottomRight, float in_cellSize)
+{
+   assert(in_cellSize > 0);
+
+   m_left = in_topLeft.getX();
+   m_bottom = in_bottomRight.getY();
+   m_cellSize = in_cellSize;
+   m_inverseCellSize = 1.0f / in_cellSize;
+   m_columns = (int)ceil((in_bottomRight.getX() - m_left) / m_cellSize) + 1;
+   m_rows = (int)ceil((in_topLeft.getY() - m_bottom) / m_cellSize) + 1;
+   m_cellHead.assign(m_columns * m_rows, EMPTY_CELL);
+   clear();
+}
+
+/**********************************************************************
+* Method: clear
+* Description: Empties every cell
+**********************************************************************/
+void SpatialGrid::clear()
+{
+   m_cellHead.assign(m_cellHead.size(), EMPTY_CELL);
+   m_maxReach = 0;
+}
+
+/**********************************************************************
+* Method: insert
+* Description: Puts an entry in the cell its point falls in. The reach
+*  is how far from that point the entry can touch anything this frame
+*  (its radius plus how far it moved).
+**********************************************************************/
+void SpatialGrid::insert(int index, float x, float y, float reach)
+{
+   assert(index >= 0);
+
+   // Grow geometrically; the grid is rebuilt every frame, so growing
+   // one entry at a time would cost a copy per insert
+   if (index >= (int)m_next.size())
+      m_next.resize(2 * index + 1, EMPTY_CELL);
+
+   int cell = getRow(y) * m_columns + getColumn(x);
+   m_next[index] = m_cellHead[cell];
+   m_cellHead[cell] = index;
+
+   if (reach > m_maxReach)
+      m_maxReach = reach;
+}
+
+/**********************************************************************
+* Method: query
+* Description: Appends every entry that could be within reach of a
+*  point to the list of candidates. Entries come out grouped by cell,
+*  not in index order.
+**********************************************************************/
+void SpatialGrid::query(const Point &point, float reach,
+   vector<int> &candidates) const
+{
+   float extent = reach + m_maxReach + REACH_SLACK;
+
+   int firstColumn = getColumn(point.getX() - extent);
+   int lastColumn = getColumn(point.getX() + extent);
+   int firstRow = getRow(point.getY() - extent);
+   int lastRow = getRow(point.getY() + extent);
+
+   for (int row = firstRow; row <= lastRow; row++)
+   {
+      for (int column = firstColumn; column <= lastColumn; column++)
+      {
+         for (int index = m_cellHead[row * m_columns + column];
+            index != EMPTY_CELL; index = m_next[index])
+            candidates.push_back(index);
+      }
+   }
+}
+
+/**********************************************************************
+* Method: getColumn
+* Description: Gets the column an x coordinate falls in, clamped to
+*  the grid
+**********************************************************************/
+int SpatialGrid::getColumn(float x) const
+{
+   // Clamping before the cast lets a plain truncation stand in for floor
+   float offset = (x - m_left) * m_inverseCellSize;
+   if (!(offset > 0))
+      return 0;
+
+   int column = (int)offset;
+   if (column >= m_columns)
+      return m_columns - 1;
+   return column;
+}
+
+/**********************************************************************
+* Method: getRow
+* Description: Gets the row a y coordinate falls in, clamped to the
+*  grid
+**********************************************************************/
+int SpatialGrid::getRow(float y) const
+{
+   float offset = (y - m_bottom) * m_inverseCellSize;
+   if (!(offset > 0))
+      return 0;
+
+   int row = (int)offset;
+   if (row >= m_rows)
+      return m_rows - 1;
+   return row;
+}
@@ -0,0 +1,51 @@
+/*************************************************************
+* File: spatialGrid.h
+* Author: Matthew Burr
+*
+* Description: Contains the declaration of the SpatialGrid, a
+*  uniform grid over the playfield used to find which rocks
+*  are near enough to an object to be worth a collision test.
+*************************************************************/
+
+#ifndef spatialGrid_h
+#define spatialGrid_h
+
+#include "point.h"
+#include <vector>
+
+/*****************************************
+* SPATIAL GRID
+* Buckets entries (by index) into square
+* cells covering the playfield. Each cell
+* is a linked list threaded through
+* arrays, so inserting is O(1) and
+* rebuilding is one pass.
+*****************************************/
+class SpatialGrid
+{
+public:
+   SpatialGrid();
+
+   void setBounds(const Point &in_topLeft, const Point &in_bottomRight,
+      float in_cellSize);
+   void clear();
+   void insert(int index, float x, float y, float reach);
+   void query(const Point &point, float reach,
+      std::vector<int> &candidates) const;
+
+private:
+   float m_left;
+   float m_bottom;
+   float m_cellSize;
+   float m_inverseCellSize;
+   int m_columns;
+   int m_rows;
+   float m_maxReach;
+   std::vector<int> m_cellHead;
+   std::vector<int> m_next;
+
+   int getColumn(float x) const;
+   int getRow(float y) const;
+};
+
+#endif /* spatialGrid_h */
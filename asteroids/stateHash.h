@@ -0,0 +1,107 @@
+/*************************************************************
+* File: stateHash.h
+* Author: Matthew Burr
+*
+* Description: Contains the hashes that sum up the state of
+*  a game, for telling whether two runs are still playing
+*  the same game.
+*
+*  A store of entries keeps two sums. The body hash adds up
+*  what never changes over an entry's life (velocity, radius,
+*  spin and kind) and is only touched as entries come and go.
+*  The motion hash adds up what changes every tick (position,
+*  rotation and life) over the live entries; the advance
+*  kernels work it out as they go, while the values are in
+*  hand. Sums don't care about order, so every kernel and
+*  every split between threads gives the same result.
+*************************************************************/
+
+#ifndef stateHash_h
+#define stateHash_h
+
+#include <cstring>
+
+// Multipliers from the "lowbias32" integer hash
+#define HASH_MULTIPLIER_1 0x7feb352du
+#define HASH_MULTIPLIER_2 0x846ca68bu
+
+/*****************************************
+* FLOAT BITS
+* A float's bits, so equal hashes mean
+* bit-for-bit equal numbers
+*****************************************/
+inline unsigned getFloatBits(float value)
+{
+   unsigned bits;
+   memcpy(&bits, &value, sizeof(bits));
+   return bits;
+}
+
+/*****************************************
+* ROTATE BITS
+*****************************************/
+inline unsigned rotateBits(unsigned value, int count)
+{
+   return (value << count) | (value >> (32 - count));
+}
+
+/*****************************************
+* HASH MIX
+* Spreads every bit of a word over all the
+* bits of the result
+*****************************************/
+inline unsigned hashMix(unsigned hash)
+{
+   hash ^= hash >> 16;
+   hash *= HASH_MULTIPLIER_1;
+   hash ^= hash >> 15;
+   hash *= HASH_MULTIPLIER_2;
+   hash ^= hash >> 16;
+   return hash;
+}
+
+/*****************************************
+* HASH MOTION
+* What changes about an entry each tick.
+* The vector kernels do exactly this, four
+* or eight lanes at a time, for every
+* entry every tick, so it is kept to one
+* multiply; that's enough for a sum of
+* them to change whenever any one does.
+*****************************************/
+inline unsigned hashMotion(float x, float y, int rotation, int life)
+{
+   unsigned hash = getFloatBits(x) ^ rotateBits(getFloatBits(y), 16) ^
+      (unsigned)rotation ^ ((unsigned)life << 16);
+   hash *= HASH_MULTIPLIER_1;
+   return hash ^ (hash >> 16);
+}
+
+/*****************************************
+* HASH BODY
+* What an entry keeps all its life
+*****************************************/
+inline unsigned hashBody(float dx, float dy, float radius, int spin,
+   int type)
+{
+   unsigned hash = hashMix(getFloatBits(dx) ^
+      rotateBits(getFloatBits(dy), 16));
+   hash = hashMix(hash ^ getFloatBits(radius));
+   return hashMix(hash ^ (unsigned)spin ^ ((unsigned)type << 16));
+}
+
+/*****************************************
+* HASH COMBINE
+* Folds one 64-bit value into another,
+* for putting the parts of a game together
+*****************************************/
+inline unsigned long long hashCombine(unsigned long long hash,
+   unsigned long long value)
+{
+   hash ^= value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+   hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+   hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebULL;
+   return hash ^ (hash >> 31);
+}
+
+#endif /* stateHash_h */
@@ -0,0 +1,265 @@
+/*************************************************************
+* File: sweepAndPrune.cpp
+* Author: Matthew Burr
+*
+* Description: Contains the implementations of the
+*  method bodies for the SweepAndPrune class.
+*************************************************************/
+
+#include "sweepAndPrune.h"
+#include "entityStore.h"
+#include "collision.h"
+#include "point.h"
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+// Extra room on every query so float rounding in the distance
+// calculation can never put a hit just outside the searched range
+#define REACH_SLACK 1.0f
+using namespace std;
+
+/**********************************************************************
+* Function: isBefore
+* Description: Orders entries along an axis
+**********************************************************************/
+static inline bool isBefore(const SweepEntry &lhs, const SweepEntry &rhs)
+{
+   return lhs.key < rhs.key;
+}
+
+/**********************************************************************
+* Method: SweepAndPrune
+* Description: Creates a new, empty SweepAndPrune; call setBounds
+*  before using it
+**********************************************************************/
+SweepAndPrune::SweepAndPrune()
+   : m_halfWidth(0), m_halfHeight(0), m_maxReach(0), m_isBuilt(false)
+{
+}
+
+/**********************************************************************
+* Method: setBounds
+* Description: Tells the lists how big the screen is, so they can tell
+*  a rock that wrapped from one that merely moved
+**********************************************************************/
+void SweepAndPrune::setBounds(const Point &in_topLeft,
+   const Point &in_bottomRight)
+{
+   m_halfWidth = (in_bottomRight.getX() - in_topLeft.getX()) / 2;
+   m_halfHeight = (in_topLeft.getY() - in_bottomRight.getY()) / 2;
+   clear();
+}
+
+/**********************************************************************
+* Method: clear
+* Description: Forgets every rock; the next update rebuilds the lists
+*  from scratch
+**********************************************************************/
+void SweepAndPrune::clear()
+{
+   m_xAxis.clear();
+   m_yAxis.clear();
+   m_added.clear();
+   m_maxReach = 0;
+   m_isBuilt = false;
+}
+
+/**********************************************************************
+* Method: update
+* Description: Brings both lists up to date with where the rocks are
+*  now. Call it once a frame, after the rocks have moved and before
+*  any queries.
+**********************************************************************/
+void SweepAndPrune::update(const EntityStore &rocks)
+{
+   if (!m_isBuilt)
+   {
+      build(rocks);
+      return;
+   }
+
+   repair(m_xAxis, rocks, true /*isXAxis*/, m_halfWidth);
+   repair(m_yAxis, rocks, false /*isXAxis*/, m_halfHeight);
+   m_added.clear();
+
+   m_maxReach = 0;
+   for (int i = 0; i < rocks.size(); i++)
+   {
+      float reach = getSweptReach(rocks.getDx(i), rocks.getDy(i),
+         rocks.getRadius(i));
+      if (reach > m_maxReach)
+         m_maxReach = reach;
+   }
+}
+
+/**********************************************************************
+* Method: build
+* Description: Sorts every rock into both lists from scratch
+**********************************************************************/
+void SweepAndPrune::build(const EntityStore &rocks)
+{
+   m_xAxis.resize(rocks.size());
+   m_yAxis.resize(rocks.size());
+   m_added.clear();
+   m_maxReach = 0;
+
+   for (int i = 0; i < rocks.size(); i++)
+   {
+      SweepEntry entry = { rocks.getX(i), rocks.getY(i), i,
+         rocks.getHandle(i) };
+      m_xAxis[i] = entry;
+      swap(entry.key, entry.cross);
+      m_yAxis[i] = entry;
+
+      float reach = getSweptReach(rocks.getDx(i), rocks.getDy(i),
+         rocks.getRadius(i));
+      if (reach > m_maxReach)
+         m_maxReach = reach;
+   }
+
+   sort(m_xAxis.begin(), m_xAxis.end(), isBefore);
+   sort(m_yAxis.begin(), m_yAxis.end(), isBefore);
+   m_isBuilt = true;
+}
+
+/**********************************************************************
+* Method: repair
+* Description: Refreshes one list's keys and puts it back in order.
+*  Removed rocks are dropped; rocks that jumped more than half the
+*  screen (they wrapped) and rocks added since the last update are
+*  sorted separately and merged in, so an insertion sort only ever
+*  has to move entries a short way.
+**********************************************************************/
+void SweepAndPrune::repair(vector<SweepEntry> &axis,
+   const EntityStore &rocks, bool isXAxis, float halfSpan)
+{
+   m_moved.clear();
+
+   int kept = 0;
+   for (size_t i = 0; i < axis.size(); i++)
+   {
+      SweepEntry entry = axis[i];
+      entry.index = rocks.getIndex(entry.handle);
+      if (entry.index < 0)
+         continue;
+
+      float key = isXAxis ? rocks.getX(entry.index) : rocks.getY(entry.index);
+      float jump = key - entry.key;
+      entry.key = key;
+      entry.cross = isXAxis ? rocks.getY(entry.index) : rocks.getX(entry.index);
+
+      if (jump > halfSpan || jump < -halfSpan)
+         m_moved.push_back(entry);
+      else
+         axis[kept++] = entry;
+   }
+   axis.resize(kept);
+
+   for (size_t i = 0; i < m_added.size(); i++)
+   {
+      SweepEntry entry = m_added[i];
+      entry.index = rocks.getIndex(entry.handle);
+      if (entry.index < 0)
+         continue;
+
+      entry.key = isXAxis ? rocks.getX(entry.index) : rocks.getY(entry.index);
+      entry.cross = isXAxis ? rocks.getY(entry.index) : rocks.getX(entry.index);
+      m_moved.push_back(entry);
+   }
+
+   // Insertion sort: nearly everything is already in place
+   for (int i = 1; i < kept; i++)
+   {
+      SweepEntry entry = axis[i];
+      int j = i;
+      while (j > 0 && entry.key < axis[j - 1].key)
+      {
+         axis[j] = axis[j - 1];
+         j--;
+      }
+      axis[j] = entry;
+   }
+
+   if (m_moved.empty())
+      return;
+
+   sort(m_moved.begin(), m_moved.end(), isBefore);
+   m_merged.resize(axis.size() + m_moved.size());
+   merge(axis.begin(), axis.end(), m_moved.begin(), m_moved.end(),
+      m_merged.begin(), isBefore);
+   axis.swap(m_merged);
+}
+
+/**********************************************************************
+* Method: add
+* Description: Notes a rock added since the last update. Until then
+*  every query returns it, so rocks made during the collision pass
+*  can be hit by the objects checked after them.
+**********************************************************************/
+void SweepAndPrune::add(const EntityStore &rocks, int index)
+{
+   if (!m_isBuilt)
+      return;
+
+   SweepEntry entry = { 0, 0, index, rocks.getHandle(index) };
+   m_added.push_back(entry);
+}
+
+/**********************************************************************
+* Method: getRange
+* Description: Finds the entries [first, last) of a list whose keys
+*  fall between low and high
+**********************************************************************/
+void SweepAndPrune::getRange(const vector<SweepEntry> &axis, float low,
+   float high, int &first, int &last)
+{
+   SweepEntry bound = { low, 0, 0, { 0, 0 } };
+   first = (int)(lower_bound(axis.begin(), axis.end(), bound, isBefore) -
+      axis.begin());
+
+   bound.key = high;
+   last = (int)(upper_bound(axis.begin() + first, axis.end(), bound,
+      isBefore) - axis.begin());
+}
+
+/**********************************************************************
+* Method: query
+* Description: Appends every rock that could be within reach of a
+*  point to the list of candidates, in no particular order
+**********************************************************************/
+void SweepAndPrune::query(const Point &point, float reach,
+   vector<int> &candidates) const
+{
+   assert(m_isBuilt);
+
+   float extent = reach + m_maxReach + REACH_SLACK;
+
+   int xFirst;
+   int xLast;
+   getRange(m_xAxis, point.getX() - extent, point.getX() + extent,
+      xFirst, xLast);
+
+   int yFirst;
+   int yLast;
+   getRange(m_yAxis, point.getY() - extent, point.getY() + extent,
+      yFirst, yLast);
+
+   // Either axis finds every rock in reach; read the one with less
+   // to read and check the other coordinate as we go
+   bool isXAxis = (xLast - xFirst <= yLast - yFirst);
+   const vector<SweepEntry> &axis = isXAxis ? m_xAxis : m_yAxis;
+   int first = isXAxis ? xFirst : yFirst;
+   int last = isXAxis ? xLast : yLast;
+   float crossLow = (isXAxis ? point.getY() : point.getX()) - extent;
+   float crossHigh = (isXAxis ? point.getY() : point.getX()) + extent;
+
+   for (int i = first; i < last; i++)
+   {
+      if (axis[i].cross >= crossLow && axis[i].cross <= crossHigh)
+         candidates.push_back(axis[i].index);
+   }
+
+   for (size_t i = 0; i < m_added.size(); i++)
+      candidates.push_back(m_added[i].index);
+}
@@ -0,0 +1,82 @@
+/*************************************************************
+* File: sweepAndPrune.h
+* Author: Matthew Burr
+*
+* Description: Contains the declaration of SweepAndPrune, a
+*  broad phase that keeps the rocks sorted along each axis
+*  from one frame to the next.
+*************************************************************/
+
+#ifndef sweepAndPrune_h
+#define sweepAndPrune_h
+
+#include "entityStore.h"
+#include "point.h"
+#include <vector>
+
+/*****************************************
+* SWEEP ENTRY
+* One rock's place along an axis, and
+* across it so a query can skip rocks
+* that are too far off to the side. The
+* handle follows the rock through
+* compaction; the index is where it was
+* at the last update.
+*****************************************/
+struct SweepEntry
+{
+   float key;
+   float cross;
+   int index;
+   EntityHandle handle;
+};
+
+/*****************************************
+* SWEEP AND PRUNE
+* Keeps every rock in a list sorted by x
+* and another sorted by y. Rocks move
+* little between frames, so each update
+* only has to nudge entries back into
+* order with an insertion sort. Rocks
+* that wrap across the edge of the screen
+* jump from one end of a list to the
+* other; they, and rocks added since the
+* last update, are taken out, sorted on
+* their own and merged back in.
+*
+* A query looks up the range of each list
+* an object could reach and reads out the
+* shorter of the two, keeping the rocks
+* that are also in reach across it.
+*****************************************/
+class SweepAndPrune
+{
+public:
+   SweepAndPrune();
+
+   void setBounds(const Point &in_topLeft, const Point &in_bottomRight);
+   void clear();
+   void update(const EntityStore &rocks);
+   void add(const EntityStore &rocks, int index);
+   void query(const Point &point, float reach,
+      std::vector<int> &candidates) const;
+
+private:
+   float m_halfWidth;
+   float m_halfHeight;
+   float m_maxReach;
+   bool m_isBuilt;
+   std::vector<SweepEntry> m_xAxis;
+   std::vector<SweepEntry> m_yAxis;
+   std::vector<SweepEntry> m_added;
+   std::vector<SweepEntry> m_moved;
+   std::vector<SweepEntry> m_merged;
+
+   void build(const EntityStore &rocks);
+   void repair(std::vector<SweepEntry> &axis, const EntityStore &rocks,
+      bool isXAxis, float halfSpan);
+   static void getRange(const std::vector<SweepEntry> &axis, float low,
+      float high, int &first, int &last);
+};
+
+#endif /* sweepAndPrune_h */
@@ -0,0 +1,225 @@
+/*************************************************************
+* File: taskPool.cpp
+* Author: Matthew Burr
+*
+* Description: Contains the implementations of the
+*  method bodies for the TaskPool class.
+*************************************************************/
+
+#include "taskPool.h"
+#include <algorithm>
+#include <cassert>
+#include <thread>
+using namespace std;
+
+/**********************************************************************
+* Method: TaskPool
+* Description: Creates a pool with a given number of threads, counting
+*  the one that calls it
+**********************************************************************/
+TaskPool::TaskPool(int in_threadCount)
+   : m_threadCount(1), m_queues(NULL), m_job(0), m_isStopping(false),
+   m_task(NULL), m_context(NULL), m_count(0), m_grain(1), m_remaining(0)
+{
+   startWorkers(in_threadCount);
+}
+
+/**********************************************************************
+* Method: ~TaskPool
+* Description: Stops and joins every worker
+**********************************************************************/
+TaskPool::~TaskPool()
+{
+   stopWorkers();
+}
+
+/**********************************************************************
+* Method: getCoreCount
+* Description: How many threads the machine can run at once
+**********************************************************************/
+int TaskPool::getCoreCount()
+{
+   int cores = (int)thread::hardware_concurrency();
+   return cores > 0 ? cores : 1;
+}
+
+/**********************************************************************
+* Method: setThreadCount
+* Description: Replaces the workers with a new set.
+*  TASK_POOL_ALL_CORES gives one thread per core.
+**********************************************************************/
+void TaskPool::setThreadCount(int in_threadCount)
+{
+   stopWorkers();
+   startWorkers(in_threadCount);
+}
+
+/**********************************************************************
+* Method: startWorkers
+* Description: Starts every thread but the caller's
+**********************************************************************/
+void TaskPool::startWorkers(int in_threadCount)
+{
+   if (in_threadCount <= TASK_POOL_ALL_CORES)
+      in_threadCount = getCoreCount();
+
+   m_threadCount = in_threadCount;
+   m_isStopping = false;
+   m_queues = new ChunkQueue[in_threadCount];
+   for (int i = 0; i < in_threadCount; i++)
+   {
+      m_queues[i].next = 0;
+      m_queues[i].end = 0;
+   }
+
+   for (int i = 1; i < in_threadCount; i++)
+      m_workers.push_back(thread(&TaskPool::workerLoop, this, i));
+}
+
+/**********************************************************************
+* Method: stopWorkers
+* Description: Tells the workers to finish and waits for them
+**********************************************************************/
+void TaskPool::stopWorkers()
+{
+   {
+      lock_guard<mutex> lock(m_lock);
+      m_isStopping = true;
+   }
+   m_wake.notify_all();
+
+   for (size_t i = 0; i < m_workers.size(); i++)
+      m_workers[i].join();
+   m_workers.clear();
+
+   delete [] m_queues;
+   m_queues = NULL;
+}
+
+/**********************************************************************
+* Method: parallelFor
+* Description: Runs a task over [0, count) in chunks of grain entries
+*  and returns when all of it is done. Short ranges, and pools with
+*  no workers, run in one piece on the calling thread.
+**********************************************************************/
+void TaskPool::parallelFor(int count, int grain, RangeTask task,
+   void * context)
+{
+   assert(grain > 0);
+
+   int threads = getThreadCount();
+   if (threads == 1 || count <= grain)
+   {
+      if (count > 0)
+         task(context, 0 /*thread*/, 0, count);
+      return;
+   }
+
+   int chunks = (count + grain - 1) / grain;
+
+   m_task = task;
+   m_context = context;
+   m_count = count;
+   m_grain = grain;
+   m_remaining = chunks;
+
+   // Each thread starts with its own contiguous share. Workers still
+   // looking for scraps of the last loop can't see the new one until
+   // its queue is filled, and the queue's lock publishes the fields
+   // above along with it.
+   for (int i = 0; i < threads; i++)
+   {
+      lock_guard<mutex> lock(m_queues[i].lock);
+      m_queues[i].next = (int)((long long)chunks * i / threads);
+      m_queues[i].end = (int)((long long)chunks * (i + 1) / threads);
+   }
+
+   {
+      lock_guard<mutex> lock(m_lock);
+      m_job++;
+   }
+   m_wake.notify_all();
+
+   runChunks(0);
+
+   unique_lock<mutex> lock(m_lock);
+   m_done.wait(lock, [this] { return m_remaining == 0; });
+}
+
+/**********************************************************************
+* Method: workerLoop
+* Description: What a worker thread does: sleeps until there is a
+*  loop to help with, helps, and goes back to sleep
+**********************************************************************/
+void TaskPool::workerLoop(int thread)
+{
+   unsigned seen = 0;
+
+   for (;;)
+   {
+      {
+         unique_lock<mutex> lock(m_lock);
+         m_wake.wait(lock, [&] { return m_isStopping || m_job != seen; });
+         if (m_isStopping)
+            return;
+         seen = m_job;
+      }
+
+      runChunks(thread);
+   }
+}
+
+/**********************************************************************
+* Method: runChunks
+* Description: Runs chunks until there are none left anywhere
+**********************************************************************/
+void TaskPool::runChunks(int thread)
+{
+   int chunk;
+   while (takeChunk(thread, chunk))
+   {
+      int begin = chunk * m_grain;
+      m_task(m_context, thread, begin, min(begin + m_grain, m_count));
+
+      if (--m_remaining == 0)
+      {
+         // Taking the lock keeps the caller from missing the signal
+         // between checking the count and going to sleep
+         lock_guard<mutex> lock(m_lock);
+         m_done.notify_one();
+      }
+   }
+}
+
+/**********************************************************************
+* Method: takeChunk
+* Description: Takes the next chunk of a thread's own share or, when
+*  that is used up, the last chunk of someone else's. Returns false
+*  when every share is empty.
+**********************************************************************/
+bool TaskPool::takeChunk(int thread, int &chunk)
+{
+   {
+      ChunkQueue &own = m_queues[thread];
+      lock_guard<mutex> lock(own.lock);
+      if (own.next < own.end)
+      {
+         chunk = own.next++;
+         return true;
+      }
+   }
+
+   int threads = getThreadCount();
+   for (int i = 1; i < threads; i++)
+   {
+      ChunkQueue &victim = m_queues[(thread + i) % threads];
+      lock_guard<mutex> lock(victim.lock);
+      if (victim.next < victim.end)
+      {
+         chunk = --victim.end;
+         return true;
+      }
+   }
+
+   return false;
+}
@@ -0,0 +1,94 @@
+/*************************************************************
+* File: taskPool.h
+* Author: Matthew Burr
+*
+* Description: Contains the declaration of the TaskPool, a
+*  set of worker threads that split a loop over a range of
+*  entries between them.
+*************************************************************/
+
+#ifndef taskPool_h
+#define taskPool_h
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Asks setThreadCount for one thread per core
+#define TASK_POOL_ALL_CORES 0
+
+/**********************************************************
+ * RANGE TASK
+ * Does the work for entries [begin, end). A task must only
+ * touch its own entries, so any split of the range gives
+ * the same result. The thread number, from 0 up to the
+ * thread count, lets a task keep scratch space per thread.
+ **********************************************************/
+typedef void (*RangeTask)(void * context, int thread, int begin, int end);
+
+/*****************************************
+* TASK POOL
+* Cuts a range into chunks and deals each
+* thread an equal, contiguous share of
+* them. A thread works through its own
+* share from the front; once it runs out
+* it steals from the back of another's, so
+* a thread held up by the OS doesn't hold
+* up the frame. The calling thread works
+* too, so a pool of one thread runs
+* everything in place.
+*
+* A pool runs one loop at a time and only
+* from the thread that owns it.
+*****************************************/
+class TaskPool
+{
+public:
+   TaskPool(int in_threadCount = 1);
+   ~TaskPool();
+
+   void setThreadCount(int in_threadCount);
+   int getThreadCount() const { return m_threadCount; }
+   void parallelFor(int count, int grain, RangeTask task, void * context);
+
+   static int getCoreCount();
+
+private:
+   // The chunks [next, end) a thread has left
+   struct ChunkQueue
+   {
+      std::mutex lock;
+      int next;
+      int end;
+   };
+
+   int m_threadCount;
+   std::vector<std::thread> m_workers;
+   ChunkQueue * m_queues;
+   std::mutex m_lock;
+   std::condition_variable m_wake;
+   std::condition_variable m_done;
+   unsigned m_job;
+   bool m_isStopping;
+
+   // The loop being run
+   RangeTask m_task;
+   void * m_context;
+   int m_count;
+   int m_grain;
+   std::atomic<int> m_remaining;
+
+   void startWorkers(int in_threadCount);
+   void stopWorkers();
+   void workerLoop(int thread);
+   void runChunks(int thread);
+   bool takeChunk(int thread, int &chunk);
+
+   // A pool owns its threads, so it can't be copied
+   TaskPool(const TaskPool &);
+   TaskPool & operator=(const TaskPool &);
+};
+
+#endif /* taskPool_h */
@@ -13,6 +13,8 @@
 #include <string>     // need you ask?
 #include <sstream>    // convert an integer into text
 #include <cassert>    // I feel the need... the need for asserts
+#include <vector>     // the batch of lines and points
+#include <map>        // outlines of circles by size
 #include <time.h>     // for clock
 
 
@@ -36,34 +38,160 @@
 
 #include "point.h"
 #include "uiDraw.h"
+#include "random.h"
+#include "rotatedShape.h"
+#include "shapeOutlines.h"
 
 using namespace std;
 
 #define deg2rad(value) ((M_PI / 180) * (value))
 
 /*********************************************
- * NUMBER OUTLINES
- * We are drawing the text for score and things
- * like that by hand to make it look "old school."
- * These are how we render each individual charactger.
- * Note how -1 indicates "done".  These are paired
- * coordinates where the even are the x and the odd
- * are the y and every 2 pairs represents a point
+ * BATCH
+ * Rather than hand each shape to OpenGL as it is
+ * drawn, we save up the frame's lines and dots here
+ * and send each run of them with one glDrawArrays.
+ * Strips and loops are broken into separate segments,
+ * two vertices each, so shapes can share an array;
+ * the segments light the same pixels the strip would.
+ * Switching between lines and dots sends what came
+ * before, so things still land in the order drawn.
  ********************************************/
-const char NUMBER_OUTLINES[10][20] =
+struct BatchVertex
 {
-  {0, 0,  7, 0,   7, 0,  7,10,   7,10,  0,10,   0,10,  0, 0,  -1,-1, -1,-1},//0
-  {7, 0,  7,10,  -1,-1, -1,-1,  -1,-1, -1,-1,  -1,-1, -1,-1,  -1,-1, -1,-1},//1
-  {0, 0,  7, 0,   7, 0,  7, 5,   7, 5,  0, 5,   0, 5,  0,10,   0,10,  7,10},//2
-  {0, 0,  7, 0,   7, 0,  7,10,   7,10,  0,10,   4, 5,  7, 5,  -1,-1, -1,-1},//3
-  {0, 0,  0, 5,   0, 5,  7, 5,   7, 0,  7,10,  -1,-1, -1,-1,  -1,-1, -1,-1},//4
-  {7, 0,  0, 0,   0, 0,  0, 5,   0, 5,  7, 5,   7, 5,  7,10,   7,10,  0,10},//5
-  {7, 0,  0, 0,   0, 0,  0,10,   0,10,  7,10,   7,10,  7, 5,   7, 5,  0, 5},//6
-  {0, 0,  7, 0,   7, 0,  7,10,  -1,-1, -1,-1,  -1,-1, -1,-1,  -1,-1, -1,-1},//7
-  {0, 0,  7, 0,   0, 5,  7, 5,   0,10,  7,10,   0, 0,  0,10,   7, 0,  7,10},//8
-  {0, 0,  7, 0,   7, 0,  7,10,   0, 0,  0, 5,   0, 5,  7, 5,  -1,-1, -1,-1} //9
+   GLfloat x;
+   GLfloat y;
+   GLfloat red;
+   GLfloat green;
+   GLfloat blue;
 };
 
+static vector<BatchVertex> batch;
+static GLenum batchMode = GL_LINES;
+static BatchVertex batchPen = { 0.0, 0.0, 1.0, 1.0, 1.0 };
+
+// the strip being broken into segments
+static BatchVertex stripFirst;
+static BatchVertex stripLast;
+static int stripCount = 0;
+
+/************************************************************************
+ * FLUSH DRAWING
+ * Send everything in the batch to OpenGL
+ *************************************************************************/
+void flushDrawing()
+{
+   if (batch.empty())
+      return;
+
+   glEnableClientState(GL_VERTEX_ARRAY);
+   glEnableClientState(GL_COLOR_ARRAY);
+   glVertexPointer(2, GL_FLOAT, sizeof(BatchVertex), &batch[0].x);
+   glColorPointer( 3, GL_FLOAT, sizeof(BatchVertex), &batch[0].red);
+   glDrawArrays(batchMode, 0, (GLsizei)batch.size());
+   glDisableClientState(GL_COLOR_ARRAY);
+   glDisableClientState(GL_VERTEX_ARRAY);
+
+   // the color array leaves the current color undefined
+   glColor3f(batchPen.red, batchPen.green, batchPen.blue);
+
+   // keep the memory for the next frame
+   batch.clear();
+}
+
+/************************************************************************
+ * BATCH COLOR
+ * The color of the vertices added after this
+ *************************************************************************/
+static void batchColor(float red, float green, float blue)
+{
+   batchPen.red   = red;
+   batchPen.green = green;
+   batchPen.blue  = blue;
+}
+
+/************************************************************************
+ * BATCH BEGIN
+ * Get ready to add lines (GL_LINES) or dots (GL_POINTS)
+ *************************************************************************/
+static void batchBegin(GLenum mode)
+{
+   if (mode != batchMode)
+   {
+      flushDrawing();
+      batchMode = mode;
+   }
+}
+
+/************************************************************************
+ * BATCH VERTEX
+ * Add a vertex in the current color
+ *************************************************************************/
+static void batchVertex(float x, float y)
+{
+   batchPen.x = x;
+   batchPen.y = y;
+   batch.push_back(batchPen);
+}
+
+/************************************************************************
+ * BATCH STRIP
+ * Start a line strip or loop; its vertices are added with
+ * batchStripVertex() and it is finished with batchStripEnd()
+ *************************************************************************/
+static void batchStrip()
+{
+   batchBegin(GL_LINES);
+   stripCount = 0;
+}
+
+static void batchStripVertex(float x, float y)
+{
+   BatchVertex vertex = batchPen;
+   vertex.x = x;
+   vertex.y = y;
+
+   if (stripCount == 0)
+      stripFirst = vertex;
+   else
+   {
+      batch.push_back(stripLast);
+      batch.push_back(vertex);
+   }
+
+   stripLast = vertex;
+   stripCount++;
+}
+
+static void batchStripEnd(bool isLoop)
+{
+   // a loop joins its last vertex back to its first
+   if (isLoop && stripCount > 1)
+   {
+      batch.push_back(stripLast);
+      batch.push_back(stripFirst);
+   }
+   stripCount = 0;
+}
+
+/************************************************************************
+ * DRAW OUTLINE
+ * Draw a shape from the rotated shape cache: a table lookup and a
+ * translate for each vertex, where rotate() would take a sine and a
+ * cosine
+ *************************************************************************/
+static void drawOutline(const Point & center, const RotatedShape & shape,
+                        int rotation, bool isLoop)
+{
+   const ShapePoint *outline = shape.getOutline(rotation);
+
+   batchStrip();
+   for (int i = 0; i < shape.getCount(); i++)
+      batchStripVertex(center.getX() + outline[i].x,
+                       center.getY() + outline[i].y);
+   batchStripEnd(isLoop);
+}
+
 /************************************************************************
  * DRAW DIGIT
  * Draw a single digit in the old school line drawing style.  The
@@ -125,10 +253,9 @@ void drawNumber(const Point & topLeft, int number)
    // handle the negative
    if (isNegative)
    {
-      glBegin(GL_LINES);
-      glVertex2f(point.getX() + 1, point.getY() - 5);
-      glVertex2f(point.getX() + 5, point.getY() - 5);
-      glEnd();
+      batchBegin(GL_LINES);
+      batchVertex(point.getX() + 1, point.getY() - 5);
+      batchVertex(point.getX() + 5, point.getY() - 5);
       point.addX(11);
    }
    
@@ -152,6 +279,9 @@ void drawText(const Point & topLeft, const char * text)
 {
    void *pFont = GLUT_BITMAP_HELVETICA_12;  // also try _18
 
+   // text isn't batched, so anything drawn before it has to go first
+   flushDrawing();
+
    // prepare to draw the text from the top-left corner
    glRasterPos2f(topLeft.getX(), topLeft.getY());
 
@@ -172,23 +302,8 @@ void drawText(const Point & topLeft, const char * text)
  *************************************************************************/
 void drawPolygon(const Point & center, int radius, int points, int rotation)
 {
-   // begin drawing
-   glBegin(GL_LINE_LOOP);
-
-   //loop around a circle the given number of times drawing a line from
-   //one point to the next
-   for (double i = 0; i < 2 * M_PI; i += (2 * M_PI) / points)
-   {
-      Point temp(false /*check*/);
-      temp.setX(center.getX() + (radius * cos(i)));
-      temp.setY(center.getY() + (radius * sin(i)));
-      rotate(temp, center, rotation);
-      glVertex2f(temp.getX(), temp.getY());
-   }
-
-   // complete drawing
-   glEnd();
-
+   drawOutline(center, RotatedShape::getPolygon(radius, points), rotation,
+               true /*isLoop*/);
 }
 
 
@@ -231,16 +346,15 @@ void drawLine(const Point & begin, const Point & end,
               float red, float green, float blue)
 {
    // Get ready...
-   glBegin(GL_LINES);
-   glColor3f(red, green, blue);
+   batchBegin(GL_LINES);
+   batchColor(red, green, blue);
 
    // Draw the actual line
-   glVertex2f(begin.getX(), begin.getY());
-   glVertex2f(  end.getX(),   end.getY());
+   batchVertex(begin.getX(), begin.getY());
+   batchVertex(  end.getX(),   end.getY());
 
    // Complete drawing
-   glColor3f(1.0 /* red % */, 1.0 /* green % */, 1.0 /* blue % */);
-   glEnd();
+   batchColor(1.0 /* red % */, 1.0 /* green % */, 1.0 /* blue % */);
 }
 
 /***********************************************************************
@@ -249,36 +363,32 @@ void drawLine(const Point & begin, const Point & end,
  ***********************************************************************/
 void drawLander(const Point & point)
 {
-   // ultra simple point
-   struct PT
-   {
-      int x;
-      int y;
-   } points[] = 
-   {
-      {-6, 0}, {-10,0}, {-8, 0}, {-8, 3},  // left foot
-      {-5, 4}, {-5, 7}, {-8, 3}, {-5, 4},  // left leg
-      {-1, 4}, {-3, 2}, { 3, 2}, { 1, 4}, {-1, 4}, // bottom
-      { 5, 4}, { 5, 7}, {-5, 7}, {-3, 7},  // engine square
-      {-6,10}, {-6,13}, {-3,16}, { 3,16},   // left of habitat
-      { 6,13}, { 6,10}, { 3, 7}, { 5, 7},   // right of habitat
-      { 5, 4}, { 8, 3}, { 5, 7}, { 5, 4},  // right leg
-      { 8, 3}, { 8, 0}, {10, 0}, { 6, 0}   // right foot
-   };
-
    // draw it
-   glBegin(GL_LINE_STRIP);
-   for (int i = 0; i < sizeof(points) / sizeof(points[0]); i++)
-        glVertex2f(point.getX() + points[i].x,
-                   point.getY() + points[i].y);
+   batchStrip();
+   for (int i = 0; i < SHAPE_COUNT(LANDER_OUTLINE); i++)
+        batchStripVertex(point.getX() + LANDER_OUTLINE[i].x,
+                         point.getY() + LANDER_OUTLINE[i].y);
 
    // complete drawing
-   glEnd();
-   
-   
+   batchStripEnd(false /*isLoop*/);
 }
 
 
+/***********************************************************************
+ * ADD LANDER FLAME
+ * Add one thruster's flame to the loop: from one side of its nozzle,
+ * through the flame and back to the other side
+ ***********************************************************************/
+static void addLanderFlame(const Point & point, const ShapePoint * nozzle,
+                           const ShapePoint * flame)
+{
+   batchStripVertex(point.getX() + nozzle[0].x, point.getY() + nozzle[0].y);
+   for (int i = 0; i < 3; i++)
+      batchStripVertex(point.getX() + flame[i].x,
+                       point.getY() + flame[i].y);
+   batchStripVertex(point.getX() + nozzle[1].x, point.getY() + nozzle[1].y);
+}
+
 /***********************************************************************
  * DRAW Lander Flame
  * Draw the flames coming out of a moonlander for thrust
@@ -288,106 +398,26 @@ void drawLanderFlames(const Point & point,
                       bool left,
                       bool right)
 {
-   // simple point
-   struct PT
-   {
-      int x;
-      int y;
-   };
-
    int iFlame = random(0, 3);  // so the flame flickers
    
    // draw it
-   glBegin(GL_LINE_LOOP);
-   glColor3f(1.0 /* red % */, 0.0 /* green % */, 0.0 /* blue % */);
+   batchStrip();
+   batchColor(1.0 /* red % */, 0.0 /* green % */, 0.0 /* blue % */);
    
    // bottom thrust
    if (bottom)
-   {
-      PT points[3][3] =
-      {
-         { {-5,  -6}, { 0, -1}, { 3, -10} },
-         { {-3,  -6}, {-1, -2}, { 0, -15} },
-         { { 2, -12}, { 1,  0}, { 6,  -4} }
-      };
-      
-      glVertex2f(point.getX() - 2, point.getY() + 2);
-      for (int i = 0; i < 3; i++)
-         glVertex2f(point.getX() + points[iFlame][i].x,
-                   point.getY() + points[iFlame][i].y);
-      glVertex2f(point.getX() + 2, point.getY() + 2);
-   }
+      addLanderFlame(point, LANDER_NOZZLE_BOTTOM, LANDER_FLAMES_BOTTOM[iFlame]);
 
    // right thrust
    if (right)
-   {
-      PT points[3][3] =
-      {
-         { {10, 14}, { 8, 12}, {12, 12} },
-         { {12, 10}, { 8, 10}, {10,  8} },
-         { {14, 11}, {14, 11}, {14, 11} }
-      };
-      
-      glVertex2f(point.getX() + 6, point.getY() + 12);
-      for (int i = 0; i < 3; i++)
-         glVertex2f(point.getX() + points[iFlame][i].x,
-                    point.getY() + points[iFlame][i].y);
-      glVertex2f(point.getX() + 6, point.getY() + 10);
-   }
+      addLanderFlame(point, LANDER_NOZZLE_RIGHT, LANDER_FLAMES_RIGHT[iFlame]);
 
    // left thrust
    if (left)
-   {
-      PT points[3][3] =
-      {
-         { {-10, 14}, { -8, 12}, {-12, 12} },
-         { {-12, 10}, { -8, 10}, {-10,  8} },
-         { {-14, 11}, {-14, 11}, {-14, 11} }
-      };
-      
-      glVertex2f(point.getX() - 6, point.getY() + 12);
-      for (int i = 0; i < 3; i++)
-         glVertex2f(point.getX() + points[iFlame][i].x,
-                    point.getY() + points[iFlame][i].y);
-      glVertex2f(point.getX() - 6, point.getY() + 10);
-   }
-
-   glColor3f(1.0 /* red % */, 1.0 /* green % */, 1.0 /* blue % */);
-   glEnd();
-}
-
-
-/******************************************************************
- * RANDOM
- * This function generates a random number.  
- *
- *    INPUT:   min, max : The number of values (min <= num <= max)
- *    OUTPUT   <return> : Return the integer
- ****************************************************************/
-int random(int min, int max)
-{
-   assert(min < max);
-   int num = (rand() % (max - min)) + min;
-   assert(min <= num && num <= max);
-
-   return num;
-}
-
-/******************************************************************
- * RANDOM
- * This function generates a random number.  
- *
- *    INPUT:   min, max : The number of values (min <= num <= max)
- *    OUTPUT   <return> : Return the double
- ****************************************************************/
-double random(double min, double max)
-{
-   assert(min <= max);
-   double num = min + ((double)rand() / (double)RAND_MAX * (max - min));
-   
-   assert(min <= num && num <= max);
+      addLanderFlame(point, LANDER_NOZZLE_LEFT, LANDER_FLAMES_LEFT[iFlame]);
 
-   return num;
+   batchStripEnd(true /*isLoop*/);
+   batchColor(1.0 /* red % */, 1.0 /* green % */, 1.0 /* blue % */);
 }
 
 
@@ -430,13 +460,13 @@ void drawRect(const Point & center, int width, int height, int rotation)
    rotate(br, center, rotation);
 
    //Finally draw the rectangle
-   glBegin(GL_LINE_STRIP);
-   glVertex2f(tl.getX(), tl.getY());
-   glVertex2f(tr.getX(), tr.getY());
-   glVertex2f(br.getX(), br.getY());
-   glVertex2f(bl.getX(), bl.getY());
-   glVertex2f(tl.getX(), tl.getY());
-   glEnd();
+   batchStrip();
+   batchStripVertex(tl.getX(), tl.getY());
+   batchStripVertex(tr.getX(), tr.getY());
+   batchStripVertex(br.getX(), br.getY());
+   batchStripVertex(bl.getX(), bl.getY());
+   batchStripVertex(tl.getX(), tl.getY());
+   batchStripEnd(false /*isLoop*/);
 }
 
 /************************************************************************
@@ -448,18 +478,33 @@ void drawRect(const Point & center, int width, int height, int rotation)
 void drawCircle(const Point & center, int radius)
 {
    assert(radius > 1.0);
-   const double increment = 1.0 / (double)radius;
+
+   // each size of circle is worked out the first time it is drawn, as
+   // x, y pairs; they are kept as doubles so adding the center rounds
+   // the way it always did
+   static map<int, vector<double> > circles;
+   vector<double> & outline = circles[radius];
+
+   if (outline.empty())
+   {
+      const double increment = 1.0 / (double)radius;
+      for (double radians = 0; radians < M_PI * 2.0; radians += increment)
+      {
+         outline.push_back(radius * cos(radians));
+         outline.push_back(radius * sin(radians));
+      }
+   }
 
    // begin drawing
-   glBegin(GL_LINE_LOOP);
+   batchStrip();
 
    // go around the circle
-   for (double radians = 0; radians < M_PI * 2.0; radians += increment)
-      glVertex2f(center.getX() + (radius * cos(radians)),
-                 center.getY() + (radius * sin(radians)));
+   for (size_t i = 0; i < outline.size(); i += 2)
+      batchStripVertex(center.getX() + outline[i],
+                       center.getY() + outline[i + 1]);
    
    // complete drawing
-   glEnd();   
+   batchStripEnd(true /*isLoop*/);
 }
 
 /************************************************************************
@@ -470,16 +515,15 @@ void drawCircle(const Point & center, int radius)
 void drawDot(const Point & point)
 {
    // Get ready, get set...
-   glBegin(GL_POINTS);
+   batchBegin(GL_POINTS);
 
    // Go...
-   glVertex2f(point.getX(),     point.getY()    );
-   glVertex2f(point.getX() + 1, point.getY()    );
-   glVertex2f(point.getX() + 1, point.getY() + 1);
-   glVertex2f(point.getX(),     point.getY() + 1);
+   batchVertex(point.getX(),     point.getY()    );
+   batchVertex(point.getX() + 1, point.getY()    );
+   batchVertex(point.getX() + 1, point.getY() + 1);
+   batchVertex(point.getX(),     point.getY() + 1);
 
    // Done!  OK, that was a bit too dramatic
-   glEnd();
 }
 
 /************************************************************************
@@ -493,6 +537,9 @@ void drawToughBird(const Point & center, float radius, int hits)
 {
    assert(radius > 1.0);
    const double increment = M_PI / 6.0;
+
+   // the bird isn't batched, so anything drawn before it has to go first
+   flushDrawing();
    
    // begin drawing
    glBegin(GL_TRIANGLES);   
@@ -545,8 +592,8 @@ void drawSacredBird(const Point & center, float radius)
 
    
    // begin drawing
-   glBegin(GL_LINE_LOOP);
-   glColor3f(1.0 /* red % */, 0.0 /* green % */, 0.0 /* blue % */);
+   batchStrip();
+   batchColor(1.0 /* red % */, 0.0 /* green % */, 0.0 /* blue % */);
 
    
    //loop around a circle the given number of times drawing a line from
@@ -558,12 +605,12 @@ void drawSacredBird(const Point & center, float radius)
       temp.setX(center.getX() + (radius * cos(radian)));
       temp.setY(center.getY() + (radius * sin(radian)));
       rotate(temp, center, rotation);
-      glVertex2f(temp.getX(), temp.getY());
+      batchStripVertex(temp.getX(), temp.getY());
    }
    
    // complete drawing
-   glColor3f(1.0, 1.0, 1.0); // reset to white
-   glEnd();   
+   batchStripEnd(true /*isLoop*/);
+   batchColor(1.0, 1.0, 1.0); // reset to white
 }
 
 /**********************************************************************
@@ -571,27 +618,8 @@ void drawSacredBird(const Point & center, float radius)
  **********************************************************************/
 void drawSmallAsteroid( const Point & center, int rotation)
 {
-   // ultra simple point
-   struct PT
-   {
-      int x;
-      int y;
-   } points[] = 
-   {
-      {-5, 9},  {4, 8},   {8, 4},   
-      {8, -5},  {-2, -8}, {-2, -3}, 
-      {-8, -4}, {-8, 4},  {-5, 10}
-   };
-   
-   glBegin(GL_LINE_STRIP);
-   for (int i = 0; i < sizeof(points)/sizeof(PT); i++)
-   {
-      Point pt(center.getX() + points[i].x, 
-               center.getY() + points[i].y);
-      rotate(pt, center, rotation);
-      glVertex2f(pt.getX(), pt.getY());
-   }
-   glEnd();
+   static const RotatedShape shape(SMALL_ROCK_OUTLINE, SHAPE_COUNT(SMALL_ROCK_OUTLINE));
+   drawOutline(center, shape, rotation, false /*isLoop*/);
 }
 
 /**********************************************************************
@@ -599,28 +627,8 @@ void drawSmallAsteroid( const Point & center, int rotation)
  **********************************************************************/
 void drawMediumAsteroid( const Point & center, int rotation)
 {
-   // ultra simple point
-   struct PT
-   {
-      int x;
-      int y;
-   } points[] = 
-   {
-      {2, 8},    {8, 15},    {12, 8}, 
-      {6, 2},    {12, -6},   {2, -15},
-      {-6, -15}, {-14, -10}, {-15, 0},
-      {-4, 15},  {2, 8}
-   };
-   
-   glBegin(GL_LINE_STRIP);
-   for (int i = 0; i < sizeof(points)/sizeof(PT); i++)
-   {
-      Point pt(center.getX() + points[i].x, 
-               center.getY() + points[i].y);
-      rotate(pt, center, rotation);
-      glVertex2f(pt.getX(), pt.getY());
-   }
-   glEnd();
+   static const RotatedShape shape(MEDIUM_ROCK_OUTLINE, SHAPE_COUNT(MEDIUM_ROCK_OUTLINE));
+   drawOutline(center, shape, rotation, false /*isLoop*/);
 }
 
 /**********************************************************************
@@ -628,28 +636,8 @@ void drawMediumAsteroid( const Point & center, int rotation)
  **********************************************************************/
 void drawLargeAsteroid( const Point & center, int rotation)
 {
-   // ultra simple point
-   struct PT
-   {
-      int x;
-      int y;
-   } points[] = 
-   {
-      {0, 12},    {8, 20}, {16, 14},
-      {10, 12},   {20, 0}, {0, -20},
-      {-18, -10}, {-20, -2}, {-20, 14},
-      {-10, 20},  {0, 12}
-   };
-   
-   glBegin(GL_LINE_STRIP);
-   for (int i = 0; i < sizeof(points)/sizeof(PT); i++)
-   {
-      Point pt(center.getX() + points[i].x, 
-               center.getY() + points[i].y);
-      rotate(pt, center, rotation);
-      glVertex2f(pt.getX(), pt.getY());
-   }
-   glEnd();
+   static const RotatedShape shape(LARGE_ROCK_OUTLINE, SHAPE_COUNT(LARGE_ROCK_OUTLINE));
+   drawOutline(center, shape, rotation, false /*isLoop*/);
 }
 
 
@@ -659,54 +647,27 @@ void drawLargeAsteroid( const Point & center, int rotation)
  *  INPUT point   The position of the ship                                      
  *        angle   Which direction it is ponted                                  
  *************************************************************************/
-void drawShip(const Point & center, int rotation, bool thrust)
+void drawShip(const Point & center, int rotation, bool thrust, int flame)
 {
-   // ultra simple point
-   struct PT
-   {
-      int x;
-      int y;
-   };
-   
    // draw the ship                                                 
-   const PT pointsShip[] = 
-   { // top   r.wing   r.engine l.engine  l.wing    top
-      {0, 6}, {6, -6}, {2, -3}, {-2, -3}, {-6, -6}, {0, 6}  
-   };
-   
-   glBegin(GL_LINE_STRIP);
-   for (int i = 0; i < sizeof(pointsShip)/sizeof(PT); i++)
-   {
-      Point pt(center.getX() + pointsShip[i].x, 
-               center.getY() + pointsShip[i].y);
-      rotate(pt, center, rotation);
-      glVertex2f(pt.getX(), pt.getY());
-   }
-   glEnd();
+   static const RotatedShape ship(SHIP_OUTLINE, SHAPE_COUNT(SHIP_OUTLINE));
+   drawOutline(center, ship, rotation, false /*isLoop*/);
 
    // draw the flame if necessary
    if (thrust)
    {
-      const PT pointsFlame[3][5] =
+      static const RotatedShape flames[SHIP_FLAME_COUNT] =
       {
-         { {-2, -3}, {-2, -13}, { 0, -6}, { 2, -13}, {2, -3} },
-         { {-2, -3}, {-4,  -9}, {-1, -7}, { 1, -14}, {2, -3} },
-         { {-2, -3}, {-1, -14}, { 1, -7}, { 4,  -9}, {2, -3} }
+         RotatedShape(SHIP_FLAMES[0], SHAPE_COUNT(SHIP_FLAMES[0])),
+         RotatedShape(SHIP_FLAMES[1], SHAPE_COUNT(SHIP_FLAMES[1])),
+         RotatedShape(SHIP_FLAMES[2], SHAPE_COUNT(SHIP_FLAMES[2]))
       };
       
-      glBegin(GL_LINE_STRIP);
-      glColor3f(1.0 /* red % */, 0.0 /* green % */, 0.0 /* blue % */);
-      int iFlame = random(0, 3);
-      for (int i = 0; i < 5; i++)
-      {
-         Point pt(center.getX() + pointsFlame[iFlame][i].x, 
-                  center.getY() + pointsFlame[iFlame][i].y);
-         rotate(pt, center, rotation);
-         glVertex2f(pt.getX(), pt.getY());
-      }
-      glColor3f(1.0, 1.0, 1.0); // reset to white                                  
-      glEnd();
+      batchColor(1.0 /* red % */, 0.0 /* green % */, 0.0 /* blue % */);
+      int iFlame = (flame == RANDOM_FLAME) ?
+         random(0, SHIP_FLAME_COUNT) : flame;
+      assert(iFlame >= 0 && iFlame < SHIP_FLAME_COUNT);
+      drawOutline(center, flames[iFlame], rotation, false /*isLoop*/);
+      batchColor(1.0, 1.0, 1.0); // reset to white
    }
 }
-
-
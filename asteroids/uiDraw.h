@@ -110,9 +110,13 @@ void drawToughBird(const Point & center, float radius, int hits);
 
 /************************************************************************      
  * DRAW Ship                                                                   
- * Draw the spaceship on the screen                                         
+ * Draw the spaceship on the screen. There are SHIP_FLAME_COUNT flames
+ * to flicker between; RANDOM_FLAME picks one with random()
  *************************************************************************/
-void drawShip(const Point & point, int rotation, bool thrust = false);
+#define SHIP_FLAME_COUNT 3
+#define RANDOM_FLAME -1
+void drawShip(const Point & point, int rotation, bool thrust = false,
+              int flame = RANDOM_FLAME);
 
 /**********************************************************************
  * DRAW * ASTEROID
@@ -121,15 +125,12 @@ void drawSmallAsteroid( const Point & point, int rotation);
 void drawMediumAsteroid(const Point & point, int rotation);
 void drawLargeAsteroid( const Point & point, int rotation);
 
-/******************************************************************
- * RANDOM
- * This function generates a random number.  The user specifies
- * The parameters 
- *    INPUT:   min, max : The number of values (min <= num <= max)
- *    OUTPUT   <return> : Return the integer
- ****************************************************************/
-int    random(int    min, int    max);
-double random(double min, double max);
+/**********************************************************************
+ * FLUSH DRAWING
+ * Lines and dots are saved up and sent to OpenGL together. This sends
+ * them; drawCallback() calls it once a frame before showing the frame.
+ **********************************************************************/
+void flushDrawing();
 
 
 #endif // UI_DRAW_H
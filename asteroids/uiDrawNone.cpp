@@ -0,0 +1,127 @@
+/***********************************************************************
+ * Source File:
+ *    User Interface Draw : draw nothing
+ * Author:
+ *    Matthew Burr
+ * Summary:
+ *    A stand-in for uiDraw.cpp for builds with no display. Every
+ *    function in uiDraw.h is here and does nothing, so the game can
+ *    be linked and run without OpenGL, GLUT or an X server. Link this
+ *    instead of uiDraw.cpp, never with it.
+ ************************************************************************/
+
+#ifdef _WIN32
+#define _USE_MATH_DEFINES
+#endif
+
+#include <cmath>
+#include "point.h"
+#include "uiDraw.h"
+
+#define deg2rad(value) ((M_PI / 180) * (value))
+
+/*************************************************************************
+ * TEXT AND NUMBERS
+ *************************************************************************/
+void drawDigit(const Point & topLeft, char digit)
+{
+}
+
+void drawNumber(const Point & topLeft, int number)
+{
+}
+
+void drawText(const Point & topLeft, const char * text)
+{
+}
+
+/*************************************************************************
+ * ROTATE
+ * Not drawing, just geometry, so it does the same as the real one
+ *************************************************************************/
+void rotate(Point & point, const Point & origin, int rotation)
+{
+   double cosA = cos(deg2rad(rotation));
+   double sinA = sin(deg2rad(rotation));
+
+   Point tmp(false /*check*/);
+   tmp.setX(point.getX() - origin.getX());
+   tmp.setY(point.getY() - origin.getY());
+
+   point.setX(static_cast<int> (tmp.getX() * cosA -
+                                tmp.getY() * sinA) +
+              origin.getX());
+   point.setY(static_cast<int> (tmp.getX() * sinA +
+                                tmp.getY() * cosA) +
+              origin.getY());
+}
+
+/*************************************************************************
+ * SHAPES
+ *************************************************************************/
+void drawRect(const Point & center, int width, int height, int rotation)
+{
+}
+
+void drawCircle(const Point & center, int radius)
+{
+}
+
+void drawPolygon(const Point & center, int radius, int points, int rotation)
+{
+}
+
+void drawLine(const Point & begin, const Point & end,
+              float red, float green, float blue)
+{
+}
+
+void drawDot(const Point & point)
+{
+}
+
+/*************************************************************************
+ * GAME OBJECTS
+ *************************************************************************/
+void drawLander(const Point & point)
+{
+}
+
+void drawLanderFlames(const Point & point,
+                      bool bottom,
+                      bool left,
+                      bool right)
+{
+}
+
+void drawSacredBird(const Point & center, float radius)
+{
+}
+
+void drawToughBird(const Point & center, float radius, int hits)
+{
+}
+
+void drawShip(const Point & center, int rotation, bool thrust, int flame)
+{
+}
+
+void drawSmallAsteroid(const Point & center, int rotation)
+{
+}
+
+void drawMediumAsteroid(const Point & center, int rotation)
+{
+}
+
+void drawLargeAsteroid(const Point & center, int rotation)
+{
+}
+
+/*************************************************************************
+ * FLUSH DRAWING
+ * Nothing is saved up, so there is nothing to send
+ *************************************************************************/
+void flushDrawing()
+{
+}
@@ -0,0 +1,819 @@
+/***********************************************************************
+ * Source File:
+ *    User Interface Draw : into memory
+ * Author:
+ *    Matthew Burr
+ * Summary:
+ *    Everything in uiDraw.h, drawn in software into a framebuffer the
+ *    caller owns. The shapes come from the same outlines and rotated
+ *    shape cache as uiDraw.cpp; lines are drawn with Bresenham's
+ *    algorithm, clipped to the framebuffer first, and each row a line
+ *    keeps to is filled as one span. Text uses a small built-in
+ *    bitmap font in place of GLUT's.
+ *
+ *    Nothing is saved up, so flushDrawing() has nothing to do.
+ ************************************************************************/
+
+#ifdef _WIN32
+#define _USE_MATH_DEFINES
+#endif
+
+#include <cassert>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include "point.h"
+#include "uiDraw.h"
+#include "uiDrawRaster.h"
+#include "random.h"
+#include "rotatedShape.h"
+#include "shapeOutlines.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+   (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HAS_SSE2 1
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+#define deg2rad(value) ((M_PI / 180) * (value))
+
+// Gray spans longer than this are filled with memset
+#define GRAY_MEMSET_SPAN 16
+
+/*********************************************
+ * FONT
+ * Printable ASCII, ' ' to '~', 5 pixels wide
+ * and 7 high. Each byte is a column, left to
+ * right, with the top row in the low bit.
+ ********************************************/
+#define FONT_FIRST ' '
+#define FONT_LAST '~'
+#define FONT_WIDTH 5
+#define FONT_HEIGHT 7
+#define FONT_ADVANCE 6
+
+const unsigned char FONT[FONT_LAST - FONT_FIRST + 1][FONT_WIDTH] =
+{
+   {0x00,0x00,0x00,0x00,0x00}, {0x00,0x00,0x5F,0x00,0x00}, //   !
+   {0x00,0x07,0x00,0x07,0x00}, {0x14,0x7F,0x14,0x7F,0x14}, // " #
+   {0x24,0x2A,0x7F,0x2A,0x12}, {0x23,0x13,0x08,0x64,0x62}, // $ %
+   {0x36,0x49,0x55,0x22,0x50}, {0x00,0x05,0x03,0x00,0x00}, // & '
+   {0x00,0x1C,0x22,0x41,0x00}, {0x00,0x41,0x22,0x1C,0x00}, // ( )
+   {0x08,0x2A,0x1C,0x2A,0x08}, {0x08,0x08,0x3E,0x08,0x08}, // * +
+   {0x00,0x50,0x30,0x00,0x00}, {0x08,0x08,0x08,0x08,0x08}, // , -
+   {0x00,0x60,0x60,0x00,0x00}, {0x20,0x10,0x08,0x04,0x02}, // . /
+   {0x3E,0x51,0x49,0x45,0x3E}, {0x00,0x42,0x7F,0x40,0x00}, // 0 1
+   {0x42,0x61,0x51,0x49,0x46}, {0x21,0x41,0x45,0x4B,0x31}, // 2 3
+   {0x18,0x14,0x12,0x7F,0x10}, {0x27,0x45,0x45,0x45,0x39}, // 4 5
+   {0x3C,0x4A,0x49,0x49,0x30}, {0x01,0x71,0x09,0x05,0x03}, // 6 7
+   {0x36,0x49,0x49,0x49,0x36}, {0x06,0x49,0x49,0x29,0x1E}, // 8 9
+   {0x00,0x36,0x36,0x00,0x00}, {0x00,0x56,0x36,0x00,0x00}, // : ;
+   {0x08,0x14,0x22,0x41,0x00}, {0x14,0x14,0x14,0x14,0x14}, // < =
+   {0x00,0x41,0x22,0x14,0x08}, {0x02,0x01,0x51,0x09,0x06}, // > ?
+   {0x32,0x49,0x79,0x41,0x3E}, {0x7E,0x11,0x11,0x11,0x7E}, // @ A
+   {0x7F,0x49,0x49,0x49,0x36}, {0x3E,0x41,0x41,0x41,0x22}, // B C
+   {0x7F,0x41,0x41,0x22,0x1C}, {0x7F,0x49,0x49,0x49,0x41}, // D E
+   {0x7F,0x09,0x09,0x09,0x01}, {0x3E,0x41,0x49,0x49,0x7A}, // F G
+   {0x7F,0x08,0x08,0x08,0x7F}, {0x00,0x41,0x7F,0x41,0x00}, // H I
+   {0x20,0x40,0x41,0x3F,0x01}, {0x7F,0x08,0x14,0x22,0x41}, // J K
+   {0x7F,0x40,0x40,0x40,0x40}, {0x7F,0x02,0x0C,0x02,0x7F}, // L M
+   {0x7F,0x04,0x08,0x10,0x7F}, {0x3E,0x41,0x41,0x41,0x3E}, // N O
+   {0x7F,0x09,0x09,0x09,0x06}, {0x3E,0x41,0x51,0x21,0x5E}, // P Q
+   {0x7F,0x09,0x19,0x29,0x46}, {0x46,0x49,0x49,0x49,0x31}, // R S
+   {0x01,0x01,0x7F,0x01,0x01}, {0x3F,0x40,0x40,0x40,0x3F}, // T U
+   {0x1F,0x20,0x40,0x20,0x1F}, {0x3F,0x40,0x38,0x40,0x3F}, // V W
+   {0x63,0x14,0x08,0x14,0x63}, {0x07,0x08,0x70,0x08,0x07}, // X Y
+   {0x61,0x51,0x49,0x45,0x43}, {0x00,0x7F,0x41,0x41,0x00}, // Z [
+   {0x02,0x04,0x08,0x10,0x20}, {0x00,0x41,0x41,0x7F,0x00}, // \ ]
+   {0x04,0x02,0x01,0x02,0x04}, {0x40,0x40,0x40,0x40,0x40}, // ^ _
+   {0x00,0x01,0x02,0x04,0x00}, {0x20,0x54,0x54,0x54,0x78}, // ` a
+   {0x7F,0x48,0x44,0x44,0x38}, {0x38,0x44,0x44,0x44,0x20}, // b c
+   {0x38,0x44,0x44,0x48,0x7F}, {0x38,0x54,0x54,0x54,0x18}, // d e
+   {0x08,0x7E,0x09,0x01,0x02}, {0x0C,0x52,0x52,0x52,0x3E}, // f g
+   {0x7F,0x08,0x04,0x04,0x78}, {0x00,0x44,0x7D,0x40,0x00}, // h i
+   {0x20,0x40,0x44,0x3D,0x00}, {0x7F,0x10,0x28,0x44,0x00}, // j k
+   {0x00,0x41,0x7F,0x40,0x00}, {0x7C,0x04,0x18,0x04,0x78}, // l m
+   {0x7C,0x08,0x04,0x04,0x78}, {0x38,0x44,0x44,0x44,0x38}, // n o
+   {0x7C,0x14,0x14,0x14,0x08}, {0x08,0x14,0x14,0x18,0x7C}, // p q
+   {0x7C,0x08,0x04,0x04,0x08}, {0x48,0x54,0x54,0x54,0x20}, // r s
+   {0x04,0x3F,0x44,0x40,0x20}, {0x3C,0x40,0x40,0x20,0x7C}, // t u
+   {0x1C,0x20,0x40,0x20,0x1C}, {0x3C,0x40,0x30,0x40,0x3C}, // v w
+   {0x44,0x28,0x10,0x28,0x44}, {0x0C,0x50,0x50,0x50,0x3C}, // x y
+   {0x44,0x64,0x54,0x4C,0x44}, {0x00,0x08,0x36,0x41,0x00}, // z {
+   {0x00,0x00,0x7F,0x00,0x00}, {0x00,0x41,0x36,0x08,0x00}, // | }
+   {0x08,0x04,0x08,0x10,0x08}                              // ~
+};
+
+/*********************************************
+ * TARGET
+ * Where we draw, how the game maps onto it and
+ * the color we draw with, as the bytes of one
+ * pixel
+ ********************************************/
+static Framebuffer target = { NULL, 0, 0, 0, PIXEL_GRAY };
+static float viewLeft = 0.0;
+static float viewTop = 0.0;
+static float scaleX = 1.0;
+static float scaleY = 1.0;
+static unsigned char pen[4];
+
+/************************************************************************
+ * SET PEN
+ * The color to draw with
+ *************************************************************************/
+static void setPen(float red, float green, float blue)
+{
+   if (target.format == PIXEL_GRAY)
+      pen[0] = (unsigned char)(255 * (0.299 * red + 0.587 * green +
+                                      0.114 * blue) + 0.5);
+   else
+   {
+      pen[0] = (unsigned char)(255 * red   + 0.5);
+      pen[1] = (unsigned char)(255 * green + 0.5);
+      pen[2] = (unsigned char)(255 * blue  + 0.5);
+      pen[3] = 255;
+   }
+}
+
+/************************************************************************
+ * SET FRAMEBUFFER
+ * Draw into a framebuffer from now on
+ *************************************************************************/
+void setFramebuffer(const Framebuffer & framebuffer,
+                    const Point & topLeft,
+                    const Point & bottomRight)
+{
+   assert(framebuffer.pixels != NULL);
+   assert(framebuffer.width > 0 && framebuffer.height > 0);
+   assert(framebuffer.stride >=
+          framebuffer.width * (framebuffer.format == PIXEL_RGBA ? 4 : 1));
+
+   target = framebuffer;
+   viewLeft = topLeft.getX();
+   viewTop  = topLeft.getY();
+   scaleX = target.width  / (bottomRight.getX() - topLeft.getX());
+   scaleY = target.height / (topLeft.getY() - bottomRight.getY());
+   setPen(1.0, 1.0, 1.0);
+}
+
+/************************************************************************
+ * FILL SPAN
+ * Paint pixels first through last of a row; all of them must be in the
+ * framebuffer. Gray rows are a memset; color rows are filled four
+ * pixels at a time.
+ *************************************************************************/
+static void fillSpan(int row, int first, int last)
+{
+   unsigned char *pixel = target.pixels + (size_t)row * target.stride;
+   int count = last - first + 1;
+
+   if (target.format == PIXEL_GRAY)
+   {
+      // most spans are a few pixels, too short to be worth a call
+      if (count > GRAY_MEMSET_SPAN)
+         memset(pixel + first, pen[0], count);
+      else
+         for (pixel += first; count > 0; count--)
+            *pixel++ = pen[0];
+      return;
+   }
+
+   pixel += first * 4;
+#ifdef HAS_SSE2
+   int color;
+   memcpy(&color, pen, 4);
+   __m128i four = _mm_set1_epi32(color);
+   for (; count >= 4; count -= 4, pixel += 16)
+      _mm_storeu_si128((__m128i *)pixel, four);
+#endif
+   for (; count > 0; count--, pixel += 4)
+      memcpy(pixel, pen, 4);
+}
+
+/************************************************************************
+ * PUT PIXEL
+ * Paint one pixel, which must be in the framebuffer
+ *************************************************************************/
+inline void putPixel(int x, int y)
+{
+   unsigned char *pixel = target.pixels + (size_t)y * target.stride;
+   if (target.format == PIXEL_GRAY)
+      pixel[x] = pen[0];
+   else
+      memcpy(pixel + x * 4, pen, 4);
+}
+
+/************************************************************************
+ * PLOT
+ * Paint one pixel, if it is in the framebuffer
+ *************************************************************************/
+static void plot(int x, int y)
+{
+   if (x >= 0 && x < target.width && y >= 0 && y < target.height)
+      putPixel(x, y);
+}
+
+/************************************************************************
+ * CLEAR FRAMEBUFFER
+ * Paint the whole framebuffer black
+ *************************************************************************/
+void clearFramebuffer()
+{
+   assert(target.pixels != NULL);
+
+   unsigned char saved[4];
+   memcpy(saved, pen, 4);
+   setPen(0.0, 0.0, 0.0);
+
+   for (int row = 0; row < target.height; row++)
+      fillSpan(row, 0, target.width - 1);
+
+   memcpy(pen, saved, 4);
+}
+
+/************************************************************************
+ * TO PIXEL
+ * Where a point in the game is in the framebuffer; the pixel it lands
+ * in is the whole part
+ *************************************************************************/
+inline float toPixelX(float x) { return (x - viewLeft) * scaleX; }
+inline float toPixelY(float y) { return (viewTop - y) * scaleY; }
+
+/************************************************************************
+ * CLIP
+ * Trims a line, in pixels, to the part inside the framebuffer, by
+ * Liang and Barsky's method. Returns false if none of it is.
+ *************************************************************************/
+static bool clip(float & x0, float & y0, float & x1, float & y1)
+{
+   float dx = x1 - x0;
+   float dy = y1 - y0;
+   float p[4] = { -dx, dx, -dy, dy };
+   float q[4] = { x0, target.width - x0, y0, target.height - y0 };
+   float enter = 0.0;
+   float leave = 1.0;
+
+   for (int i = 0; i < 4; i++)
+   {
+      if (p[i] == 0.0)
+      {
+         if (q[i] < 0.0)
+            return false;
+      }
+      else
+      {
+         float t = q[i] / p[i];
+         if (p[i] < 0.0 && t > enter)
+            enter = t;
+         else if (p[i] > 0.0 && t < leave)
+            leave = t;
+         if (enter > leave)
+            return false;
+      }
+   }
+
+   x1 = x0 + leave * dx;
+   y1 = y0 + leave * dy;
+   x0 = x0 + enter * dx;
+   y0 = y0 + enter * dy;
+   return true;
+}
+
+/************************************************************************
+ * TO COLUMN, TO ROW
+ * The pixel a clipped end lands in. Clipping can leave an end right on
+ * the far edge, or a rounding error past either edge; those belong to
+ * the pixel at the edge.
+ *************************************************************************/
+inline int toColumn(float x)
+{
+   int column = (int)x;
+   return column < 0 ? 0 : (column < target.width ? column : target.width - 1);
+}
+
+inline int toRow(float y)
+{
+   int row = (int)y;
+   return row < 0 ? 0 : (row < target.height ? row : target.height - 1);
+}
+
+/************************************************************************
+ * DRAW SEGMENT
+ * Draw a line between two points in the game
+ *************************************************************************/
+static void drawSegment(float beginX, float beginY, float endX, float endY)
+{
+   float fx0 = toPixelX(beginX);
+   float fy0 = toPixelY(beginY);
+   float fx1 = toPixelX(endX);
+   float fy1 = toPixelY(endY);
+   if (!clip(fx0, fy0, fx1, fy1))
+      return;
+
+   int x0 = toColumn(fx0);
+   int y0 = toRow(fy0);
+   int x1 = toColumn(fx1);
+   int y1 = toRow(fy1);
+   int dx = abs(x1 - x0);
+   int dy = abs(y1 - y0);
+
+   if (dx >= dy)
+   {
+      // mostly across: fill each row the line stays on in one go
+      if (x0 > x1)
+      {
+         swap(x0, x1);
+         swap(y0, y1);
+      }
+
+      int step = (y1 > y0) ? 1 : -1;
+      int error = dx / 2;
+      int first = x0;
+      for (int x = x0; x < x1; x++)
+      {
+         error -= dy;
+         if (error < 0)
+         {
+            fillSpan(y0, first, x);
+            y0 += step;
+            error += dx;
+            first = x + 1;
+         }
+      }
+      fillSpan(y0, first, x1);
+   }
+   else
+   {
+      // mostly up and down: a pixel a row
+      if (y0 > y1)
+      {
+         swap(x0, x1);
+         swap(y0, y1);
+      }
+
+      int step = (x1 > x0) ? 1 : -1;
+      int error = dy / 2;
+      for (int y = y0; y <= y1; y++)
+      {
+         putPixel(x0, y);
+         error -= dx;
+         if (error < 0)
+         {
+            x0 += step;
+            error += dy;
+         }
+      }
+   }
+}
+
+/************************************************************************
+ * DRAW OUTLINE
+ * Draw the lines from each point to the next, and for a loop from the
+ * last back to the first
+ *************************************************************************/
+static void drawOutline(const float * xs, const float * ys, int count,
+                        bool isLoop)
+{
+   for (int i = 1; i < count; i++)
+      drawSegment(xs[i - 1], ys[i - 1], xs[i], ys[i]);
+
+   if (isLoop && count > 1)
+      drawSegment(xs[count - 1], ys[count - 1], xs[0], ys[0]);
+}
+
+/************************************************************************
+ * DRAW ROTATED
+ * Draw a shape from the rotated shape cache
+ *************************************************************************/
+static void drawRotated(const Point & center, const RotatedShape & shape,
+                        int rotation, bool isLoop)
+{
+   const ShapePoint *outline = shape.getOutline(rotation);
+   for (int i = 1; i < shape.getCount(); i++)
+      drawSegment(center.getX() + outline[i - 1].x,
+                  center.getY() + outline[i - 1].y,
+                  center.getX() + outline[i].x,
+                  center.getY() + outline[i].y);
+
+   int last = shape.getCount() - 1;
+   if (isLoop && last > 0)
+      drawSegment(center.getX() + outline[last].x,
+                  center.getY() + outline[last].y,
+                  center.getX() + outline[0].x,
+                  center.getY() + outline[0].y);
+}
+
+/************************************************************************
+ * DRAW CHARACTER
+ * Draw one character of the font with the bottom of it at a pixel
+ *************************************************************************/
+static void drawCharacter(int left, int bottom, char character)
+{
+   if (character < FONT_FIRST || character > FONT_LAST)
+      character = '?';
+
+   const unsigned char *glyph = FONT[character - FONT_FIRST];
+   for (int column = 0; column < FONT_WIDTH; column++)
+      for (int row = 0; row < FONT_HEIGHT; row++)
+         if (glyph[column] & (1 << row))
+            plot(left + column, bottom - FONT_HEIGHT + 1 + row);
+}
+
+/************************************************************************
+ * FILL TRIANGLE
+ * Paint the pixels whose centers are inside a triangle, a span a row
+ *************************************************************************/
+static void fillTriangle(const Point & a, const Point & b, const Point & c)
+{
+   float xs[3] = { toPixelX(a.getX()), toPixelX(b.getX()), toPixelX(c.getX()) };
+   float ys[3] = { toPixelY(a.getY()), toPixelY(b.getY()), toPixelY(c.getY()) };
+
+   float top = min(ys[0], min(ys[1], ys[2]));
+   float bottom = max(ys[0], max(ys[1], ys[2]));
+   int firstRow = max(0, (int)ceil(top - 0.5));
+   int lastRow = min(target.height - 1, (int)ceil(bottom - 0.5) - 1);
+
+   for (int row = firstRow; row <= lastRow; row++)
+   {
+      // where the row's center crosses the edges
+      float y = row + 0.5f;
+      float left = (float)target.width;
+      float right = -1.0;
+      for (int i = 0; i < 3; i++)
+      {
+         int j = (i + 1) % 3;
+         if ((ys[i] <= y && y < ys[j]) || (ys[j] <= y && y < ys[i]))
+         {
+            float x = xs[i] + (y - ys[i]) * (xs[j] - xs[i]) / (ys[j] - ys[i]);
+            left = min(left, x);
+            right = max(right, x);
+         }
+      }
+
+      int first = max(0, (int)ceil(left - 0.5));
+      int last = min(target.width - 1, (int)ceil(right - 0.5) - 1);
+      if (first <= last)
+         fillSpan(row, first, last);
+   }
+}
+
+/*************************************************************************
+ * DRAW DIGIT
+ * Draw a single digit in the old school line drawing style
+ *************************************************************************/
+void drawDigit(const Point & topLeft, char digit)
+{
+   assert(isdigit(digit));
+   if (!isdigit(digit))
+      return;
+
+   int r = digit - '0';
+   for (int c = 0; c < 20 && NUMBER_OUTLINES[r][c] != -1; c += 4)
+      drawSegment(topLeft.getX() + NUMBER_OUTLINES[r][c],
+                  topLeft.getY() - NUMBER_OUTLINES[r][c + 1],
+                  topLeft.getX() + NUMBER_OUTLINES[r][c + 2],
+                  topLeft.getY() - NUMBER_OUTLINES[r][c + 3]);
+}
+
+/*************************************************************************
+ * DRAW NUMBER
+ * Display an integer on the screen using the 7-segment method
+ *************************************************************************/
+void drawNumber(const Point & topLeft, int number)
+{
+   Point point = topLeft;
+
+   bool isNegative = (number < 0);
+   number *= (isNegative ? -1 : 1);
+
+   ostringstream sout;
+   sout << number;
+   string text = sout.str();
+
+   if (isNegative)
+   {
+      drawSegment(point.getX() + 1, point.getY() - 5,
+                  point.getX() + 5, point.getY() - 5);
+      point.addX(11);
+   }
+
+   for (const char *p = text.c_str(); *p; p++)
+   {
+      drawDigit(point, *p);
+      point.addX(11);
+   }
+}
+
+/*************************************************************************
+ * DRAW TEXT
+ * Draw text with the built-in font, sitting on the point given, as
+ * GLUT's bitmap fonts do
+ *************************************************************************/
+void drawText(const Point & topLeft, const char * text)
+{
+   int left = (int)floor(toPixelX(topLeft.getX()));
+   int bottom = (int)floor(toPixelY(topLeft.getY())) - 1;
+
+   for (const char *p = text; *p; p++, left += FONT_ADVANCE)
+      drawCharacter(left, bottom, *p);
+}
+
+/*************************************************************************
+ * ROTATE
+ * Not drawing, just geometry, so it does the same as the real one
+ *************************************************************************/
+void rotate(Point & point, const Point & origin, int rotation)
+{
+   double cosA = cos(deg2rad(rotation));
+   double sinA = sin(deg2rad(rotation));
+
+   Point tmp(false /*check*/);
+   tmp.setX(point.getX() - origin.getX());
+   tmp.setY(point.getY() - origin.getY());
+
+   point.setX(static_cast<int> (tmp.getX() * cosA -
+                                tmp.getY() * sinA) +
+              origin.getX());
+   point.setY(static_cast<int> (tmp.getX() * sinA +
+                                tmp.getY() * cosA) +
+              origin.getY());
+}
+
+/*************************************************************************
+ * DRAW RECTANGLE
+ *************************************************************************/
+void drawRect(const Point & center, int width, int height, int rotation)
+{
+   Point corners[4];
+   corners[0] = Point(center.getX() - (width / 2), center.getY() + (height / 2));
+   corners[1] = Point(center.getX() + (width / 2), center.getY() + (height / 2));
+   corners[2] = Point(center.getX() + (width / 2), center.getY() - (height / 2));
+   corners[3] = Point(center.getX() - (width / 2), center.getY() - (height / 2));
+
+   float xs[4];
+   float ys[4];
+   for (int i = 0; i < 4; i++)
+   {
+      rotate(corners[i], center, rotation);
+      xs[i] = corners[i].getX();
+      ys[i] = corners[i].getY();
+   }
+
+   drawOutline(xs, ys, 4, true /*isLoop*/);
+}
+
+/*************************************************************************
+ * DRAW CIRCLE
+ *************************************************************************/
+void drawCircle(const Point & center, int radius)
+{
+   assert(radius > 1.0);
+   const double increment = 1.0 / (double)radius;
+
+   float firstX = 0.0;
+   float firstY = 0.0;
+   float lastX = 0.0;
+   float lastY = 0.0;
+   bool isFirst = true;
+   for (double radians = 0; radians < M_PI * 2.0; radians += increment)
+   {
+      float x = center.getX() + (radius * cos(radians));
+      float y = center.getY() + (radius * sin(radians));
+      if (isFirst)
+      {
+         firstX = x;
+         firstY = y;
+         isFirst = false;
+      }
+      else
+         drawSegment(lastX, lastY, x, y);
+      lastX = x;
+      lastY = y;
+   }
+
+   if (!isFirst)
+      drawSegment(lastX, lastY, firstX, firstY);
+}
+
+/*************************************************************************
+ * DRAW POLYGON
+ *************************************************************************/
+void drawPolygon(const Point & center, int radius, int points, int rotation)
+{
+   drawRotated(center, RotatedShape::getPolygon(radius, points), rotation,
+               true /*isLoop*/);
+}
+
+/*************************************************************************
+ * DRAW LINE
+ *************************************************************************/
+void drawLine(const Point & begin, const Point & end,
+              float red, float green, float blue)
+{
+   setPen(red, green, blue);
+   drawSegment(begin.getX(), begin.getY(), end.getX(), end.getY());
+   setPen(1.0, 1.0, 1.0);
+}
+
+/*************************************************************************
+ * DRAW LANDER
+ *************************************************************************/
+void drawLander(const Point & point)
+{
+   for (int i = 1; i < SHAPE_COUNT(LANDER_OUTLINE); i++)
+      drawSegment(point.getX() + LANDER_OUTLINE[i - 1].x,
+                  point.getY() + LANDER_OUTLINE[i - 1].y,
+                  point.getX() + LANDER_OUTLINE[i].x,
+                  point.getY() + LANDER_OUTLINE[i].y);
+}
+
+/*************************************************************************
+ * DRAW LANDER FLAMES
+ * The thrusters that are on make one loop, as in uiDraw.cpp
+ *************************************************************************/
+void drawLanderFlames(const Point & point,
+                      bool bottom,
+                      bool left,
+                      bool right)
+{
+   int iFlame = random(0, 3);  // so the flame flickers
+
+   const ShapePoint *nozzles[3];
+   const ShapePoint *flames[3];
+   int thrusters = 0;
+   if (bottom)
+   {
+      nozzles[thrusters] = LANDER_NOZZLE_BOTTOM;
+      flames[thrusters++] = LANDER_FLAMES_BOTTOM[iFlame];
+   }
+   if (right)
+   {
+      nozzles[thrusters] = LANDER_NOZZLE_RIGHT;
+      flames[thrusters++] = LANDER_FLAMES_RIGHT[iFlame];
+   }
+   if (left)
+   {
+      nozzles[thrusters] = LANDER_NOZZLE_LEFT;
+      flames[thrusters++] = LANDER_FLAMES_LEFT[iFlame];
+   }
+
+   // nozzle, three points of flame, nozzle, for each thruster
+   float xs[15];
+   float ys[15];
+   int count = 0;
+   for (int i = 0; i < thrusters; i++)
+   {
+      xs[count] = point.getX() + nozzles[i][0].x;
+      ys[count++] = point.getY() + nozzles[i][0].y;
+      for (int j = 0; j < 3; j++)
+      {
+         xs[count] = point.getX() + flames[i][j].x;
+         ys[count++] = point.getY() + flames[i][j].y;
+      }
+      xs[count] = point.getX() + nozzles[i][1].x;
+      ys[count++] = point.getY() + nozzles[i][1].y;
+   }
+
+   setPen(1.0, 0.0, 0.0);
+   drawOutline(xs, ys, count, true /*isLoop*/);
+   setPen(1.0, 1.0, 1.0);
+}
+
+/*************************************************************************
+ * DRAW DOT
+ * 2 pixels by 2 pixels, one at each corner of the dot
+ *************************************************************************/
+void drawDot(const Point & point)
+{
+   int x = (int)floor(toPixelX(point.getX()));
+   int y = (int)floor(toPixelY(point.getY()));
+   int right = (int)floor(toPixelX(point.getX() + 1));
+   int above = (int)floor(toPixelY(point.getY() + 1));
+
+   plot(x, y);
+   plot(right, y);
+   plot(right, above);
+   plot(x, above);
+}
+
+/*************************************************************************
+ * DRAW SACRED BIRD
+ *************************************************************************/
+void drawSacredBird(const Point & center, float radius)
+{
+   static float rotation = 0.0;
+   rotation += 5.0;
+
+   float xs[5];
+   float ys[5];
+   for (int i = 0; i < 5; i++)
+   {
+      Point temp(false /*check*/);
+      float radian = (float)i * (M_PI * 2.0) * 0.4;
+      temp.setX(center.getX() + (radius * cos(radian)));
+      temp.setY(center.getY() + (radius * sin(radian)));
+      rotate(temp, center, rotation);
+      xs[i] = temp.getX();
+      ys[i] = temp.getY();
+   }
+
+   setPen(1.0, 0.0, 0.0);
+   drawOutline(xs, ys, 5, true /*isLoop*/);
+   setPen(1.0, 1.0, 1.0);
+}
+
+/*************************************************************************
+ * DRAW TOUGH BIRD
+ * A filled circle with the hits left written on it in black
+ *************************************************************************/
+void drawToughBird(const Point & center, float radius, int hits)
+{
+   assert(radius > 1.0);
+   const double increment = M_PI / 6.0;
+
+   Point pt1(center.getX() + (radius * cos(0.0)),
+             center.getY() + (radius * sin(0.0)));
+   Point pt2(pt1);
+
+   for (double radians = increment;
+        radians <= M_PI * 2.0 + .5;
+        radians += increment)
+   {
+      pt2.setX(center.getX() + (radius * cos(radians)));
+      pt2.setY(center.getY() + (radius * sin(radians)));
+      fillTriangle(center, pt1, pt2);
+      pt1 = pt2;
+   }
+
+   if (hits > 0 && hits < 10)
+   {
+      setPen(0.0, 0.0, 0.0);
+      drawCharacter((int)floor(toPixelX(center.getX() - 4)),
+                    (int)floor(toPixelY(center.getY() - 3)) - 1,
+                    (char)(hits + '0'));
+      setPen(1.0, 1.0, 1.0);
+   }
+}
+
+/*************************************************************************
+ * DRAW SHIP
+ *************************************************************************/
+void drawShip(const Point & center, int rotation, bool thrust, int flame)
+{
+   static const RotatedShape ship(SHIP_OUTLINE, SHAPE_COUNT(SHIP_OUTLINE));
+   drawRotated(center, ship, rotation, false /*isLoop*/);
+
+   if (thrust)
+   {
+      static const RotatedShape flames[SHIP_FLAME_COUNT] =
+      {
+         RotatedShape(SHIP_FLAMES[0], SHAPE_COUNT(SHIP_FLAMES[0])),
+         RotatedShape(SHIP_FLAMES[1], SHAPE_COUNT(SHIP_FLAMES[1])),
+         RotatedShape(SHIP_FLAMES[2], SHAPE_COUNT(SHIP_FLAMES[2]))
+      };
+
+      setPen(1.0, 0.0, 0.0);
+      int iFlame = (flame == RANDOM_FLAME) ?
+         random(0, SHIP_FLAME_COUNT) : flame;
+      assert(iFlame >= 0 && iFlame < SHIP_FLAME_COUNT);
+      drawRotated(center, flames[iFlame], rotation, false /*isLoop*/);
+      setPen(1.0, 1.0, 1.0);
+   }
+}
+
+/*************************************************************************
+ * DRAW ASTEROIDS
+ *************************************************************************/
+void drawSmallAsteroid(const Point & center, int rotation)
+{
+   static const RotatedShape shape(SMALL_ROCK_OUTLINE,
+                                   SHAPE_COUNT(SMALL_ROCK_OUTLINE));
+   drawRotated(center, shape, rotation, false /*isLoop*/);
+}
+
+void drawMediumAsteroid(const Point & center, int rotation)
+{
+   static const RotatedShape shape(MEDIUM_ROCK_OUTLINE,
+                                   SHAPE_COUNT(MEDIUM_ROCK_OUTLINE));
+   drawRotated(center, shape, rotation, false /*isLoop*/);
+}
+
+void drawLargeAsteroid(const Point & center, int rotation)
+{
+   static const RotatedShape shape(LARGE_ROCK_OUTLINE,
+                                   SHAPE_COUNT(LARGE_ROCK_OUTLINE));
+   drawRotated(center, shape, rotation, false /*isLoop*/);
+}
+
+/*************************************************************************
+ * FLUSH DRAWING
+ * Everything is drawn straight away, so there is nothing to send
+ *************************************************************************/
+void flushDrawing()
+{
+}
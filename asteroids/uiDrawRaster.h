@@ -0,0 +1,58 @@
+/***********************************************************************
+ * Header File:
+ *    User Interface Draw : into memory
+ * Author:
+ *    Matthew Burr
+ * Summary:
+ *    uiDrawRaster.cpp draws everything in uiDraw.h into a framebuffer
+ *    in memory, with no OpenGL, GLUT or window. Link it instead of
+ *    uiDraw.cpp (never with it) and say where to draw with
+ *    setFramebuffer(); then each frame clear it, draw the game and
+ *    read the pixels.
+ ************************************************************************/
+
+#ifndef UI_DRAW_RASTER_H
+#define UI_DRAW_RASTER_H
+
+#include "point.h"
+
+/************************************************************************
+ * PIXEL FORMAT
+ * A byte of brightness per pixel, or red, green, blue and alpha bytes
+ *************************************************************************/
+enum PixelFormat
+{
+   PIXEL_GRAY,
+   PIXEL_RGBA
+};
+
+/************************************************************************
+ * FRAMEBUFFER
+ * Memory to draw into. It belongs to the caller, and has to be there
+ * for as long as it is being drawn into.
+ *************************************************************************/
+struct Framebuffer
+{
+   unsigned char * pixels;    // the top row first
+   int width;
+   int height;
+   int stride;                // bytes from the start of one row to the next
+   PixelFormat format;
+};
+
+/************************************************************************
+ * SET FRAMEBUFFER
+ * Draw into a framebuffer from now on. The part of the game between
+ * topLeft and bottomRight is stretched to fill it, as the window is.
+ *************************************************************************/
+void setFramebuffer(const Framebuffer & framebuffer,
+                    const Point & topLeft,
+                    const Point & bottomRight);
+
+/************************************************************************
+ * CLEAR FRAMEBUFFER
+ * Paint the whole framebuffer black
+ *************************************************************************/
+void clearFramebuffer();
+
+#endif // UI_DRAW_RASTER_H
@@ -13,8 +13,6 @@
 #include <string>     // need you ask?
 #include <sstream>    // convert an integer into text
 #include <cassert>    // I feel the need... the need for asserts
-#include <time.h>     // for clock
-#include <cstdlib>    // for rand()
 
 
 #ifdef __APPLE__
@@ -40,37 +38,19 @@
 
 #include "uiInteract.h"
 #include "point.h"
+#include "framePacer.h"
+#include "uiDraw.h"
 
-using namespace std;
-
-
-/*********************************************************************
- * SLEEP
- * Pause for a while.  We want to put the program to sleep until it
- * is time to draw again.  Note that this requires us to tell the OS
- * that we are idle.  the nanosleep function performs this task for us
- *   INPUT: msSleep: sleep time in milliseconds
- *********************************************************************/
-void sleep(unsigned long msSleep)
-{
-   // Windows handles sleep one way
-#ifdef _WIN32
-   ::Sleep(msSleep + 35);
+// GLUT's timers are only good to a millisecond or two, so we ask to be
+// woken this much early and let the pacer wait out the rest
+#define TIMER_MARGIN_MS 2
 
-   // Unix-based operating systems (OS-X, Linux) do it another
-#else // LINUX, XCODE
-   timespec req = {};
-   time_t sec = (int)(msSleep / 1000);
-   msSleep -= (sec * 1000);
+using namespace std;
 
-   req.tv_sec = sec;
-   req.tv_nsec = msSleep * 1000000L;
+// Redraws GLUT asks for itself (the window was uncovered, say) mustn't
+// start a second chain of timers
+static bool isTimerPending = false;
 
-   while (nanosleep(&req, &req) == -1)
-      ;
-#endif // LINUX, XCODE
-   return;
-}
 
 /************************************************************************
  * DRAW CALLBACK
@@ -93,19 +73,38 @@ void drawCallback()
    //calls the client's display function
    assert(ui.callBack != NULL);
    ui.callBack(&ui, ui.p);
-   
-   //loop until the timer runs out
-   if (!ui.isTimeToDraw())
-      sleep((unsigned long)((ui.getNextTick() - clock()) / 1000));
 
-   // from this point, set the next draw time
-   ui.setNextDrawTime();
+   // send what it drew to OpenGL in a few big batches
+   flushDrawing();
+   
+   // wait until the frame is due
+   ui.waitForNextFrame();
 
    // bring forth the background buffer
    glutSwapBuffers();
 
    // clear the space at the end
    ui.keyEvent();
+
+   // and sleep in the main loop until the next one is nearly due
+   if (!isTimerPending)
+   {
+      int milliseconds = (int)(ui.getTimeToNextFrame() * 1000) -
+         TIMER_MARGIN_MS;
+      glutTimerFunc(milliseconds > 0 ? milliseconds : 0, timerCallback, 0);
+      isTimerPending = true;
+   }
+}
+
+/************************************************************************
+ * TIMER CALLBACK
+ * The next frame is nearly due, so ask GLUT to draw it
+ *   INPUT   value:  ignored
+ *************************************************************************/
+void timerCallback(int value)
+{
+   isTimerPending = false;
+   glutPostRedisplay();
 }
 
 /************************************************************************
@@ -198,26 +197,6 @@ void Interface::keyEvent()
 }
 
 
-/************************************************************************
- * INTEFACE : IS TIME TO DRAW
- * Have we waited long enough to draw swap the background buffer with
- * the foreground buffer?
- *************************************************************************/
-bool Interface::isTimeToDraw()
-{
-   return ((unsigned int)clock() >= nextTick);
-}
-
-/************************************************************************
- * INTERFACE : SET NEXT DRAW TIME
- * What time should we draw the buffer again?  This is a function of
- * the current time and the frames per second.
- *************************************************************************/
-void Interface::setNextDrawTime()
-{
-   nextTick = clock() + static_cast<int> (timePeriod * CLOCKS_PER_SEC);
-}
-
 /************************************************************************
  * INTERFACE : SET FRAMES PER SECOND
  * The frames per second dictates the speed of the game.  The more frames
@@ -228,6 +207,7 @@ void Interface::setNextDrawTime()
 void Interface::setFramesPerSecond(double value)
 {
     timePeriod = (1 / value);
+    pacer.setFramesPerSecond(value);
 }
 
 /***************************************************
@@ -242,7 +222,7 @@ int          Interface::isRightPress = 0;
 bool         Interface::isSpacePress = false;
 bool         Interface::initialized  = false;
 double       Interface::timePeriod   = 1.0 / 30; // default to 30 frames/second
-unsigned int Interface::nextTick     = 0;        // redraw now please
+FramePacer   Interface::pacer;                   // draws the first frame now
 void *       Interface::p            = NULL;
 void (*Interface::callBack)(const Interface *, void *) = NULL;
 
@@ -270,9 +250,6 @@ void Interface::initialize(int argc, char ** argv, const char * title, Point top
    if (initialized)
       return;
    
-   // set up the random number generator
-   srand((long)(argv));
-
    // create the window
    glutInit(&argc, argv);
    Point point;
@@ -292,7 +269,6 @@ void Interface::initialize(int argc, char ** argv, const char * title, Point top
 
    // register the callbacks so OpenGL knows how to call us
    glutDisplayFunc(   drawCallback    );
-   glutIdleFunc(      drawCallback    );
    glutKeyboardFunc(  keyboardCallback);
    glutSpecialFunc(   keyDownCallback );
    glutSpecialUpFunc( keyUpCallback   );
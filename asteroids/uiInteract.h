@@ -18,6 +18,7 @@
 #define UI_INTERFACE_H
 
  #include "point.h"
+ #include "framePacer.h"
 
 /********************************************
  * INTERFACE
@@ -45,13 +46,16 @@ public:
    void run(void (*callBack)(const Interface *, void *), void *p);
 
    // Is it time to redraw the screen
-   bool isTimeToDraw();
+   bool isTimeToDraw() { return pacer.isTimeToDraw(); };
 
-   // Set the next draw time based on current time and time period
-   void setNextDrawTime();
+   // Wait until the next frame is due by the wall clock
+   void waitForNextFrame() { pacer.waitForNextFrame(); };
 
-   // Retrieve the next tick time... the time of the next draw.
-   unsigned int getNextTick() { return nextTick; };
+   // Seconds until the next frame is due
+   double getTimeToNextFrame() { return pacer.getTimeToNextFrame(); };
+
+   // How steady the frame rate has been
+   FrameStats getFrameStats() const { return pacer.getStats(); };
 
    // How many frames per second are we configured for?
    void setFramesPerSecond(double value);
@@ -79,7 +83,7 @@ private:
 
    static bool         initialized;  // only run the constructor once!
    static double       timePeriod;   // interval between frame draws
-   static unsigned int nextTick;     // time (from clock()) of our next draw
+   static FramePacer   pacer;        // when the next draw is due
 
    static int  isDownPress;          // is the down arrow currently pressed?
    static int  isUpPress;            //    "   up         "
@@ -102,6 +106,13 @@ private:
  *************************************************************************/
 void drawCallback();
 
+/************************************************************************
+ * TIMER CALLBACK
+ * GLUT calls this shortly before the next frame is due, so between
+ * frames the program sleeps in GLUT's main loop instead of spinning
+ *************************************************************************/
+void timerCallback(int value);
+
 /************************************************************************
  * KEY DOWN CALLBACK
  * When a key on the keyboard has been pressed, we need to pass that